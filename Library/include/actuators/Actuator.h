@@ -32,6 +32,8 @@
 namespace sf
 {
     struct Renderable;
+    class StateBuffer;
+    class CloneContext;
     
     //! An enum designating a type of the actuator.
     enum class ActuatorType {MOTOR, SERVO, PROPELLER, THRUSTER, VBS, LIGHT};
@@ -69,6 +71,25 @@ namespace sf
 
         //! A method returning the name of the actuator.
         std::string getName();
+        
+        //! A method saving the internal state of the actuator.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(StateBuffer& state);
+        
+        //! A method restoring the internal state of the actuator.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(StateBuffer& state);
+        
+        //! A method creating a copy of the actuator, attached to the copies of the actuated objects.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy or NULL if the actuator cannot be cloned
+         */
+        virtual Actuator* Clone(CloneContext& ctx);
     
     protected:
         DisplayMode dm;
@@ -95,6 +95,25 @@ namespace sf
         //! A method returning the ratio of the motor gearbox.
         Scalar getGearRatio();
         
+        //! A method saving the internal state of the actuator.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void SaveState(StateBuffer& state);
+        
+        //! A method restoring the internal state of the actuator.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void RestoreState(StateBuffer& state);
+        
+        //! A method creating a copy of the actuator, attached to the copies of the actuated objects.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        Actuator* Clone(CloneContext& ctx);
+        
     private:
         Scalar V;
         Scalar I;
@@ -95,6 +95,16 @@ namespace sf
         //! A method returning the type of the actuator.
         ActuatorType getType();
         
+        //! A method creating a copy of the actuator, attached to the copies of the actuated objects.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        Actuator* Clone(CloneContext& ctx);
+        
+    protected:
+        void InitCopy(CloneContext& ctx);
+        
     private:
         void InitGraphics();
         
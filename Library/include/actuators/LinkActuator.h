@@ -57,6 +57,8 @@ namespace sf
         virtual Transform getActuatorFrame();
        
     protected:
+        virtual void InitCopy(CloneContext& ctx);
+        
         SolidEntity* attach;
         Transform o2a;
     };
@@ -83,6 +83,28 @@ namespace sf
         //! A method returning the type of the actuator.
         ActuatorType getType();
         
+        //! A method creating a copy of the actuator, attached to the copies of the actuated objects.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        Actuator* Clone(CloneContext& ctx);
+        
+        //! A method saving the internal state of the actuator.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void SaveState(StateBuffer& state);
+        
+        //! A method restoring the internal state of the actuator.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void RestoreState(StateBuffer& state);
+        
+    protected:
+        void InitCopy(CloneContext& ctx);
+        
     private:
         //Params
         Scalar D;
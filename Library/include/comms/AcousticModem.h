@@ -27,10 +27,13 @@
 #define __Stonefish_AcousticModem__
 
 #include <map>
+#include <SDL2/SDL_mutex.h>
 #include "comms/Comm.h"
 
 namespace sf
 {
+    class SimulationManager;
+    
     struct AcousticDataFrame : public CommDataFrame
     {
         Vector3 txPosition;
@@ -87,10 +90,34 @@ namespace sf
         //! A method returning the type of the comm.
         virtual CommType getType();
         
+        //! A method creating a copy of the comm device, attached to the copy of the body.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        virtual Comm* Clone(CloneContext& ctx);
+        
+        //! A method saving the internal state of the modem, including the propagating messages.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(StateBuffer& state);
+        
+        //! A method restoring the internal state of the modem.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(StateBuffer& state);
+        
     protected:
+        virtual void InitCopy(CloneContext& ctx);
         virtual void ProcessMessages();
+        virtual void SaveFrame(StateBuffer& state, const CommDataFrame* msg);
+        virtual CommDataFrame* RestoreFrame(StateBuffer& state, CommDataFrame* data = nullptr);
+        
+        AcousticModem* getNode(uint64_t deviceId);
         
-        static AcousticModem* getNode(uint64_t deviceId);
+        SimulationManager* sm; //Owning simulation
         
     private:
         bool isReceptionPossible(Vector3 dir, Scalar distance);
@@ -101,11 +128,12 @@ namespace sf
         Vector3 position;
         std::string frame;
         
-        static void addNode(AcousticModem* node);
-        static void removeNode(uint64_t deviceId);
-        static bool mutualContact(uint64_t device1Id, uint64_t device2Id);
+        void addNode(AcousticModem* node);
+        void removeNode(uint64_t deviceId);
+        bool mutualContact(uint64_t device1Id, uint64_t device2Id);
         
-        static std::map<uint64_t, AcousticModem*> nodes;
+        static std::map<SimulationManager*, std::map<uint64_t, AcousticModem*>> nodes; //Separate network for each simulation
+        static SDL_mutex* nodesMutex;
     };
 }
     
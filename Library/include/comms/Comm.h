@@ -39,6 +39,8 @@ namespace sf
     class Entity;
     class StaticEntity;
     class SolidEntity;
+    class CloneContext;
+    class StateBuffer;
     
     struct CommDataFrame
     {
@@ -143,7 +145,43 @@ namespace sf
         //! A method returning the type of the comm.
         virtual CommType getType() = 0;
         
+        //! A method creating a copy of the comm device, attached to the copy of the body.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy or NULL if the comm device cannot be cloned
+         */
+        virtual Comm* Clone(CloneContext& ctx);
+        
+        //! A method saving the internal state of the comm device, including the messages in transit.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(StateBuffer& state);
+        
+        //! A method restoring the internal state of the comm device, replacing the messages in transit.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(StateBuffer& state);
+        
     protected:
+        virtual void InitCopy(CloneContext& ctx);
+        
+        //! A method saving a data frame.
+        /*!
+         \param state a reference to the state buffer
+         \param frame a pointer to the data frame
+         */
+        virtual void SaveFrame(StateBuffer& state, const CommDataFrame* frame);
+        
+        //! A method restoring a data frame.
+        /*!
+         \param state a reference to the state buffer
+         \param frame a pointer to the data frame to be filled or NULL to allocate a new one
+         \return a pointer to the restored data frame
+         */
+        virtual CommDataFrame* RestoreFrame(StateBuffer& state, CommDataFrame* frame = nullptr);
+        
         //! A method used for data reception.
         void MessageReceived(CommDataFrame* message);
         //! A method to proccess received messages.
@@ -153,12 +191,12 @@ namespace sf
         std::deque<CommDataFrame*> txBuffer;
         std::deque<CommDataFrame*> rxBuffer;
         uint64_t txSeq;
+        SDL_mutex* updateMutex;
         
     private:
         std::string name;
         uint64_t id;
         uint64_t cId;
-        SDL_mutex* updateMutex;
         Entity* attach;
         Transform o2c;
         bool renderable;
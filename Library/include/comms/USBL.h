@@ -71,6 +71,25 @@ namespace sf
         
         //! A method to get the current estimated position of transponders
         std::map<uint64_t, std::pair<Scalar, Vector3>>& getTransponderPositions(); 
+        
+        //! A method creating a copy of the comm device, attached to the copy of the body.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        Comm* Clone(CloneContext& ctx);
+        
+        //! A method saving the internal state of the USBL (pinging timer, positions of transponders and noise generator).
+        /*!
+         \param state a reference to the state buffer
+         */
+        void SaveState(StateBuffer& state);
+        
+        //! A method restoring the internal state of the USBL.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void RestoreState(StateBuffer& state);
        
     protected:
         void ProcessMessages();
@@ -85,9 +104,7 @@ namespace sf
         std::normal_distribution<Scalar> noiseAngle;
         std::normal_distribution<Scalar> noiseDepth;
         std::normal_distribution<Scalar> noiseNED;
-        
-        static std::random_device randomDevice;
-        static std::mt19937 randomGenerator;
+        std::mt19937 randomGenerator;
     };
 }
     
@@ -0,0 +1,110 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  AssetCache.h
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_AssetCache__
+#define __Stonefish_AssetCache__
+
+#include <map>
+#include <functional>
+#include <SDL2/SDL_mutex.h>
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    struct Mesh;
+
+    //! A class implementing a process-wide cache of immutable assets, shared by many simulation worlds.
+    /*!
+     Meshes loaded while the cache is active are stored under a key and handed out as shared constant pointers.
+     Assets owned by more than one object (cached meshes, collision shapes and height maps of cloned worlds)
+     are reference counted and freed when the last reference is removed. Assets never registered in the cache
+     have a single owner and are freed directly by the release methods.
+     */
+    class AssetCache
+    {
+    public:
+        //! A static method activating the cache (calls have to be balanced with Release).
+        static void Acquire();
+
+        //! A static method deactivating the cache and dropping the cached meshes when the last user releases it.
+        static void Release();
+
+        //! A static method informing if the cache is active.
+        static bool isActive();
+
+        //! A static method returning a shared mesh, built on the first request.
+        /*!
+         \param key a unique key identifying the mesh
+         \param build a function loading the mesh, called if the mesh is not cached
+         \return a pointer to the shared mesh (has to be released with ReleaseMesh)
+         */
+        static const Mesh* getMesh(const std::string& key, const std::function<Mesh*()>& build);
+
+        //! A static method generating a key identifying a mesh loaded from a file.
+        /*!
+         \param filename the path to the mesh file
+         \param scale the scale applied to the mesh
+         \param origin the transformation applied to the mesh
+         \param processing a tag describing further processing of the mesh
+         \return a unique key
+         */
+        static std::string MeshKey(const std::string& filename, Scalar scale, const Transform& origin, const std::string& processing);
+
+        //! A static method adding a reference to a shared asset.
+        /*!
+         \param asset a pointer to the asset
+         */
+        static void AddReference(const void* asset);
+
+        //! A static method removing a reference to an asset.
+        /*!
+         \param asset a pointer to the asset
+         \return true if it was the last reference and the caller has to free the asset
+         */
+        static bool RemoveReference(const void* asset);
+
+        //! A static method removing a reference to a mesh and freeing it if not used anymore.
+        /*!
+         \param mesh a pointer to the mesh
+         */
+        static void ReleaseMesh(const Mesh* mesh);
+
+        //! A static method removing a reference to a collision shape and freeing it if not used anymore.
+        /*!
+         \param shape a pointer to the collision shape (children of compound shapes are released recursively)
+         */
+        static void ReleaseShape(btCollisionShape* shape);
+
+    private:
+        AssetCache();
+
+        static unsigned int users;
+        static std::map<std::string, const Mesh*> meshes;
+        static std::map<const void*, unsigned int> refs;
+        static SDL_mutex* cacheMutex;
+    };
+}
+
+#endif
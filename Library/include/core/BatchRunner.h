@@ -0,0 +1,148 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  BatchRunner.h
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_BatchRunner__
+#define __Stonefish_BatchRunner__
+
+#include "core/SimulationManager.h"
+#include "utils/tinyxml2.h"
+
+namespace sf
+{
+    class SimulationApp;
+
+    //! A structure defining a modification of a single attribute of the scenario description.
+    struct ScenarioOverride
+    {
+        std::string path;       //!< Path to the element, e.g. "robot[name=GIRONA500]/world_transform"
+        std::string attribute;  //!< Name of the attribute
+        std::string value;      //!< New value of the attribute
+    };
+
+    //! A structure holding the outcome of a single run.
+    struct BatchRunResult
+    {
+        unsigned int id;          //!< Index of the run
+        bool success;             //!< Was the run completed?
+        Scalar simulatedTime;     //!< Simulated time [s]
+        Scalar wallTime;          //!< Wall clock time of the run, including scenario building [s]
+        std::string outputPath;   //!< Path to the file containing sensor histories
+    };
+
+    //! A class running many variants of a scenario in parallel, in headless fixed-step mode.
+    /*!
+     The scenario file is loaded and pre-processed once. Each run works on a copy of the description, modified
+     with its own overrides, and stores the measurements of all scalar sensors in a binary file with the following layout
+     (native byte order): "SFBR", uint32 version, uint32 run id, uint32 number of sensors, then for each sensor:
+     uint16 name length, name, uint16 number of channels, for each channel uint16 name length and name,
+     uint32 number of samples, and samples made of float64 timestamp followed by float64 channel values.
+     The asset cache is held for the whole lifetime of the runner, so meshes are loaded only once for all runs.
+     */
+    class BatchRunner
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param dataDirPath a path to the directory containing the simulation data
+         \param stepsPerSecond number of simulation steps per second
+         \param st type of solver that should be used
+         \param cft type of collision filtering used
+         */
+        BatchRunner(std::string dataDirPath, Scalar stepsPerSecond, SolverType st = SOLVER_SI, CollisionFilteringType cft = COLLISION_EXCLUSIVE);
+
+        //! A destructor.
+        ~BatchRunner();
+
+        //! A method loading the scenario description shared by all runs.
+        /*!
+         \param filename path to the scenario description file
+         \return was the scenario loaded successfully?
+         */
+        bool LoadScenario(const std::string& filename);
+
+        //! A method adding a run.
+        /*!
+         \param overrides a list of modifications of the scenario description
+         */
+        void AddRun(const std::vector<ScenarioOverride>& overrides);
+
+        //! A method loading runs from a text file.
+        /*!
+         Each non-empty line, not starting with '#', defines one run as a list of overrides separated with whitespaces,
+         in the form path@attribute=value (values containing spaces have to be quoted).
+         \param filename path to the file with run definitions
+         \return were the runs loaded successfully?
+         */
+        bool LoadRuns(const std::string& filename);
+
+        //! A method executing all runs.
+        /*!
+         \param duration the simulated time of each run [s]
+         \param numThreads the number of runs executed in parallel
+         \param outputDirPath a path to the directory where the output files will be written
+         \return results of all runs
+         */
+        std::vector<BatchRunResult> Run(Scalar duration, unsigned int numThreads, const std::string& outputDirPath);
+
+        //! A method returning the number of defined runs.
+        unsigned int getNumOfRuns();
+
+        //! A static method applying an override to a scenario description.
+        /*!
+         \param doc a pointer to the scenario description
+         \param o the override
+         \return was the override applied successfully?
+         */
+        static bool ApplyOverride(tinyxml2::XMLDocument* doc, const ScenarioOverride& o);
+
+        //! A static method converting a text definition to an override.
+        /*!
+         \param text the override in the form path@attribute=value
+         \param o a reference to the output override
+         \return was the text properly formatted?
+         */
+        static bool ParseOverride(const std::string& text, ScenarioOverride& o);
+
+    private:
+        BatchRunResult ExecuteRun(unsigned int id);
+        static int WorkerLoop(void* data);
+
+        std::string dataPath;
+        std::string outputPath;
+        Scalar sps;
+        SolverType solver;
+        CollisionFilteringType collisionFilter;
+        Scalar runDuration;
+        tinyxml2::XMLDocument scenario;
+        std::vector<std::vector<ScenarioOverride>> runs;
+        std::vector<BatchRunResult> results;
+        unsigned int nextRun;
+        SDL_mutex* runMutex;
+        SimulationManager* loaderManager;
+        SimulationApp* loaderApp;
+    };
+}
+
+#endif
@@ -0,0 +1,100 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  CloneContext.h
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_CloneContext__
+#define __Stonefish_CloneContext__
+
+#include <map>
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    class SimulationManager;
+    
+    //! A class storing the correspondence between the objects of a simulation world and their copies, used when cloning a world.
+    /*!
+     Objects are copied in the order of their dependencies. References to objects which were not copied yet
+     are remembered and patched when all objects are copied.
+     */
+    class CloneContext
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param target a pointer to the simulation manager receiving the copies
+         */
+        CloneContext(SimulationManager* target);
+        
+        //! A method registering a copy of an object.
+        /*!
+         \param original a pointer to the original object
+         \param copy a pointer to the copy
+         */
+        void AddCopy(const void* original, void* copy);
+        
+        //! A method returning the copy of an object.
+        /*!
+         \param original a pointer to the original object
+         \return a pointer to the copy or NULL if the object was not copied
+         */
+        template<class T> T* getCopy(T* original) const
+        {
+            std::map<const void*, void*>::const_iterator it = copies.find(original);
+            return it == copies.end() ? NULL : (T*)it->second;
+        }
+        
+        //! A method replacing a pointer to an original object with a pointer to its copy.
+        /*!
+         If the object was not copied yet, the pointer is patched when calling Resolve.
+         \param ptr a reference to the pointer
+         */
+        template<class T> void Remap(T*& ptr)
+        {
+            if(ptr == NULL)
+                return;
+            T* copy = getCopy(ptr);
+            if(copy != NULL)
+                ptr = copy;
+            else
+                pending.push_back(std::make_pair((void**)&ptr, (const void*)ptr));
+        }
+        
+        //! A method patching the pointers remapped before the objects were copied.
+        /*!
+         \return true if all pointers were patched, false if some objects were not copied
+         */
+        bool Resolve();
+        
+        //! A method returning a pointer to the simulation manager receiving the copies.
+        SimulationManager* getSimulationManager() const;
+        
+    private:
+        SimulationManager* sm;
+        std::map<const void*, void*> copies;
+        std::vector<std::pair<void**, const void*>> pending;
+    };
+}
+
+#endif
@@ -27,6 +27,7 @@
 #define __Stonefish_ConsoleSimulationApp__
 
 #include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_mutex.h>
 #include "core/SimulationApp.h"
 
 namespace sf
@@ -51,16 +52,32 @@ namespace sf
         //! A method informing if the application is graphical.
         bool hasGraphics();
         
+        //! A method implementing periodic work done in the main thread, while the simulation is running.
+        virtual void PeriodicUpdate();
+        
+        //! A method setting the rate at which the periodic update is called.
+        /*!
+         \param f the frequency of the periodic update [Hz] (0 disables the periodic update)
+         */
+        void setPeriodicUpdateFrequency(Scalar f);
+        
+        //! A method returning the rate at which the periodic update is called.
+        Scalar getPeriodicUpdateFrequency();
+        
     protected:
         virtual void Loop();
         void StartSimulation();
         void ResumeSimulation();
         void StopSimulation();
+        void Quit();
         
     private:
         void Init();
         
         SDL_Thread* simulationThread;
+        SDL_mutex* loopMutex;
+        SDL_cond* loopCond;
+        Scalar periodicFreq;
         
         static int RunSimulation(void* data);
     };
@@ -0,0 +1,89 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  ContactInfoPool.h
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_ContactInfoPool__
+#define __Stonefish_ContactInfoPool__
+
+#include <atomic>
+#include "sensors/Contact.h"
+
+namespace sf
+{
+    //! A class implementing a fixed-block pool for the data attached to contact points.
+    /*!
+     Blocks are allocated in chunks which are never returned to the system before the pool is destroyed,
+     so allocating and releasing a block are constant time operations on a free list.
+     Each block remembers its pool, so it can be released without knowing which simulation created it.
+     */
+    class ContactInfoPool
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param blocksPerChunk the number of blocks allocated at once when the pool runs out of free blocks
+         */
+        ContactInfoPool(unsigned int blocksPerChunk = 1024);
+
+        //! A destructor.
+        ~ContactInfoPool();
+
+        //! A method returning a zero initialised contact information structure.
+        ContactInfo* Allocate();
+
+        //! A static method returning a contact information structure to the pool that created it.
+        /*!
+         \param info a pointer to the structure obtained from a pool
+         */
+        static void Release(ContactInfo* info);
+
+        //! A method returning the number of blocks in use.
+        unsigned int getNumOfUsedBlocks() const;
+
+        //! A method returning the maximum number of blocks used at the same time.
+        unsigned int getHighWaterMark() const;
+
+        //! A method returning the number of allocated blocks.
+        unsigned int getCapacity() const;
+
+    private:
+        struct Block
+        {
+            ContactInfo info; //Has to be the first member
+            Block* next;
+            ContactInfoPool* owner;
+        };
+
+        void AddChunk();
+
+        std::vector<Block*> chunks;
+        Block* freeList;
+        unsigned int chunkSize;
+        std::atomic<unsigned int> capacity;
+        std::atomic<unsigned int> used;
+        std::atomic<unsigned int> highWaterMark;
+    };
+}
+
+#endif
@@ -30,6 +30,9 @@
 
 namespace sf
 {
+    class StepProfiler;
+    class SimulationManager;
+    
     //! A class implementing a custom collision dispatcher object.
     class FilteredCollisionDispatcher : public btCollisionDispatcher
     {
@@ -37,9 +40,11 @@ namespace sf
         //! A constructor.
         /*!
          \param collisionConfiguration a pointer to the collision configuration structure
+         \param simManager a pointer to the simulation manager owning the collision world
          \param inclusiveMode a flag that selects the mode of collision detection
+         \param prof a pointer to the profiler used to time the collision detection (optional)
          */
-        FilteredCollisionDispatcher(btCollisionConfiguration* collisionConfiguration, bool inclusiveMode);
+        FilteredCollisionDispatcher(btCollisionConfiguration* collisionConfiguration, SimulationManager* simManager, bool inclusiveMode, StepProfiler* prof = NULL);
         
         //! A method that informs if two collision objects can collide.
         /*!
@@ -49,6 +54,14 @@ namespace sf
          */
         bool needsCollision(const btCollisionObject* body0, const btCollisionObject* body1);
         
+        //! A method running the narrowphase collision detection for all overlapping pairs.
+        /*!
+         \param pairCache a pointer to the overlapping pair cache
+         \param dispatchInfo a reference to the collision dispatcher info structure
+         \param dispatcher a pointer to the collision dispatcher
+         */
+        void dispatchAllCollisionPairs(btOverlappingPairCache* pairCache, const btDispatcherInfo& dispatchInfo, btDispatcher* dispatcher);
+        
         //! A method calling the collision computation algorithm.
         /*!
          \param collisionPair a reference to a collision pair info structure
@@ -57,8 +70,19 @@ namespace sf
          */
         static void myNearCallback(btBroadphasePair& collisionPair, btCollisionDispatcher& dispatcher, const btDispatcherInfo& dispatchInfo);
         
+        //! A static method returning the simulation manager whose collision world is running the narrowphase in the calling thread.
+        /*!
+         Bullet contact callbacks are global and do not receive the collision world, so they use this method to find the world.
+         \return a pointer to the simulation manager or NULL if called outside of the narrowphase
+         */
+        static SimulationManager* getDispatchingManager();
+        
     private:
+        SimulationManager* sm;
         bool inclusive;
+        StepProfiler* profiler;
+        
+        static thread_local SimulationManager* dispatchingManager;
     };
 }
 
@@ -26,7 +26,6 @@
 #ifndef __Stonefish_MaterialManager__
 #define __Stonefish_MaterialManager__
 
-#include <unordered_map>
 #include "core/NameManager.h"
 
 namespace sf
@@ -37,6 +36,15 @@ namespace sf
         std::string name;
         Scalar density;
         Scalar restitution;
+        int index; //!< Position in the material manager, used to look up interactions without string comparison
+        
+        Material()
+        {
+            name = "";
+            density = Scalar(0);
+            restitution = Scalar(0);
+            index = -1;
+        }
     };
     
     //! A structure holding fluid properties.
@@ -63,30 +71,6 @@ namespace sf
         Scalar fDynamic;
     };
     
-    //! A structure representing a pair of materials.
-    struct MaterialPair
-    {
-        int mat1Id;
-        int mat2Id;
-        
-        bool operator==(const MaterialPair& rhs) const
-        {
-            return (mat1Id == rhs.mat1Id && mat2Id == rhs.mat2Id)||(mat1Id == rhs.mat2Id && mat2Id == rhs.mat1Id);
-        }
-    };
-    
-    //! A hashing function for material interaction.
-    struct MaterialPairHash
-    {
-        std::size_t operator()(const MaterialPair& mp) const
-        {
-            if(mp.mat1Id <= mp.mat2Id)
-                return std::hash<int>()(mp.mat1Id) ^ (std::hash<int>()(mp.mat2Id) << 16);
-            else
-                return std::hash<int>()(mp.mat2Id) ^ (std::hash<int>()(mp.mat1Id) << 16);
-        }
-    };
-    
     class NameManager;
     
     //! A class implementing a physical material manager.
@@ -120,11 +104,12 @@ namespace sf
         
         //! A method that returns friction information for a specified pair of materials.
         /*!
+         Interactions are stored in a dense symmetric table, so this is a single array read, suitable for contact callbacks.
          \param mat1Index an id of the first material
          \param mat2Index and id of the second material
          \return a structure containing friction coefficients
          */
-        Friction GetMaterialsInteraction(int mat1Index, int mat2Index);
+        Friction GetMaterialsInteraction(int mat1Index, int mat2Index) const;
         
         //! A method that returns friction information for a specified pair of materials.
         /*!
@@ -182,7 +167,7 @@ namespace sf
         int getMaterialIndex(const std::string& name);
         
         std::vector<Material> materials;
-        std::unordered_map<MaterialPair, Friction, MaterialPairHash> interactions;
+        std::vector<Friction> interactions; //Dense N x N table, indexed with mat1Index * N + mat2Index
         std::vector<Fluid> fluids;
         
         NameManager materialNameManager;
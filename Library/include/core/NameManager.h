@@ -26,11 +26,17 @@
 #ifndef __Stonefish_NameManager__
 #define __Stonefish_NameManager__
 
+#include <unordered_map>
+#include <unordered_set>
 #include "StonefishCommon.h"
 
 namespace sf
 {
     //! A class used to manage unique names of objects in the simulation.
+    /*!
+     Names are kept in a hash set and the next free numeric suffix is remembered for each proposed name,
+     so adding many objects with the same name does not require rescanning the pool.
+     */
     class NameManager
     {
     public:
@@ -57,7 +63,8 @@ namespace sf
         void ClearNames();
         
     private:
-        std::vector<std::string> names;
+        std::unordered_set<std::string> names;
+        std::unordered_map<std::string, unsigned int> nextSuffix;
     };
 }
     
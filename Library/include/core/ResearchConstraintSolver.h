@@ -29,6 +29,7 @@
 #include <BulletDynamics/Featherstone/btMultiBodyConstraintSolver.h>
 #include <BulletDynamics/MLCPSolvers/btMLCPSolverInterface.h>
 #include "StonefishCommon.h"
+#include "core/StepProfiler.h"
 
 namespace sf
 {
@@ -39,8 +40,9 @@ namespace sf
         //! A constructor.
         /*!
          \param mlcp a pointer to an MLCP type solver
+         \param prof a pointer to the profiler used to time the MLCP solution (optional)
          */
-        ResearchConstraintSolver(btMLCPSolverInterface* mlcp);
+        ResearchConstraintSolver(btMLCPSolverInterface* mlcp, StepProfiler* prof = NULL);
         
         //! A destructor.
         virtual ~ResearchConstraintSolver();
@@ -73,9 +75,19 @@ namespace sf
         btVectorXu m_bSplit1;
         btVectorXu m_xSplit2;
         
+        ///scratch memory used to build the MLCP (owned by the solver to allow multiple simulations running in parallel)
+        btMatrixXu m_scratchJ3;
+        btMatrixXu m_scratchJInvM3;
+        btAlignedObjectArray<int> m_scratchOfs;
+        btMatrixXu m_scratchMInv;
+        btMatrixXu m_scratchJ;
+        btMatrixXu m_scratchJTranspose;
+        btMatrixXu m_scratchTmp;
+        
         btAlignedObjectArray<int> m_limitDependencies;
         btAlignedObjectArray<btSolverConstraint*> m_allConstraintPtrArray;
         btMLCPSolverInterface* m_solver;
+        StepProfiler* m_profiler;
         int m_fallback;
         Scalar m_cfm;
         bool m_gUseMatrixMultiply;
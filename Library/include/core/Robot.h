@@ -27,6 +27,7 @@
 #define __Stonefish_Robot__
 
 #include <utility>
+#include <unordered_map>
 #include "StonefishCommon.h"
 
 namespace sf
@@ -42,6 +43,7 @@ namespace sf
     class VisionSensor;
     class LinkActuator;
     class JointActuator;
+    class CloneContext;
     
     //! A class implementing a robotic system composed of a dynamic rigid-body tree, actuators and sensors.
     class Robot
@@ -220,6 +222,13 @@ namespace sf
         //! A method returning the name of the robot.
         std::string getName();
         
+        //! A method creating a copy of the robot, composed of the copies of its parts.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        virtual Robot* Clone(CloneContext& ctx);
+        
     private:
         struct JointData
         {
@@ -244,6 +253,11 @@ namespace sf
         std::vector<Sensor*> sensors;
         std::vector<Actuator*> actuators;
         std::vector<Comm*> comms;
+        std::unordered_map<std::string, SolidEntity*> linksByName;
+        std::unordered_map<std::string, int> jointIds;
+        std::unordered_map<std::string, Sensor*> sensorsByName;
+        std::unordered_map<std::string, Actuator*> actuatorsByName;
+        std::unordered_map<std::string, Comm*> commsByName;
         std::string name;
     };
 }
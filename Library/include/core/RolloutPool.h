@@ -0,0 +1,91 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RolloutPool.h
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_RolloutPool__
+#define __Stonefish_RolloutPool__
+
+#include <functional>
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    class SimulationManager;
+    class SimulationApp;
+    class ThreadPool;
+
+    //! A class managing a set of headless copies of a running simulation world, used for parallel look-ahead rollouts.
+    /*!
+     The copies are cloned once from the source world, sharing its meshes and collision shapes by reference counting,
+     while the dynamic state (bodies, constraints, actuators, sensors) is copied. Branching copies the dynamic state of
+     the source world into all copies, without rebuilding anything, after which each copy can be modified and stepped independently.
+     */
+    class RolloutPool
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param source a pointer to the simulation manager to be copied (has to be started)
+         \param numOfClones the number of copies
+         \param factory a function creating a new, empty simulation manager of the same type as the source
+         \param numOfThreads the number of threads used to step the copies (0 means one per copy)
+         */
+        RolloutPool(SimulationManager* source, unsigned int numOfClones, const std::function<SimulationManager*()>& factory, unsigned int numOfThreads = 0);
+
+        //! A destructor.
+        ~RolloutPool();
+
+        //! A method copying the current state of the source world to all copies.
+        /*!
+         \return were all copies updated?
+         */
+        bool Branch();
+
+        //! A method stepping all copies in parallel, with a constant time step.
+        /*!
+         \param duration the simulated time [s]
+         \param control a function called in the thread of the copy, before stepping, e.g., to set actuator commands
+         */
+        void Rollout(Scalar duration, const std::function<void(unsigned int, SimulationManager*)>& control = nullptr);
+
+        //! A method returning a pointer to a copy.
+        /*!
+         \param index the index of the copy
+         \return a pointer to the simulation manager of the copy
+         */
+        SimulationManager* getClone(unsigned int index);
+
+        //! A method returning the number of copies.
+        unsigned int getNumOfClones();
+
+    private:
+        SimulationManager* src;
+        SimulationApp* srcApp;
+        std::vector<SimulationManager*> clones;
+        std::vector<SimulationApp*> apps;
+        ThreadPool* pool;
+    };
+}
+
+#endif
@@ -58,9 +58,21 @@ namespace sf
          */
         virtual bool Parse(std::string filename);
         
+        //! A method used to load a scenario description file and resolve includes, without building the scenario.
+        /*!
+         \param filename path to the scenario description file
+         */
+        bool Load(const std::string& filename);
+        
+        //! A method used to build the scenario from the loaded description.
+        bool Build();
+        
         //! A method used to get the pointer to the associated simulation manager.
         SimulationManager* getSimulationManager();
         
+        //! A method used to get the pointer to the loaded scenario description.
+        XMLDocument* getDocument();
+        
     protected:
         //! A method used to pre-process the xml description file after loading.
         /*!
@@ -78,7 +78,19 @@ namespace sf
         //! A method returning a pointer to the console associated with the application.
         Console* getConsole();
         
-        //! A static method returning the pointer to the currently running application.
+        //! A method binding the application to the calling thread.
+        /*!
+         After binding, getApp() called from this thread returns this application, which makes it possible
+         to run multiple independent simulations in one process, each in its own thread.
+         The thread constructing the application is bound automatically.
+         */
+        void BindToThread();
+        
+        //! A static method returning the pointer to the application bound to the calling thread.
+        /*!
+         Threads created outside of the library have to call BindToThread() before using the simulation.
+         \return a pointer to the application or NULL if no application is bound to the calling thread
+         */
         static SimulationApp* getApp();
         
     protected:
@@ -102,7 +114,7 @@ namespace sf
         bool running;
         double physicsTime;
         
-        static SimulationApp* handle;
+        static thread_local SimulationApp* threadHandle;
     };
 }
 
@@ -26,8 +26,13 @@
 #ifndef __Stonefish_SimulationManager__
 #define __Stonefish_SimulationManager__
 
+#include <queue>
+#include <atomic>
+#include <unordered_map>
 #include <SDL2/SDL_mutex.h>
 #include "StonefishCommon.h"
+#include "core/StepProfiler.h"
+#include "core/ThreadPool.h"
 #include "entities/forcefields/Ocean.h"
 #include "entities/forcefields/Atmosphere.h"
 #include "entities/SolidEntity.h"
@@ -44,11 +49,13 @@ namespace sf
     class StaticEntity;
     class AnimatedEntity;
     class FeatherstoneEntity;
+    class Trigger;
     class Joint;
     class Actuator;
     class Sensor;
     class Comm;
     class Contact;
+    class ContactInfoPool;
     class OpenGLTrackball;
     class OpenGLDebugDrawer;
     
@@ -65,6 +72,37 @@ namespace sf
         Entity* B;
     };
     
+    //! A type representing an unordered pair of entities (the pointers are sorted).
+    typedef std::pair<const Entity*, const Entity*> EntityPair;
+    
+    //! A function creating a key representing an unordered pair of entities.
+    inline EntityPair MakeEntityPair(const Entity* entA, const Entity* entB)
+    {
+        return std::less<const Entity*>()(entA, entB) ? EntityPair(entA, entB) : EntityPair(entB, entA);
+    }
+    
+    //! A hashing function for pairs of entities.
+    struct EntityPairHash
+    {
+        std::size_t operator()(const EntityPair& p) const
+        {
+            std::size_t h0 = std::hash<const Entity*>()(p.first);
+            std::size_t h1 = std::hash<const Entity*>()(p.second);
+            return h0 ^ (h1 + 0x9e3779b9 + (h0 << 6) + (h0 >> 2));
+        }
+    };
+    
+    //! A structure used to schedule the updates of sensors
+    struct SensorDeadline
+    {
+        Scalar time;
+        Scalar period;
+        Sensor* sensor;
+        
+        //! An operator used to order the deadlines in the scheduler queue.
+        bool operator>(const SensorDeadline& other) const { return time > other.time; }
+    };
+    
     //! An abstract class managing the simulation world, the solver settings and implementing custom physics callbacks.
     class SimulationManager
     {
@@ -108,6 +146,13 @@ namespace sf
         //! A method which starts the simulation.
         bool StartSimulation();
         
+        //! A method which starts the simulation from a saved state, skipping the initial conditions problem.
+        /*!
+         \param state a buffer containing the state, saved in a world built from the same scenario
+         \return was the simulation started?
+         */
+        bool StartSimulation(const std::vector<uint8_t>& state);
+        
         //! A method which stops the simulation.
         void StopSimulation();
         
@@ -117,9 +162,40 @@ namespace sf
         //! A method which restarts the simulation.
         void RestartScenario();
         
+        //! A method replacing the simulation world with a copy of another world, including its dynamic state.
+        /*!
+         The copy shares the meshes and collision shapes of the source, instead of building the scenario again.
+         Only worlds without graphics can be cloned.
+         \param source a pointer to the simulation manager to be copied (has to be started)
+         \return was the world successfully copied and started?
+         */
+        bool CloneScenario(SimulationManager* source);
+        
         //! A method computing the next simulation step.
         void AdvanceSimulation();
         
+        //! A method advancing the simulation by a fixed number of steps, without synchronization to real time.
+        /*!
+         \param nSteps number of simulation steps to compute (each lasting 1/stepsPerSecond)
+         */
+        void StepSimulation(unsigned int nSteps = 1);
+        
+        //! A method saving the dynamic state of the simulation world to a compact binary blob.
+        /*!
+         The state includes the poses and velocities of all bodies and multibodies, the internal state of actuators, sensors
+         and comms (with the messages in transit), the sensor schedule and the simulation time. It can only be restored in the same world (same scenario and build).
+         \return a buffer containing the state
+         */
+        std::vector<uint8_t> SaveState();
+        
+        //! A method restoring the dynamic state of the simulation world, without rebuilding the scenario.
+        /*!
+         Contact caches are cleared and measurements newer than the restored simulation time are removed from sensor histories.
+         \param state a buffer containing the state, created with SaveState()
+         \return was the state successfully restored?
+         */
+        bool RestoreState(const std::vector<uint8_t>& state);
+        
         //! A method updating the drawing queue (thread safe)
         void UpdateDrawingQueue();
         
@@ -182,6 +258,9 @@ namespace sf
          */
         void AddSensor(Sensor* sens);
         
+        //! A method informing the scheduler that the update rate of a sensor has changed.
+        void RescheduleSensors();
+        
         //! A method that adds a communication device to the simulation world.
         /*!
          \param comm a pointer to the comm object
@@ -208,11 +287,11 @@ namespace sf
          */
         void DisableCollision(const Entity* entA, const Entity* entB);
         
-        //! A method that checks if collision is enabled between specified entities.
+        //! A method that checks if a collision rule is defined for the specified entities (constant time).
         /*!
          \param entA a pointer to the first entity
          \param entB a pointer to the second entity
-         \return
+         \return the id of the rule or -1 if not defined (in the inclusive mode a rule enables collision, in the exclusive mode it disables it)
          */
         int CheckCollision(const Entity* entA, const Entity* entB);
         
@@ -234,6 +313,14 @@ namespace sf
          */
         Entity* PickEntity(Vector3 eye, Vector3 ray);
         
+        //! A method performing a ray test against the collision world, which can be safely called from multiple threads.
+        /*!
+         \param from the start point of the ray in the world frame
+         \param to the end point of the ray in the world frame
+         \param result a reference to the ray result callback
+         */
+        void RayTest(const Vector3& from, const Vector3& to, btCollisionWorld::RayResultCallback& result);
+        
         //! A method that sets new valve for the amount of simulation steps in a second.
         /*!
          \param steps number steps of simulation per second
@@ -246,6 +333,34 @@ namespace sf
          */
         void setRealtimeFactor(Scalar f);
         
+        //! A method that enables the fixed-step mode, in which the simulation runs as fast as possible, without sleeping.
+        /*!
+         \param enabled a flag specifying if fixed-step mode should be used
+         */
+        void setFixedStepMode(bool enabled);
+        
+        //! A method that sets the number of threads used to compute fluid forces and update sensors.
+        /*!
+         \param n number of threads including the simulation thread (<=1 means serial computation)
+         */
+        void setNumOfWorkerThreads(unsigned int n);
+        
+        //! A method that sets the seed from which the noise generators of all sensors are seeded.
+        /*!
+         Each sensor is seeded with a value derived from this seed and its unique name, so that the noise does not depend
+         on the order in which sensors are created or updated. Sensors that already exist are reseeded.
+         USBLs are seeded in the same way when they are created.
+         \param seed the seed of the simulation
+         */
+        void setRandomSeed(uint32_t seed);
+        
+        //! A method returning a seed derived from the simulation seed and a key.
+        /*!
+         \param key a unique key, e.g. the name of a sensor
+         \return the derived seed
+         */
+        uint32_t DeriveRandomSeed(const std::string& key) const;
+        
         //! A method used to setup the initial conditions solver.
         /*!
          \param useGravity specifies if gravity should be enabled during IC solving
@@ -276,6 +391,12 @@ namespace sf
         //! A method returning the usage of the CPU by the physics computation in percent.
         Scalar getCpuUsage();
         
+        //! A method returning the rolling timing statistics of the phases of the simulation step.
+        /*!
+         \return a structure containing mean, 95th percentile and maximum duration of each phase, and the usage of the contact data pool
+         */
+        StepProfile getStepProfile();
+        
         //! A method returning the current number of steps per second used.
         Scalar getStepsPerSecond();
         
@@ -348,7 +469,7 @@ namespace sf
          */
         Contact* getContact(const std::string& name);
         
-        //! A method returning a contavt by entity pair.
+        //! A method returning a contavt by entity pair (constant time).
         /*!
          \param entA a pointer to the first entity
          \param entB a pointer to the sencond entity
@@ -419,6 +540,15 @@ namespace sf
         //! A method informing about the relation between the simulated time and real time.
         Scalar getRealtimeFactor();
         
+        //! A method informing if the simulation runs in the fixed-step mode.
+        bool isFixedStepMode();
+        
+        //! A method returning the number of threads used to compute fluid forces and update sensors.
+        unsigned int getNumOfWorkerThreads();
+        
+        //! A method returning the seed of the simulation.
+        uint32_t getRandomSeed() const;
+        
         //! A method returning a pointer to the material manager.
         MaterialManager* getMaterialManager();
         
@@ -487,11 +617,19 @@ namespace sf
         btDefaultCollisionConfiguration* dwCollisionConfig;
         
         MaterialManager* materialManager;
+        StepProfiler* profiler;
+        ContactInfoPool* contactInfoPool;
+        ThreadPool* threadPool;
         
     private:
         void RenderBulletDebug();
         void InitializeSolver();
         void InitializeScenario();
+        void CheckSolverFallbacks();
+        void RegisterEntity(Entity* ent);
+        void AddCollisionRule(const Entity* entA, const Entity* entB);
+        void RemoveCollisionRule(int colId);
+        void UpdateSensors(Scalar dt);
         
         SolverType solver;
         CollisionFilteringType collisionFilter;
@@ -502,7 +640,6 @@ namespace sf
         unsigned int fdCounter;
         SDL_mutex* simSettingsMutex;
         SDL_mutex* simInfoMutex;
-        SDL_mutex* simHydroMutex;
         
         Scalar simulationTime;
         uint64_t currentTime;
@@ -517,16 +654,36 @@ namespace sf
         unsigned int mlcpFallbacks;
         bool icProblemSolved;
         bool simulationFresh;
+        bool fixedStep;
+        uint32_t randomSeed;
         
         NameManager* nameManager;
         std::vector<Robot*> robots;
         std::vector<Entity*> entities;
+        std::vector<SolidEntity*> solidEntities;
+        std::vector<FeatherstoneEntity*> featherstoneEntities;
+        std::vector<AnimatedEntity*> animatedEntities;
+        std::vector<Trigger*> triggers;
         std::vector<Joint*> joints;
         std::vector<Sensor*> sensors;
         std::vector<Actuator*> actuators;
         std::vector<Comm*> comms;
         std::vector<Contact*> contacts;
         std::vector<Collision> collisions;
+        std::unordered_map<std::string, Robot*> robotsByName;
+        std::unordered_map<std::string, Entity*> entitiesByName;
+        std::unordered_map<std::string, Joint*> jointsByName;
+        std::unordered_map<std::string, Sensor*> sensorsByName;
+        std::unordered_map<std::string, Actuator*> actuatorsByName;
+        std::unordered_map<std::string, Comm*> commsByName;
+        std::unordered_map<std::string, Contact*> contactsByName;
+        std::unordered_map<EntityPair, size_t, EntityPairHash> collisionIds;
+        std::unordered_map<EntityPair, Contact*, EntityPairHash> contactsByPair;
+        std::vector<SolidEntity*> fluidSolids;
+        std::priority_queue<SensorDeadline, std::vector<SensorDeadline>, std::greater<SensorDeadline>> sensorQueue;
+        std::vector<SensorDeadline> dueSensors;
+        std::vector<Sensor*> tickSensors;
+        std::atomic<bool> sensorScheduleChanged; //Set from any thread (e.g. when the rate of a sensor changes)
         NED* ned;
         Ocean* ocean;
         Atmosphere* atmosphere;
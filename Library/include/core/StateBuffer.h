@@ -0,0 +1,126 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  StateBuffer.h
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_StateBuffer__
+#define __Stonefish_StateBuffer__
+
+#include <random>
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    //! A class implementing a compact binary buffer used to save and restore the state of the simulation.
+    /*!
+     Values are stored in the native binary format, so the buffer can only be restored by the same build of the library.
+     Reading past the end of the buffer does not fail immediately but invalidates the buffer.
+     */
+    class StateBuffer
+    {
+    public:
+        //! A constructor of an empty buffer, used for writing.
+        StateBuffer();
+
+        //! A constructor of a buffer used for reading.
+        /*!
+         \param bytes the contents of the buffer
+         */
+        StateBuffer(const std::vector<uint8_t>& bytes);
+
+        //! A method writing a scalar value.
+        void Write(Scalar v);
+
+        //! A method writing an unsigned integer value.
+        void Write(uint32_t v);
+
+        //! A method writing a long unsigned integer value.
+        void Write(uint64_t v);
+
+        //! A method writing a flag.
+        void Write(bool v);
+
+        //! A method writing a vector.
+        void Write(const Vector3& v);
+
+        //! A method writing a transformation (matrix and origin, to restore it exactly).
+        void Write(const Transform& v);
+
+        //! A method writing a string (preceded by its length).
+        void Write(const std::string& v);
+
+        //! A method writing the state of a random number generator.
+        void Write(const std::mt19937& v);
+
+        //! A method writing the state of a normal distribution (including the cached sample).
+        void Write(const std::normal_distribution<Scalar>& v);
+
+        //! A method reading a scalar value.
+        void Read(Scalar& v);
+
+        //! A method reading an unsigned integer value.
+        void Read(uint32_t& v);
+
+        //! A method reading a long unsigned integer value.
+        void Read(uint64_t& v);
+
+        //! A method reading a flag.
+        void Read(bool& v);
+
+        //! A method reading a vector.
+        void Read(Vector3& v);
+
+        //! A method reading a transformation.
+        void Read(Transform& v);
+
+        //! A method reading a string.
+        void Read(std::string& v);
+
+        //! A method reading the state of a random number generator.
+        void Read(std::mt19937& v);
+
+        //! A method reading the state of a normal distribution.
+        void Read(std::normal_distribution<Scalar>& v);
+
+        //! A method returning the contents of the buffer.
+        const std::vector<uint8_t>& getBytes() const;
+
+        //! A method informing if all reads were within the buffer.
+        bool isValid() const;
+
+        //! A method informing if all data was read.
+        bool isAtEnd() const;
+
+    private:
+        void WriteRaw(const void* src, size_t len);
+        void ReadRaw(void* dst, size_t len);
+        template<typename T> void WriteObject(const T& v);
+        template<typename T> void ReadObject(T& v);
+
+        std::vector<uint8_t> data;
+        size_t pos;
+        bool valid;
+    };
+}
+
+#endif
@@ -0,0 +1,166 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  StepProfiler.h
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_StepProfiler__
+#define __Stonefish_StepProfiler__
+
+#include <chrono>
+#include <SDL2/SDL_mutex.h>
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    //! An enum defining the phases of a simulation step that are timed by the profiler.
+    enum class StepPhase : unsigned int {STEP = 0, ACTUATORS, BODIES, AERODYNAMICS, HYDRODYNAMICS, BROADPHASE, NARROWPHASE, SOLVER, MLCP, SENSORS, COMMS, CONTACTS};
+
+    //! Number of phases defined in the StepPhase enum.
+    const unsigned int STEP_PHASE_COUNT = 12;
+
+    //! A structure holding the timing statistics of a single phase of the simulation step.
+    struct PhaseTiming
+    {
+        double mean; //!< Mean duration of the phase [ms]
+        double p95;  //!< 95th percentile of the duration of the phase [ms]
+        double max;  //!< Maximum duration of the phase [ms]
+
+        //! A constructor.
+        PhaseTiming() : mean(0.0), p95(0.0), max(0.0) {}
+    };
+
+    //! A structure holding the timing statistics of all phases of the simulation step.
+    struct StepProfile
+    {
+        bool enabled;                      //!< Was the library compiled with profiling enabled?
+        unsigned int samples;              //!< Number of steps used to compute the statistics
+        std::vector<PhaseTiming> phases;   //!< Statistics indexed by the StepPhase enum
+        unsigned int contactsInUse;        //!< Number of contact point data blocks currently in use
+        unsigned int contactsHighWater;    //!< Maximum number of contact point data blocks used at the same time
+        unsigned int contactsCapacity;     //!< Number of contact point data blocks allocated by the pool
+
+        //! A constructor.
+        StepProfile() : enabled(false), samples(0), phases(STEP_PHASE_COUNT), contactsInUse(0), contactsHighWater(0), contactsCapacity(0) {}
+
+        //! A method returning the statistics of a specific phase.
+        const PhaseTiming& operator[](StepPhase p) const { return phases[(unsigned int)p]; }
+    };
+
+    //! A class measuring the duration of the phases of the simulation step, with rolling statistics.
+    class StepProfiler
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param windowLength the number of steps used to compute rolling statistics
+         */
+        StepProfiler(unsigned int windowLength = 500);
+
+        //! A destructor.
+        ~StepProfiler();
+
+        //! A method marking the beginning of a simulation step.
+        void BeginStep();
+
+        //! A method marking the end of a simulation step and storing the durations of its phases.
+        void EndStep();
+
+        //! A method marking the beginning of a phase.
+        /*!
+         \param p the phase
+         */
+        void BeginPhase(StepPhase p);
+
+        //! A method marking the end of a phase (durations of multiple calls within a step are summed).
+        /*!
+         \param p the phase
+         */
+        void EndPhase(StepPhase p);
+
+        //! A method clearing all collected statistics.
+        void Reset();
+
+        //! A method computing the rolling statistics (thread safe).
+        StepProfile getProfile();
+
+        //! A static method returning the name of a phase.
+        /*!
+         \param p the phase
+         \return a human readable name of the phase
+         */
+        static std::string getPhaseName(StepPhase p);
+
+    private:
+        static inline uint64_t Now()
+        {
+            return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        bool inStep;
+        uint64_t phaseStart[STEP_PHASE_COUNT];
+        uint64_t phaseAccum[STEP_PHASE_COUNT];
+        std::vector<float> history[STEP_PHASE_COUNT];
+        unsigned int window;
+        unsigned int head;
+        unsigned int count;
+        SDL_mutex* historyMutex;
+    };
+
+    //! A class implementing a timer measuring a phase for the duration of a scope.
+    class ScopedPhaseTimer
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param prof a pointer to the profiler
+         \param p the phase
+         */
+        ScopedPhaseTimer(StepProfiler* prof, StepPhase p) : profiler(prof), phase(p) { if(profiler != NULL) profiler->BeginPhase(phase); }
+
+        //! A destructor.
+        ~ScopedPhaseTimer() { if(profiler != NULL) profiler->EndPhase(phase); }
+
+    private:
+        StepProfiler* profiler;
+        StepPhase phase;
+    };
+}
+
+//Instrumentation macros (compiled out unless STONEFISH_PROFILING is defined)
+#ifdef STONEFISH_PROFILING
+    #define SF_PROFILE_CONCAT_(a, b) a##b
+    #define SF_PROFILE_CONCAT(a, b) SF_PROFILE_CONCAT_(a, b)
+    #define SF_PROFILE_SCOPE(profiler, phase) sf::ScopedPhaseTimer SF_PROFILE_CONCAT(sfPhaseTimer, __LINE__)(profiler, phase)
+    #define SF_PROFILE_BEGIN(profiler, phase) do { if((profiler) != NULL) (profiler)->BeginPhase(phase); } while(0)
+    #define SF_PROFILE_END(profiler, phase) do { if((profiler) != NULL) (profiler)->EndPhase(phase); } while(0)
+    #define SF_PROFILE_STEP_BEGIN(profiler) do { if((profiler) != NULL) (profiler)->BeginStep(); } while(0)
+    #define SF_PROFILE_STEP_END(profiler) do { if((profiler) != NULL) (profiler)->EndStep(); } while(0)
+#else
+    #define SF_PROFILE_SCOPE(profiler, phase)
+    #define SF_PROFILE_BEGIN(profiler, phase)
+    #define SF_PROFILE_END(profiler, phase)
+    #define SF_PROFILE_STEP_BEGIN(profiler)
+    #define SF_PROFILE_STEP_END(profiler)
+#endif
+
+#endif
@@ -0,0 +1,80 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  ThreadPool.h
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_ThreadPool__
+#define __Stonefish_ThreadPool__
+
+#include <atomic>
+#include <functional>
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_mutex.h>
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    class SimulationApp;
+    
+    //! A class implementing a pool of worker threads used to run independent computations in parallel.
+    class ThreadPool
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param numThreads the total number of threads computing tasks, including the calling thread (<=1 means serial execution)
+         */
+        ThreadPool(unsigned int numThreads);
+        
+        //! A destructor.
+        ~ThreadPool();
+        
+        //! A method running a task for each index in range [0, n) and waiting for all of them to finish (workers use the application bound to the calling thread).
+        /*!
+         \param n the number of tasks
+         \param task a function called with the index of the task
+         */
+        void ParallelFor(unsigned int n, const std::function<void(unsigned int)>& task);
+        
+        //! A method returning the total number of threads computing tasks.
+        unsigned int getNumOfThreads() const;
+        
+    private:
+        void RunTasks();
+        static int WorkerLoop(void* data);
+        
+        std::vector<SDL_Thread*> workers;
+        SDL_mutex* poolMutex;
+        SDL_cond* startCond;
+        SDL_cond* doneCond;
+        const std::function<void(unsigned int)>* job;
+        SimulationApp* jobApp;
+        unsigned int jobSize;
+        std::atomic<unsigned int> nextTask;
+        unsigned int busyWorkers;
+        uint64_t generation;
+        bool quit;
+    };
+}
+
+#endif
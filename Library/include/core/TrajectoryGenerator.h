@@ -31,6 +31,8 @@
 
 namespace sf
 { 
+    class StateBuffer;
+    
     //! A structure representing single trajectory point.
     struct TrajectoryPoint
     {
@@ -60,6 +62,7 @@ namespace sf
         virtual Vector3 PointAtTime(Scalar t) const = 0;
         virtual Vector3 VelocityAtTime(Scalar t) const = 0;
         virtual void Sample(std::vector<glm::vec3>& plist) const = 0;
+        virtual TrajectorySegment* Copy() const = 0;
         Scalar getStartTime() const;
         Scalar getEndTime() const;
 
@@ -75,6 +78,7 @@ namespace sf
         Vector3 PointAtTime(Scalar t) const;
         Vector3 VelocityAtTime(Scalar t) const;
         void Sample(std::vector<glm::vec3>& plist) const;
+        TrajectorySegment* Copy() const;
     };
 
     //! A class representing a spline interpolated part of trajectory.
@@ -93,10 +97,13 @@ namespace sf
     {
     public:
         TrajectoryGenerator();
+        TrajectoryGenerator(const TrajectoryGenerator& other);
         ~TrajectoryGenerator();
         
         void AddSegment(TrajectorySegment* s);
         void Advance(Scalar dt);
+        void SaveState(StateBuffer& state);
+        void RestoreState(StateBuffer& state);
         std::vector<Renderable> Render();
 
         Vector3 getCurrentPoint() const;
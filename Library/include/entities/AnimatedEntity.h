@@ -78,6 +78,18 @@ namespace sf
          */
         void Update(Scalar dt);
 
+        //! A method saving the dynamic state of the entity.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void SaveState(StateBuffer& state);
+        
+        //! A method restoring the dynamic state of the entity.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void RestoreState(StateBuffer& state);
+        
         //! A method adding the body to the simulation manager.
         /*!
          \param sm a pointer to the simulation manager
@@ -130,6 +142,13 @@ namespace sf
          \param max a point located at the maximum coordinate corner
          */
         void getAABB(Vector3& min, Vector3& max);
+        
+        //! A method creating a copy of the entity in another simulation world.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        Entity* Clone(CloneContext& ctx);
       
         //void AddTrajectoryPoint(Vector3 p, Scalar twist);
 
@@ -49,6 +49,8 @@ namespace sf
     
     struct Renderable;
     class SimulationManager;
+    class StateBuffer;
+    class CloneContext;
     
     //! An abstract class representing a simulation entity.
     class Entity
@@ -94,6 +96,27 @@ namespace sf
          */
         virtual void getAABB(Vector3& min, Vector3& max) = 0;
         
+        //! A method saving the dynamic state of the entity.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(StateBuffer& state);
+        
+        //! A method restoring the dynamic state of the entity.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(StateBuffer& state);
+        
+        //! A method creating a copy of the entity in another simulation world.
+        /*!
+         The copy shares the immutable assets (meshes, collision shapes) with the entity and owns its dynamic state.
+         It is added to the dynamics world of the target simulation manager but not registered in it.
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy or NULL if the entity cannot be cloned
+         */
+        virtual Entity* Clone(CloneContext& ctx);
+        
     private:
         bool renderable;
         std::string name;
@@ -204,6 +204,18 @@ namespace sf
          */
         void UpdateAcceleration(Scalar dt);
         
+        //! A method saving the dynamic state of the multibody.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void SaveState(StateBuffer& state);
+        
+        //! A method restoring the dynamic state of the multibody.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void RestoreState(StateBuffer& state);
+        
         //! A method used to set the initial conditions for a joint.
         /*!
          \param index an id of the joint
@@ -381,6 +393,14 @@ namespace sf
         //! A method returning the type of the entity.
         EntityType getType() const;
         
+        //! A method creating a copy of the multibody in another simulation world.
+        /*!
+         The links share their collision shapes and meshes with the original, while the multibody, its colliders and constraints are rebuilt.
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy or NULL if one of the links cannot be copied
+         */
+        Entity* Clone(CloneContext& ctx);
+        
     private:
         btMultiBody* multiBody;
         std::vector<FeatherstoneLink> links;
@@ -31,6 +31,8 @@
 
 namespace sf
 {
+    class SolidEntity;
+    
     //! An enum specifying the type of forcefield.
     enum class ForcefieldType {POOL, OCEAN, TRIGGER, ATMOSPHERE};
     
@@ -66,6 +68,20 @@ namespace sf
         //! A method returning the pair caching object for the force field.
         btPairCachingGhostObject* getGhost();
         
+        //! A method collecting all dynamic solids overlapping with the force field.
+        /*!
+         \param world a pointer to the dynamics world
+         \param solids a reference to a vector that will be filled with pointers to the overlapping solids
+         */
+        void getOverlappingSolids(btDynamicsWorld* world, std::vector<SolidEntity*>& solids);
+        
+        //! A static method returning the dynamic solid owning a collision object.
+        /*!
+         \param co a pointer to the collision object
+         \return a pointer to the solid or NULL if the object is not a dynamic solid
+         */
+        static SolidEntity* getDynamicSolid(btCollisionObject* co);
+        
         //! A method returning the type of the force field.
         virtual ForcefieldType getForcefieldType() = 0;
         
@@ -73,6 +89,8 @@ namespace sf
         EntityType getType() const;
         
     protected:
+        virtual void InitCopy(CloneContext& ctx);
+        
         btPairCachingGhostObject* ghost;
     };
 }
@@ -0,0 +1,128 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  HydroMesh.h
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_HydroMesh__
+#define __Stonefish_HydroMesh__
+
+#include "StonefishCommon.h"
+#include "entities/forcefields/WaveHeightTile.h"
+
+namespace sf
+{
+    struct Mesh;
+    
+    //! A structure holding a copy of the physics mesh prepared for the computation of fluid dynamics.
+    /*!
+     Vertices are stored as a structure of arrays, converted to the simulation precision once. Each vertex is transformed
+     to the world frame once per recompute, into scratch buffers that are then read by the face loops, so shared vertices
+     are not transformed repeatedly. The scratch buffers make the mesh stateful, so it must not be used by two threads at once.
+     Clipping of faces against the fluid surface processes four faces per iteration when the library is built with AVX2
+     support (ENABLE_AVX2), producing results identical to the scalar implementation.
+     */
+    struct HydroMesh
+    {
+        std::vector<Scalar> x, y, z;        //!< Vertex positions in the mesh frame
+        std::vector<unsigned int> indices;  //!< Three vertex indices per face
+        
+        std::vector<Scalar> px, py, pz;     //!< Vertex positions in the world frame (scratch)
+        std::vector<Scalar> depth;          //!< Depth of each vertex below the fluid surface (scratch)
+        std::vector<Scalar> cx, cy, cz;     //!< Face centroids in the world frame (scratch)
+        std::vector<Scalar> nx, ny, nz;     //!< Unit face normals in the world frame (scratch)
+        std::vector<Scalar> area;           //!< Face areas, zero for degenerate faces (scratch)
+        std::vector<unsigned int> faceIds;  //!< Original indices of the compacted faces (scratch)
+        std::vector<Scalar> pressure;       //!< Fluid pressure at face centroids (scratch)
+        std::vector<Scalar> ux, uy, uz;     //!< Fluid velocity at face centroids (scratch)
+        WaveHeightTile waveTile;            //!< Wave surface sampled around the mesh (scratch)
+        
+        //! A constructor.
+        /*!
+         \param mesh a pointer to the mesh used as the source of geometry
+         */
+        HydroMesh(const Mesh* mesh);
+        
+        //! A method reducing the number of faces by collapsing edges, in the order of the quadric error.
+        /*!
+         The enclosed volume and its centroid are restored after the simplification (for closed meshes),
+         so that the buoyancy computed on the simplified mesh stays correct.
+         \param maxFaces the number of faces to reach (0 = no budget)
+         \param maxError the maximum allowed distance of the simplified surface from the original one, compared with the square root of the quadric error of each collapse [m] (0 = no limit)
+         */
+        void Decimate(unsigned int maxFaces, Scalar maxError);
+        
+        //! A method returning the number of vertices.
+        size_t getNumOfVertices() const { return x.size(); }
+        
+        //! A method returning the number of faces.
+        size_t getNumOfFaces() const { return indices.size()/3; }
+        
+        //! A method returning the world position of a vertex (after a call to TransformVertices).
+        Vector3 getVertex(unsigned int vertexID) const { return Vector3(px[vertexID], py[vertexID], pz[vertexID]); }
+        
+        //! A method transforming all vertices to the world frame.
+        /*!
+         \param T a transformation from the mesh frame to the world frame
+         */
+        void TransformVertices(const Transform& T);
+        
+        //! A method computing the centroid, normal and area of all faces, based on the transformed vertices.
+        void ComputeFaces();
+        
+        //! A method computing the centroid, normal and area of the submerged part of all faces.
+        /*!
+         Uses the transformed vertices and their depth. Faces above the fluid surface, or degenerate after clipping,
+         get zero area. The vectorised implementation is used if available.
+         */
+        void ClipFaces();
+        
+        //! A method clipping faces against the fluid surface, one face at a time.
+        void ClipFacesScalar();
+        
+        //! A method clipping faces against the fluid surface, four faces at a time (falls back to scalar code without AVX2).
+        void ClipFacesVectorised();
+        
+        //! A method returning the outline of the clipped part of a face, if the face crosses the fluid surface.
+        /*!
+         \param faceID the index of the face
+         \param points an array receiving the corners of the clipped polygon
+         \return number of corners (0 if the face is not crossing the surface)
+         */
+        unsigned int getClippedPolygon(size_t faceID, Vector3 points[4]) const;
+        
+        //! A method moving the data of faces with non-zero area to the beginning of the face buffers.
+        /*!
+         The order of faces is kept, so that the results of the summation of face contributions do not change.
+         \return the number of faces with non-zero area
+         */
+        size_t CompactFaces();
+        
+        //! A method resizing the scratch buffers to the size of the mesh.
+        void ResizeScratch();
+        
+        //! A static method informing if the vectorised clipping is compiled in.
+        static bool isVectorised();
+    };
+}
+
+#endif
@@ -49,6 +49,7 @@ namespace sf
     enum class BodyPhysicsType {SURFACE, FLOATING, SUBMERGED, AERODYNAMIC};
     
     struct HydrodynamicsSettings;
+    struct HydroMesh;
     class Ocean;
     class Atmosphere;
     
@@ -95,6 +96,32 @@ namespace sf
          */
         void UpdateAcceleration(Scalar dt);
         
+        //! A method saving the dynamic state of the body, including the cached fluid forces.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void SaveState(StateBuffer& state);
+        
+        //! A method restoring the dynamic state of the body.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void RestoreState(StateBuffer& state);
+        
+        //! A method creating a copy of the body and adding it to another simulation world.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy or NULL if the body cannot be cloned
+         */
+        Entity* Clone(CloneContext& ctx);
+        
+        //! A method creating a copy of the body, not added to any simulation world.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy or NULL if the body cannot be copied
+         */
+        virtual SolidEntity* Copy(CloneContext& ctx);
+        
         //! A method that computes fluid dynamics based on selected settings.
         /*!
          \param settings a structure holding settings of fluid dynamics computation
@@ -117,7 +144,7 @@ namespace sf
         //! A static method that computes fluid dynamics when a body is crossing the fluid surface.
         /*!
          \param settings a reference to a structure holding settings of the fluid dynamics computation
-         \param mesh a pointer to the body physics mesh data
+         \param mesh a pointer to the body hydrodynamics mesh data (its scratch buffers are modified)
          \param liquid a pointer to the fluid entity generating forces (currently only Ocean supported)
          \param T_CG a transform from the world frame to the body CG frame
          \param T_C a transform from the world frame to the physics frame
@@ -132,12 +159,12 @@ namespace sf
          \param _Fds output of the damping force resulting from skin friction
          \param _Tds output of the torque induced by skin friction
         */
-        static void ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings& settings, const Mesh* mesh, Ocean* liquid, const Transform& T_CG, const Transform& T_C,
+        static void ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings& settings, HydroMesh* mesh, Ocean* liquid, const Transform& T_CG, const Transform& T_C,
                                                      const Vector3& linearV, const Vector3& angularV, Vector3& _Fb, Vector3& _Tb, Vector3& _Fdl, Vector3& _Tdl, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fds, Vector3& _Tds, Renderable& debug);
         
         //! A static method that computes fluid dynamics when a body is completely submerged.
         /*!
-         \param mesh a pointer to the body physics mesh data
+         \param mesh a pointer to the body hydrodynamics mesh data (its scratch buffers are modified)
          \param liquid a pointer to the fluid entity generating forces
          \param T_CG a transform from the world frame to the body CG frame
          \param T_C a transform from the world frame to the body physics frame
@@ -150,7 +177,7 @@ namespace sf
          \param _Fds output of the damping force resulting from skin friction
          \param _Tds output of the torque induced by skin friction
         */
-        static void ComputeHydrodynamicForcesSubmerged(const Mesh* mesh, Ocean* liquid, const Transform& T_CG, const Transform& T_C,
+        static void ComputeHydrodynamicForcesSubmerged(HydroMesh* mesh, Ocean* liquid, const Transform& T_CG, const Transform& T_C,
                                                        const Vector3& linearV, const Vector3& angularV, Vector3& _Fdl, Vector3& _Tdl, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fds, Vector3& _Tds);
         
         //! A method that computes aerodynamics.
@@ -227,6 +254,15 @@ namespace sf
          */
         void SetContactProperties(bool soft, Scalar stiffness = Scalar(0), Scalar damping = Scalar(0));
         
+        //! A method used to simplify the copy of the physics mesh used for hydrodynamics.
+        /*!
+         The simplified mesh keeps the volume and its centroid, while the collision shape and the physical properties
+         are still based on the original physics mesh.
+         \param maxFaces the maximum number of faces of the simplified mesh (0 = no budget)
+         \param maxError the maximum allowed deviation of the simplified surface [m] (0 = no limit)
+         */
+        void SimplifyHydroMesh(unsigned int maxFaces, Scalar maxError = Scalar(0));
+        
         //! A method to set the body pose in the world frame.
         void setCGTransform(const Transform& trans);
         
@@ -317,6 +353,9 @@ namespace sf
         
         //! A method returning a pointer to the physics mesh.
         const Mesh* getPhysicsMesh();
+        
+        //! A method returning a pointer to the copy of the physics mesh used for hydrodynamics (built on first use).
+        HydroMesh* getHydroMesh();
 
         //! A method that returns a copy of all physics mesh vertices in body origin frame.
         virtual std::vector<Vector3>* getMeshVertices() const;
@@ -358,12 +397,16 @@ namespace sf
         Scalar LambKFactor(Scalar r1, Scalar r2);
         virtual void BuildRigidBody();
         void BuildMultibodyLinkCollider(btMultiBody* mb, unsigned int child, btMultiBodyDynamicsWorld* world);
+        btCompoundShape* BuildCGCollisionShape();
+        virtual void InitCopy(CloneContext& ctx);
         
         //Rigid body
         btRigidBody* rigidBody;
         btMultiBodyLinkCollider* multibodyCollider;
+        btCompoundShape* colShape; //Collision shape (shared between copies)
         
-        Mesh* phyMesh; //Mesh used for physics calculation
+        const Mesh* phyMesh; //Mesh used for physics calculation (shared between copies)
+        HydroMesh* hydroMesh; //Layout of the physics mesh optimised for hydrodynamics
         Scalar thick;
         Scalar volume;
         
@@ -414,6 +457,7 @@ namespace sf
         
     private:
         friend class FeatherstoneEntity;
+        friend class Joint;
         friend class FixedJoint;
         friend class RevoluteJoint;
         friend class PrismaticJoint;
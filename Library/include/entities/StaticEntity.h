@@ -84,7 +84,7 @@ namespace sf
         Transform getTransform();
         
         //! A method returning the material of the entity.
-        Material getMaterial() const;
+        const Material& getMaterial() const;
         
         //! A method returning the rigid body associated with the entity.
         btRigidBody* getRigidBody();
@@ -112,10 +112,11 @@ namespace sf
     protected:
         void BuildRigidBody(btCollisionShape* shape);
         virtual void BuildGraphicalObject();
+        virtual void InitCopy(CloneContext& ctx);
         
         btRigidBody* rigidBody;
         Material mat;
-        Mesh* phyMesh;
+        const Mesh* phyMesh; //Shared between copies
         
         int lookId;
         int phyObjectId;
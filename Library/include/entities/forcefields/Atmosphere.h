@@ -85,6 +85,12 @@ namespace sf
          */
         void ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool recompute);
         
+        //! A method computing the aerodynamic forces acting on a solid (thread safe for different solids).
+        /*!
+         \param solid a pointer to the solid
+         */
+        void ComputeFluidForces(SolidEntity* solid);
+        
         //! A method returning the position of the sun in the sky.
         /*!
          \param azimuthDeg a reference to the variable that will store the azimuth of the sun [deg]
@@ -115,6 +121,13 @@ namespace sf
         //! A method returning a pointer to the OpenGL atmosphere object.
         OpenGLAtmosphere* getOpenGLAtmosphere();
         
+        //! A method creating a copy of the atmosphere in another simulation world.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy or NULL if one of the wind fields cannot be copied
+         */
+        Entity* Clone(CloneContext& ctx);
+        
         //! A static method to compute Julian day form time.
         /*!
          \param tm a reference to a structure containing UTC time
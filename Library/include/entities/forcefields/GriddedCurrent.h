@@ -0,0 +1,103 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  GriddedCurrent.h
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+
+#ifndef __Stonefish_GriddedCurrent__
+#define __Stonefish_GriddedCurrent__
+
+#include <atomic>
+#include "entities/forcefields/VelocityField.h"
+
+namespace sf
+{
+    //! Gridded, time-varying velocity field class.
+    /*!
+     Class implements a velocity field sampled on a regular 3D grid, aligned with the world frame, at equally spaced time instants
+     (e.g. an ocean current hindcast). The velocity is interpolated trilinearly in space and linearly in time. Outside of the grid
+     the velocity is zero in the horizontal directions, while the vertical coordinate and the time are clamped to the grid.
+     The data file is memory-mapped, so that only the parts of the grid which are queried are loaded into memory.
+     
+     File layout (native byte order): "SFCG", uint32 version (1), uint32 nx, ny, nz, nt (number of samples along x, y, z
+     and time), float64 x0, y0, z0, t0 (first sample [m], [s]), float64 dx, dy, dz, dt (spacing [m], [s]), followed by nt time steps.
+     Each time step is divided into bricks of 8x8x8 samples, padded with zeros at the far ends of the grid. The bricks, as well as
+     the samples inside a brick, are ordered with x changing fastest and z slowest. Each sample consists of three float32
+     components of the velocity in the world frame [m/s].
+     */
+    class GriddedCurrent : public VelocityField
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param filename the path to the data file
+         */
+        GriddedCurrent(const std::string& filename);
+        
+        //! A destructor.
+        ~GriddedCurrent();
+        
+        //! A method returning velocity at a specified point.
+        /*!
+         \param p a point at which the velocity is requested
+         \return velocity [m/s]
+         */
+        Vector3 GetVelocityAtPoint(const Vector3& p);
+        
+        //! A method adding the velocity of the field at a set of points to the output arrays (batch version).
+        void AddVelocityAtPoints(const Scalar* x, const Scalar* y, const Scalar* z, size_t n, Scalar* vx, Scalar* vy, Scalar* vz);
+        
+        //! A method selecting the time steps used in the interpolation.
+        /*!
+         \param t the simulation time [s]
+         */
+        void Update(Scalar t);
+        
+        //! A method implementing the rendering of the gridded field (approximated with the velocity at the top of the grid centre).
+        std::vector<Renderable> Render(VelocityFieldUBO& ubo);
+        
+        //! A method creating a copy of the field.
+        VelocityField* Copy() const;
+        
+        //! A method informing if the data file was loaded successfully.
+        bool isValid() const;
+        
+    private:
+        GriddedCurrent(const GriddedCurrent& other);
+        const float* getSample(const float* step, unsigned int i, unsigned int j, unsigned int k) const;
+        
+        void* mapping;
+        size_t mappingSize;
+        const float* data;
+        unsigned int nx, ny, nz, nt;
+        unsigned int bricksX, bricksY;
+        size_t stepSize;
+        Vector3 origin;
+        Vector3 spacing;
+        Vector3 invSpacing;
+        Scalar t0, dt;
+        std::atomic<Scalar> tPosition; //Fractional index of the time step, read while rendering
+    };
+}
+
+#endif
@@ -26,9 +26,11 @@
 #ifndef __Stonefish_Ocean__
 #define __Stonefish_Ocean__
 
+#include <atomic>
 #include <SDL2/SDL_mutex.h>
 #include "core/MaterialManager.h"
 #include "entities/ForcefieldEntity.h"
+#include "entities/forcefields/WaveHeightTile.h"
 #include "graphics/OpenGLOcean.h"
 
 namespace sf
@@ -42,6 +44,8 @@ namespace sf
     
     class VelocityField;
     class Actuator;
+    class WaveSimulator;
+    class ThreadPool;
     
     //! A class implementing an ocean.
     class Ocean : public ForcefieldEntity
@@ -78,6 +82,12 @@ namespace sf
          */
         void ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool recompute);
         
+        //! A method computing the hydrodynamic forces acting on a solid (thread safe for different solids).
+        /*!
+         \param solid a pointer to the solid
+         */
+        void ComputeFluidForces(SolidEntity* solid);
+        
         //! A method returning the water velocity.
         /*!
          \param point the point in the ocean where the velocity should be measured [m]
@@ -85,6 +95,18 @@ namespace sf
          */
         Vector3 GetFluidVelocity(const Vector3& point) const;
         
+        //! A method returning the water velocity at a set of points.
+        /*!
+         \param x an array of x coordinates of the points [m]
+         \param y an array of y coordinates of the points [m]
+         \param z an array of z coordinates of the points [m]
+         \param n the number of points
+         \param vx an array receiving the x components of fluid velocity [m/s]
+         \param vy an array receiving the y components of fluid velocity [m/s]
+         \param vz an array receiving the z components of fluid velocity [m/s]
+         */
+        void GetFluidVelocity(const Scalar* x, const Scalar* y, const Scalar* z, size_t n, Scalar* vx, Scalar* vy, Scalar* vz) const;
+        
         //! A method checking if a point is inside fluid
         /*!
          \param point the position of a point to be checked [m]
@@ -99,6 +121,17 @@ namespace sf
          */
         Scalar GetPressure(const Vector3& point);
         
+        //! A method returning the hydrostatic pressure of the fluid at a set of points.
+        /*!
+         \param x an array of x coordinates of the points [m]
+         \param y an array of y coordinates of the points [m]
+         \param z an array of z coordinates of the points [m]
+         \param n the number of points
+         \param p an array receiving the hydrostatic pressure [Pa]
+         \param tile an optional pointer to a tile of wave heights covering the points
+         */
+        void GetPressure(const Scalar* x, const Scalar* y, const Scalar* z, size_t n, Scalar* p, const WaveHeightTile* tile = NULL);
+        
         //! A method returning the depth of the ocean at the specified point.
         /*!
          \param point the position of the measurement point [m]
@@ -106,18 +139,61 @@ namespace sf
          */
         Scalar GetDepth(const Vector3& point);
         
+        //! A method returning the depth of the ocean at a set of points.
+        /*!
+         \param x an array of x coordinates of the points [m]
+         \param y an array of y coordinates of the points [m]
+         \param z an array of z coordinates of the points [m]
+         \param n the number of points
+         \param d an array receiving the distance from the points to the surface of fluid [m]
+         \param tile an optional pointer to a tile of wave heights covering the points
+         */
+        void GetDepth(const Scalar* x, const Scalar* y, const Scalar* z, size_t n, Scalar* d, const WaveHeightTile* tile = NULL);
+        
+        //! A method resampling the wave surface over a rectangular region (thread safe for different tiles).
+        /*!
+         The spacing of samples is chosen to keep their number below the limit, but it never exceeds the resolution
+         of the waves. When it would, the tile is left empty and the queries go directly to the waves.
+         \param tile a reference to the tile to be updated
+         \param xMin the minimum x coordinate of the region [m]
+         \param yMin the minimum y coordinate of the region [m]
+         \param xMax the maximum x coordinate of the region [m]
+         \param yMax the maximum y coordinate of the region [m]
+         \param maxSamples the maximum number of samples in the tile
+         */
+        void UpdateWaveTile(WaveHeightTile& tile, Scalar xMin, Scalar yMin, Scalar xMax, Scalar yMax, size_t maxSamples);
+        
+        //! A method to enable capturing the points at which the depth was sampled, for debug rendering.
+        /*!
+         \param enabled a flag to enable the capture
+         \param maxPoints the maximum number of points captured between two renderings
+         */
+        void setWavesDebug(bool enabled, size_t maxPoints = 10000);
+        
+        //! A method informing if the points at which the depth was sampled are captured.
+        bool isWavesDebugEnabled() const;
+        
         //! A method to enable all defined currents.
         void EnableCurrents();
         
         //! A method to disable all defined currents.
         void DisableCurrents();
 
+        //! A method updating the time-varying currents.
+        /*!
+         \param t the simulation time [s]
+         */
+        void UpdateCurrents(Scalar t);
+        
         //! A method updating the currents data in the OpenGL ocean.
         void UpdateCurrentsData();
         
         //! A method returning the type of the water.
         Scalar getWaterType();
           
+        //! A method returning the age of the wave data used in the last hydrodynamics computation [s].
+        Scalar getWaveDataAge();
+        
         //! A method informing if the ocean waves are simulated.
         bool hasWaves() const;
         
@@ -131,10 +207,18 @@ namespace sf
         ForcefieldType getForcefieldType();
         
         //! A method initializing the rendering of the ocean.
+        void InitGraphics();
+        
+        //! A method initializing the computation of waves on the CPU, used when the ocean is not rendered.
+        void InitWaveSimulation();
+        
+        //! A method updating the waves used in the hydrodynamics computation.
         /*!
-         \param hydrodynamics a pointer to a mutex
+         The waves are either computed on the CPU or taken from the latest snapshot published by the rendering.
+         \param t the simulation time [s]
+         \param pool an optional pool of threads used to parallelize the computation
          */
-        void InitGraphics(SDL_mutex* hydrodynamics);
+        void SimulateWaves(Scalar t, ThreadPool* pool = NULL);
         
         //! A method implementing the rendering of the force field.
         std::vector<Renderable> Render();
@@ -142,16 +226,30 @@ namespace sf
         //! A method implementing the rendering of the ocean force field.
         std::vector<Renderable> Render(const std::vector<Actuator*>& act);
         
+        //! A method creating a copy of the ocean in another simulation world (the waves are simulated on the CPU).
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy or NULL if one of the currents cannot be copied
+         */
+        Entity* Clone(CloneContext& ctx);
+        
     private:
+        Ocean(const Ocean& other);
+        Scalar ComputeWaveHeight(Scalar x, Scalar y);
+        
         Fluid liquid;
         std::vector<VelocityField*> currents;
         OpenGLOcean* glOcean;
+        WaveSimulator* waveSim;
         OceanCurrentsUBO glOceanCurrentsUBOData;
         Scalar depth;
         Scalar waterType;
         Scalar oceanState;
         bool currentsEnabled;
         Renderable wavesDebug;
+        SDL_mutex* wavesDebugMutex;
+        std::atomic<bool> wavesDebugEnabled;
+        size_t wavesDebugMaxPoints;
     };
 }
 
@@ -57,9 +57,15 @@ namespace sf
          */
         Vector3 GetVelocityAtPoint(const Vector3& p);
         
+        //! A method adding the velocity of the field at a set of points to the output arrays (batch version).
+        void AddVelocityAtPoints(const Scalar* x, const Scalar* y, const Scalar* z, size_t n, Scalar* vx, Scalar* vy, Scalar* vz);
+        
         //! A method implementing the rendering of the pipe.
         std::vector<Renderable> Render(VelocityFieldUBO& ubo);
         
+        //! A method creating a copy of the field.
+        VelocityField* Copy() const;
+        
     private:
         Vector3 p1, n;
         Scalar r1, r2, l;
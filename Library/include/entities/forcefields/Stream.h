@@ -32,9 +32,11 @@ namespace sf
 {
     //! Stream (current) velocity field class.
     /*!
-     Class implements a velocity field in a shape of a tube along a Hermite spline, with variable diameter.
-     The flow velocity is specified at the centre of the beginning of the tube (tanget to spline).
-     The closer to the boundary the slower the flow (zero at boudary).
+     Class implements a velocity field in a shape of a tube along a polyline, with variable diameter.
+     The flow velocity is specified at the centre of the beginning of the tube (tangent to the polyline).
+     The closer to the boundary the slower the flow (zero at boudary), with the same profile as in the pipe.
+     The segments are organised in a bounding volume hierarchy, so that the cost of a query grows logarithmically
+     with the number of points of the stream line.
      */
     class Stream : public VelocityField
     {
@@ -44,7 +46,7 @@ namespace sf
          \param streamline the list of points of the stream line [m]
          \param radius the radius of the stream at each point of stream line [m]
          \param inputVelocity the velocity at the beginning of the stream [m/s]
-         \param exponent a factor
+         \param exponent a factor determining the velocity profile along the perimeter of the stream
          */
         Stream(const std::vector<Vector3>& streamline, const std::vector<Scalar>& radius, Scalar inputVelocity, Scalar exponent);
         
@@ -55,12 +57,37 @@ namespace sf
          */
         Vector3 GetVelocityAtPoint(const Vector3& p);
         
+        //! A method adding the velocity of the field at a set of points to the output arrays (batch version).
+        void AddVelocityAtPoints(const Scalar* x, const Scalar* y, const Scalar* z, size_t n, Scalar* vx, Scalar* vy, Scalar* vz);
+        
         //! A method implementing the rendering of the stream.
         std::vector<Renderable> Render(VelocityFieldUBO& ubo);
         
+        //! A method creating a copy of the field.
+        VelocityField* Copy() const;
+        
     private:
-        std::vector<Vector3> c;
-        std::vector<Scalar> r;
+        struct Segment
+        {
+            Vector3 a;      //Beginning of the segment
+            Vector3 n;      //Unit direction
+            Scalar l;       //Length
+            Scalar ra, rb;  //Radius at both ends
+        };
+        
+        struct Node
+        {
+            Vector3 aabbMin;
+            Vector3 aabbMax;
+            unsigned int first;  //First segment (leaf) or index of the second child (internal node)
+            unsigned int count;  //Number of segments (leaf) or zero (internal node)
+        };
+        
+        void BuildHierarchy(unsigned int first, unsigned int count);
+        bool ComputeVelocity(const Vector3& p, Vector3& v) const;
+        
+        std::vector<Segment> segments;
+        std::vector<Node> nodes;
         Scalar vin;
         Scalar gamma;
     };
@@ -87,6 +87,13 @@ namespace sf
         //! A method returning the force field type.
         ForcefieldType getForcefieldType();
         
+        //! A method creating a copy of the trigger in another simulation world.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        Entity* Clone(CloneContext& ctx);
+        
     private:
         bool active;
         std::vector<SolidEntity*> solids;
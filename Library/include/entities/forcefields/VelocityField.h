@@ -48,8 +48,32 @@ namespace sf
          */
         virtual Vector3 GetVelocityAtPoint(const Vector3& p) = 0;
         
+        //! A method adding the velocity of the field at a set of points to the output arrays.
+        /*!
+         \param x an array of x coordinates of the points
+         \param y an array of y coordinates of the points
+         \param z an array of z coordinates of the points
+         \param n the number of points
+         \param vx an array of x components of velocity (accumulated) [m/s]
+         \param vy an array of y components of velocity (accumulated) [m/s]
+         \param vz an array of z components of velocity (accumulated) [m/s]
+         */
+        virtual void AddVelocityAtPoints(const Scalar* x, const Scalar* y, const Scalar* z, size_t n, Scalar* vx, Scalar* vy, Scalar* vz);
+        
+        //! A method updating the time-varying velocity field.
+        /*!
+         \param t the simulation time [s]
+         */
+        virtual void Update(Scalar t);
+        
         //! A method implementing the rendering of the velocity field.
         virtual std::vector<Renderable> Render(VelocityFieldUBO& ubo) = 0;
+        
+        //! A method creating a copy of the velocity field (used when cloning a simulation world).
+        /*!
+         \return a pointer to the copy or NULL if the field cannot be copied
+         */
+        virtual VelocityField* Copy() const;
     };
 }
 
@@ -0,0 +1,53 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  WaveHeightTile.h
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+
+#ifndef __Stonefish_WaveHeightTile__
+#define __Stonefish_WaveHeightTile__
+
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    //! A structure holding the position of the wave surface sampled on a regular grid around a region of interest.
+    /*!
+     The tile is resampled by the ocean once per recompute of the hydrodynamics, so that the surface queries made
+     for a body are answered with a single bilinear interpolation. Points outside of the tile are queried directly.
+     */
+    struct WaveHeightTile
+    {
+        Scalar x0;                   //!< X coordinate of the first sample [m]
+        Scalar y0;                   //!< Y coordinate of the first sample [m]
+        Scalar invSpacing;           //!< Inverse of the distance between samples [1/m]
+        unsigned int nx;             //!< Number of samples along the X axis (0 when the tile is not used)
+        unsigned int ny;             //!< Number of samples along the Y axis (0 when the tile is not used)
+        std::vector<Scalar> height;  //!< Z coordinate of the surface at the samples, row by row [m]
+        
+        //! A constructor of an empty tile.
+        WaveHeightTile() : x0(0), y0(0), invSpacing(0), nx(0), ny(0) {}
+    };
+}
+
+#endif
@@ -0,0 +1,121 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  WaveSimulator.h
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+
+#ifndef __Stonefish_WaveSimulator__
+#define __Stonefish_WaveSimulator__
+
+#include "StonefishCommon.h"
+#include "graphics/OpenGLOcean.h"
+
+namespace sf
+{
+    class ThreadPool;
+    
+    //! A class implementing the simulation of ocean waves on the CPU.
+    /*!
+     The waves are generated with the same spectrum and seed, and evolved with the same FFT pipeline, as in the OpenGL ocean,
+     so that the hydrodynamics can be computed without rendering. Only the two largest grids are synthesized,
+     because the smaller ones are not used in the computation of the wave height. When the time advances by a constant
+     step, the phases of the waves are rotated by a precomputed step, instead of evaluating the trigonometric functions.
+     */
+    class WaveSimulator
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param state the state of the ocean (0-2)
+         \param seed the seed of the random phases of the waves
+         */
+        WaveSimulator(Scalar state, long seed = 1234);
+        
+        //! A destructor.
+        ~WaveSimulator();
+        
+        //! A method computing the wave heights at a specified time.
+        /*!
+         \param t the time [s]
+         \param pool an optional pool of threads used to parallelize the computation
+         */
+        void Update(Scalar t, ThreadPool* pool = NULL);
+        
+        //! A method computing the position of the wave surface at a specified point.
+        /*!
+         \param x the x coordinate of the point [m]
+         \param y the y coordinate of the point [m]
+         \return the z coordinate of the wave surface [m]
+         */
+        Scalar ComputeWaveHeight(Scalar x, Scalar y) const;
+        
+        //! A method returning the parameters of the waves.
+        const OceanParams& getParams() const;
+        
+        //! A static method generating the spectrum of the waves for the four grids.
+        /*!
+         \param params the parameters of the waves, receiving the spectrum
+         \param seed the seed of the random phases of the waves
+         */
+        static void GenerateSpectrum(OceanParams& params, long seed);
+        
+        //! A static method evaluating the spectrum of the waves.
+        /*!
+         \param params the parameters of the waves
+         \param kx the x component of the wave vector [1/m]
+         \param ky the y component of the wave vector [1/m]
+         \param omnispectrum a flag indicating if the omnidirectional spectrum should be returned
+         \return the value of the spectrum
+         */
+        static float Spectrum(const OceanParams& params, float kx, float ky, bool omnispectrum = false);
+        
+    private:
+        void InitializeSpectrum(long seed);
+        void ComputeRows(unsigned int r0, unsigned int r1, bool advance, bool newStep);
+        void ComputeColumns(unsigned int c0, unsigned int c1);
+        float ComputeInterpolatedWaveData(float x, float y, const std::vector<float>& data) const;
+        static float omega(const OceanParams& params, float k);
+        static void GetSpectrumSample(const OceanParams& params, int i, int j, float lengthScale, float kMin, long* seed, float* result);
+        
+        OceanParams params;
+        std::vector<unsigned int> bitReversed;
+        std::vector<float> twiddleRe;
+        std::vector<float> twiddleIm;
+        std::vector<float> frequency[2];
+        std::vector<float> ampP[2];
+        std::vector<float> ampQ[2];
+        std::vector<float> ampR[2];
+        std::vector<float> ampS[2];
+        std::vector<float> phaseRe[2];
+        std::vector<float> phaseIm[2];
+        std::vector<float> stepRe[2];
+        std::vector<float> stepIm[2];
+        Scalar phaseTime;
+        Scalar phaseDt;
+        unsigned int phaseSteps;
+        std::vector<float> heightRe;
+        std::vector<float> heightIm;
+    };
+}
+
+#endif
@@ -54,6 +54,13 @@ namespace sf
         //! A method that returns the collision shape for the box.
         btCollisionShape* BuildCollisionShape();
         
+        //! A method creating a copy of the box, not added to any simulation world.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        SolidEntity* Copy(CloneContext& ctx);
+        
     private:
         Vector3 halfExtents;
     };
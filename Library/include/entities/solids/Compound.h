@@ -94,7 +94,7 @@ namespace sf
         Vector3 getAugmentedInertia() const;
         
         //! A method returning the material of the body.
-        Material getMaterial(size_t partId) const;
+        const Material& getMaterial(size_t partId) const;
         
         //! A method returning the part id for the collision shape id
         size_t getPartId(size_t collisionShapeId) const;
@@ -111,12 +111,22 @@ namespace sf
         //! A method that constructs a collision shape for the body.
         btCollisionShape* BuildCollisionShape();
         
+        //! A method creating a copy of the compound body, not added to any simulation world.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        SolidEntity* Copy(CloneContext& ctx);
+        
         //! A method that builds a graphical object for the body.
         void BuildGraphicalObject();
         
         //! A method that returns elements that have to be rendered for the body.
         std::vector<Renderable> Render();
         
+    protected:
+        void InitCopy(CloneContext& ctx);
+        
     private:
         std::vector<CompoundPart> parts; //Parts of the compound solid
         std::vector<size_t> collisionPartId;
@@ -82,11 +82,21 @@ namespace sf
         //! A method that returns the collision shape.
         btCollisionShape* BuildCollisionShape();
         
+        //! A method creating a copy of the polyhedron, not added to any simulation world.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        SolidEntity* Copy(CloneContext& ctx);
+        
         //! A method used to build the graphical representation of the body.
         void BuildGraphicalObject();
         
+    protected:
+        void InitCopy(CloneContext& ctx);
+        
     private:
-        Mesh *graMesh; //Mesh used for rendering
+        const Mesh* graMesh; //Mesh used for rendering (shared between copies)
     };
 }
 
@@ -55,6 +55,13 @@ namespace sf
         //! A method that returns the collision shape for the torus.
         btCollisionShape* BuildCollisionShape();
         
+        //! A method creating a copy of the torus, not added to any simulation world.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        SolidEntity* Copy(CloneContext& ctx);
+        
     private:
         Scalar mR;
         Scalar MR;
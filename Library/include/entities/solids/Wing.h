@@ -77,6 +77,13 @@ namespace sf
         //! A method that returns the collision shape for the wing (tapered box).
         btCollisionShape* BuildCollisionShape();
         
+        //! A method creating a copy of the wing, not added to any simulation world.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        SolidEntity* Copy(CloneContext& ctx);
+        
     private:
         
     };
@@ -100,9 +100,19 @@ namespace sf
         //! A method that returns the static body type.
         StaticEntityType getStaticType();
         
+        //! A method creating a copy of the obstacle in another simulation world.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        Entity* Clone(CloneContext& ctx);
+        
+    protected:
+        void InitCopy(CloneContext& ctx);
+        
     private:
         void BuildGraphicalObject();
-        Mesh* graMesh;
+        const Mesh* graMesh; //Shared between copies
         int graObjectId;
     };
 }
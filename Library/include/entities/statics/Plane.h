@@ -53,6 +53,13 @@ namespace sf
         
         //! A method returning the type of the static entity.
         StaticEntityType getStaticType();
+        
+        //! A method creating a copy of the plane in another simulation world.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        Entity* Clone(CloneContext& ctx);
     };
 }
 
@@ -67,6 +67,16 @@ namespace sf
         //! A method returning the type of static entity.
         StaticEntityType getStaticType();
         
+        //! A method creating a copy of the terrain in another simulation world.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        Entity* Clone(CloneContext& ctx);
+        
+    protected:
+        void InitCopy(CloneContext& ctx);
+        
     private:
         Scalar* terrainHeight;
         Scalar maxHeight;
@@ -246,7 +246,7 @@ namespace sf
          \param mesh a pointer to the mesh structure
          \return an id of the built object
          */
-        unsigned int BuildObject(Mesh* mesh);
+        unsigned int BuildObject(const Mesh* mesh);
         
         //! A method to create a new simple look.
         /*!
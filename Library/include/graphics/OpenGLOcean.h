@@ -162,6 +162,12 @@ namespace sf
          \return wave height [m]
          */
         virtual GLfloat ComputeWaveHeight(GLfloat x, GLfloat y);
+        
+        //! A method taking the latest wave data published by the rendering, for the hydrodynamics computation.
+        virtual void AcquireWaveData();
+        
+        //! A method returning the age of the wave data used in the hydrodynamics computation [s].
+        virtual GLfloat getWaveDataAge();
 
         //! A method returning the id of the wave texture.
         GLuint getWaveTexture();
@@ -201,9 +207,6 @@ namespace sf
         float ComputeSlopeVariance();
         float GetSlopeVariance(float kx, float ky, float *spectrumSample);
         void GenerateWavesSpectrum();
-        void GetSpectrumSample(int i, int j, float lengthScale, float kMin, float *result);
-        float spectrum(float kx, float ky, bool omnispectrum = false);
-        float omega(float k);
 
         int oceanBoxObj;
     };
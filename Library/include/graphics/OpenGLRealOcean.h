@@ -27,7 +27,7 @@
 #define __Stonefish_OpenGLRealOcean__
 
 #include "graphics/OpenGLOcean.h"
-#include <SDL2/SDL_mutex.h>
+#include <atomic>
 
 namespace sf
 {
@@ -40,6 +40,14 @@ namespace sf
         GLuint patchDI;
         GLint pingpong;
     };
+    
+    //! A structure holding a snapshot of the wave data copied from the GPU.
+    struct WaveSnapshot
+    {
+        GLfloat* data;      //!< The first layer of the FFT result (4 values per texel)
+        GLfloat t;          //!< Time of the waves [s]
+        int64_t timestamp;  //!< Wall clock time when the waves were computed [us], negative if not available
+    };
 
     //! A class implementing reallistic deformed ocean in OpenGL.
     class OpenGLRealOcean : public OpenGLOcean
@@ -49,14 +57,13 @@ namespace sf
         /*!
          \param size the size of the ocean surface mesh [m]
          \param state the state of the ocean, if >0 the ocean is rendered with geometric waves otherwise as a plane with wave texture
-         \param hydrodynamics a pointer to a mutex
          */
-        OpenGLRealOcean(GLfloat size, GLfloat state, SDL_mutex* hydrodynamics);
+        OpenGLRealOcean(GLfloat size, GLfloat state);
         
         //! A destructor.
         ~OpenGLRealOcean();
 
-        //! A method that simulates wave propagation.
+        //! A method that simulates wave propagation and publishes the wave data computed in the previous frame.
 		/*!
 		 \param dt time since last update
 		 */
@@ -93,6 +100,12 @@ namespace sf
          \return wave height [m]
          */
         GLfloat ComputeWaveHeight(GLfloat x, GLfloat y);
+        
+        //! A method taking the latest published wave snapshot, without waiting for the rendering (called by the physics thread).
+        void AcquireWaveData();
+        
+        //! A method returning the age of the acquired wave snapshot at the moment it was taken [s], negative if no snapshot was published yet.
+        GLfloat getWaveDataAge();
 
         //! A method do enable wireframe rendering.
         /*!
@@ -108,8 +121,13 @@ namespace sf
         GLuint oceanBuffers[2];
         GLuint fftPBO;
         std::map<OpenGLCamera*, OceanQT> oceanTrees; 
-        SDL_mutex* hydroMutex;
-        GLfloat* fftData;
+        WaveSnapshot waveSnapshots[3];
+        std::atomic<unsigned int> waveReady; //Index of the latest published snapshot, with a flag set until it is acquired
+        unsigned int waveWrite; //Snapshot written by the rendering
+        unsigned int waveRead; //Snapshot read by the hydrodynamics
+        GLfloat waveDataAge;
+        GLfloat pboTime;
+        int64_t pboTimestamp;
         GLint qtGridTessFactor;
         GLint qtGPUTessFactor;
         GLint qtPatchIndexCount;
@@ -41,6 +41,7 @@ namespace sf
     
     struct Renderable;
     class SimulationManager;
+    class CloneContext;
     
     //! An abstract class implementing a general joint.
     class Joint
@@ -94,9 +95,18 @@ namespace sf
         //! A method that informs if the joint is of multibody type.
         bool isMultibodyJoint();
         
+        //! A method creating a copy of the joint, connecting the copies of the joined bodies.
+        /*!
+         The copy is not added to any simulation world. Multibody joints cannot be cloned.
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy or NULL if the joint cannot be cloned
+         */
+        virtual Joint* Clone(CloneContext& ctx);
+        
     protected:
         void setConstraint(btTypedConstraint* c);
         void setConstraint(btMultiBodyConstraint* c);
+        bool InitCopy(CloneContext& ctx);
         
     private:
         std::string name;
@@ -74,6 +74,13 @@ namespace sf
         //! A method returning the type of the joint.
         JointType getType();
         
+        //! A method creating a copy of the joint, connecting the copies of the joined bodies.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy or NULL if the joint cannot be cloned
+         */
+        Joint* Clone(CloneContext& ctx);
+        
     private:
         Vector3 sigDamping;
         Vector3 velDamping;
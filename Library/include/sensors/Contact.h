@@ -65,6 +65,7 @@ namespace sf
     
     struct Renderable;
     class Entity;
+    class CloneContext;
     
     //! A class implementing a sensor measuring the contact between two entities.
     class Contact
@@ -133,6 +134,13 @@ namespace sf
         //! A method returning the history of the contact.
         const std::deque<ContactPoint>& getHistory();
         
+        //! A method creating a copy of the contact sensor, observing the copies of the entities.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        Contact* Clone(CloneContext& ctx);
+        
     private:
         std::string name;
         Entity* A;
@@ -111,6 +111,18 @@ namespace sf
         //! A method resetting the sensor.
         virtual void Reset();
         
+        //! A method saving the internal state of the sensor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(StateBuffer& state);
+        
+        //! A method restoring the internal state of the sensor and dropping the measurements newer than the restored simulation time.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(StateBuffer& state);
+        
         //! A method clearing the history of measurements.
         void ClearHistory();
         
@@ -165,6 +177,7 @@ namespace sf
         virtual ScalarSensorType getScalarSensorType() = 0;
         
     protected:
+        virtual void InitCopy(CloneContext& ctx);
         void AddSampleToHistory(const Sample& s);
         std::deque<Sample*> history;
         std::vector<SensorChannel> channels;
@@ -36,6 +36,9 @@ namespace sf
     enum class SensorType {JOINT, LINK, VISION, OTHER};
     
     struct Renderable;
+    class StateBuffer;
+    class CloneContext;
+    class SimulationManager;
     
     //! An abstract class representing a sensor.
     class Sensor
@@ -57,12 +60,18 @@ namespace sf
         //! A method implementing the rendering of the sensor.
         virtual std::vector<Renderable> Render();
         
-        //! A method that updates the sensor readings.
+        //! A method that updates the sensor readings, limiting the rate with an internal timer (used outside of the scheduler).
         /*!
          \param dt a time step of the simulation [s]
          */
         void Update(Scalar dt);
         
+        //! A method that updates the sensor readings immediately, used by the scheduler when the sensor is due.
+        /*!
+         \param dt the time elapsed since the last update [s]
+         */
+        void TriggerUpdate(Scalar dt);
+        
         //! A method used to mark data as old.
         void MarkDataOld();
         
@@ -78,6 +87,12 @@ namespace sf
         //! A method returning the sampling rate of the sensor.
         Scalar getUpdateFrequency();
         
+        //! A method to seed the noise generator of the sensor, overriding the seed derived from the simulation seed.
+        /*!
+         \param seed the seed of the random number generator
+         */
+        void setRandomSeed(unsigned int seed);
+        
         //! A method informing if the sensor is renderable.
         bool isRenderable();
         
@@ -96,15 +111,37 @@ namespace sf
         //! A method returning the type of the sensor.
         virtual SensorType getType() = 0;
         
+        //! A method saving the internal state of the sensor (noise generator and new data flag, the deadlines are saved by the scheduler).
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(StateBuffer& state);
+        
+        //! A method restoring the internal state of the sensor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(StateBuffer& state);
+        
+        //! A method creating a copy of the sensor, attached to the copies of the measured objects.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy or NULL if the sensor cannot be cloned
+         */
+        virtual Sensor* Clone(CloneContext& ctx);
+        
     protected:
+        virtual void InitCopy(CloneContext& ctx);
+        
+
         Scalar freq;
         SDL_mutex* updateMutex;
         
-        static std::random_device randomDevice;
-        static std::mt19937 randomGenerator;
+        std::mt19937 randomGenerator;
         
     private:
         std::string name;
+        SimulationManager* sm; //Owning simulation
         Scalar eleapsedTime;
         bool renderable;
         bool newDataAvailable;
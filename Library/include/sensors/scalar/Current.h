@@ -62,6 +62,16 @@ namespace sf
         //! A method returning the type of the scalar sensor.
         ScalarSensorType getScalarSensorType();
         
+        //! A method creating a copy of the sensor, attached to the copies of the measured objects.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        Sensor* Clone(CloneContext& ctx);
+        
+    protected:
+        void InitCopy(CloneContext& ctx);
+        
     private:
         DCMotor* motor;
     };
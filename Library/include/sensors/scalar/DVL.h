@@ -70,6 +70,13 @@ namespace sf
         //! A method returning the type of the scalar sensor.
         ScalarSensorType getScalarSensorType();
         
+        //! A method creating a copy of the sensor, attached to the copies of the measured objects.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        Sensor* Clone(CloneContext& ctx);
+        
     private:
         Scalar beamAngle;
         Scalar range[4];
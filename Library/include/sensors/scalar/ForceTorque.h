@@ -84,6 +84,28 @@ namespace sf
         //! A method returning the type of the scalar sensor.
         ScalarSensorType getScalarSensorType();
         
+        //! A method creating a copy of the sensor, attached to the copies of the measured objects.
+        /*!
+         \param ctx a reference to the cloning context
+         \return a pointer to the copy
+         */
+        Sensor* Clone(CloneContext& ctx);
+        
+        //! A method saving the internal state of the sensor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void SaveState(StateBuffer& state);
+        
+        //! A method restoring the internal state of the sensor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void RestoreState(StateBuffer& state);
+        
+    protected:
+        void InitCopy(CloneContext& ctx);
+        
     private:
         SolidEntity* attach;
         Transform o2s;
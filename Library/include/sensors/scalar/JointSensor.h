@@ -74,6 +74,8 @@ namespace sf
         std::string getJointName();
         
     protected:
+        virtual void InitCopy(CloneContext& ctx);
+        
         FeatherstoneEntity* fe;
         unsigned int jId;
         Joint* j;
@@ -74,6 +74,8 @@ namespace sf
         std::string getLinkName();
         
     protected:
+        virtual void InitCopy(CloneContext& ctx);
+        
         MovingEntity* attach;
         Transform o2s;
     };
@@ -27,6 +27,7 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/Console.h"
 #include "graphics/OpenGLContent.h"
 
 namespace sf
@@ -60,4 +61,18 @@ std::vector<Renderable> Actuator::Render()
     return items;
 }
 
+void Actuator::SaveState(StateBuffer& state)
+{
+}
+
+void Actuator::RestoreState(StateBuffer& state)
+{
+}
+
+Actuator* Actuator::Clone(CloneContext& ctx)
+{
+    cError("Actuator '%s' cannot be cloned!", name.c_str());
+    return NULL;
+}
+
 }
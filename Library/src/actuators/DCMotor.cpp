@@ -25,6 +25,9 @@
 
 #include "actuators/DCMotor.h"
 
+#include "core/StateBuffer.h"
+#include "core/CloneContext.h"
+
 namespace sf
 {
 
@@ -131,4 +134,28 @@ void DCMotor::SetupGearbox(bool enable, Scalar ratio, Scalar efficiency)
     gearEff = efficiency > 0.0 ? (efficiency <= 1.0 ? efficiency : 1.0) : 1.0;
 }
 
+void DCMotor::SaveState(StateBuffer& state)
+{
+    Motor::SaveState(state);
+    state.Write(V);
+    state.Write(I);
+    state.Write(lastVoverL);
+}
+
+void DCMotor::RestoreState(StateBuffer& state)
+{
+    Motor::RestoreState(state);
+    state.Read(V);
+    state.Read(I);
+    state.Read(lastVoverL);
+}
+
+Actuator* DCMotor::Clone(CloneContext& ctx)
+{
+    DCMotor* copy = new DCMotor(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
\ No newline at end of file
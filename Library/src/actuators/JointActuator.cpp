@@ -27,6 +27,7 @@
 
 #include "entities/FeatherstoneEntity.h"
 #include "joints/Joint.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -63,4 +64,10 @@ void JointActuator::AttachToJoint(Joint* joint)
         j = joint;
 }
     
+void JointActuator::InitCopy(CloneContext& ctx)
+{
+    ctx.Remap(fe);
+    ctx.Remap(j);
+}
+
 }
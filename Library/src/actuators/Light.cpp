@@ -33,6 +33,7 @@
 #include "graphics/OpenGLContent.h"
 #include "entities/SolidEntity.h"
 #include "entities/StaticEntity.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -110,6 +111,9 @@ void Light::Update(Scalar dt)
 
 void Light::UpdateTransform()
 {
+    if(glLight == NULL)
+        return;
+    
     Transform lightTransform = getActuatorFrame();
     Vector3 pos = lightTransform.getOrigin();
     glm::vec3 glPos((GLfloat)pos.x(), (GLfloat)pos.y(), (GLfloat)pos.z());
@@ -175,4 +179,19 @@ std::vector<Renderable> Light::Render()
     return items;
 }
 
+Actuator* Light::Clone(CloneContext& ctx)
+{
+    Light* copy = new Light(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
+void Light::InitCopy(CloneContext& ctx)
+{
+    LinkActuator::InitCopy(ctx);
+    ctx.Remap(attach2);
+    glLight = NULL; //Copies are not rendered
+}
+
 }
@@ -27,6 +27,7 @@
 
 #include "entities/SolidEntity.h"
 #include "entities/FeatherstoneEntity.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -66,4 +67,9 @@ std::vector<Renderable> LinkActuator::Render()
     return items;
 }
     
+void LinkActuator::InitCopy(CloneContext& ctx)
+{
+    ctx.Remap(attach);
+}
+
 }
@@ -27,6 +27,8 @@
 
 #include "joints/RevoluteJoint.h"
 #include "entities/FeatherstoneEntity.h"
+#include "core/StateBuffer.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -101,4 +103,24 @@ void Motor::Update(Scalar dt)
         fe->DriveJoint(jId, torque);
 }
 
+void Motor::SaveState(StateBuffer& state)
+{
+    JointActuator::SaveState(state);
+    state.Write(torque);
+}
+
+void Motor::RestoreState(StateBuffer& state)
+{
+    JointActuator::RestoreState(state);
+    state.Read(torque);
+}
+
+Actuator* Motor::Clone(CloneContext& ctx)
+{
+    Motor* copy = new Motor(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
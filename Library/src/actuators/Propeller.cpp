@@ -30,6 +30,8 @@
 #include "graphics/GLSLShader.h"
 #include "graphics/OpenGLContent.h"
 #include "entities/SolidEntity.h"
+#include "core/StateBuffer.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -174,4 +176,41 @@ std::vector<Renderable> Propeller::Render()
     return items;
 }
     
+void Propeller::SaveState(StateBuffer& state)
+{
+    LinkActuator::SaveState(state);
+    state.Write(theta);
+    state.Write(omega);
+    state.Write(thrust);
+    state.Write(torque);
+    state.Write(setpoint);
+    state.Write(iError);
+}
+
+void Propeller::RestoreState(StateBuffer& state)
+{
+    LinkActuator::RestoreState(state);
+    state.Read(theta);
+    state.Read(omega);
+    state.Read(thrust);
+    state.Read(torque);
+    state.Read(setpoint);
+    state.Read(iError);
+}
+
+Actuator* Propeller::Clone(CloneContext& ctx)
+{
+    Propeller* copy = new Propeller(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
+void Propeller::InitCopy(CloneContext& ctx)
+{
+    LinkActuator::InitCopy(ctx);
+    if(prop != NULL)
+        prop = prop->Copy(ctx);
+}
+
 }
@@ -28,6 +28,8 @@
 #include "entities/FeatherstoneEntity.h"
 #include "joints/Joint.h"
 #include "joints/RevoluteJoint.h"
+#include "core/StateBuffer.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -217,4 +219,30 @@ void Servo::Update(Scalar dt)
     }
 }
 
+void Servo::SaveState(StateBuffer& state)
+{
+    JointActuator::SaveState(state);
+    state.Write((uint32_t)mode);
+    state.Write(pSetpoint);
+    state.Write(vSetpoint);
+}
+
+void Servo::RestoreState(StateBuffer& state)
+{
+    JointActuator::RestoreState(state);
+    uint32_t m;
+    state.Read(m);
+    mode = (ServoControlMode)m;
+    state.Read(pSetpoint);
+    state.Read(vSetpoint);
+}
+
+Actuator* Servo::Clone(CloneContext& ctx)
+{
+    Servo* copy = new Servo(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
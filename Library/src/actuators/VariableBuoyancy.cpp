@@ -28,7 +28,9 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "core/Console.h"
+#include "core/StateBuffer.h"
 #include <algorithm>
+#include "core/CloneContext.h"
 
 namespace sf 
 {
@@ -156,4 +158,26 @@ std::vector<Renderable> VariableBuoyancy::Render()
 }
     
     
+void VariableBuoyancy::SaveState(StateBuffer& state)
+{
+    LinkActuator::SaveState(state);
+    state.Write(V);
+    state.Write(CG);
+}
+
+void VariableBuoyancy::RestoreState(StateBuffer& state)
+{
+    LinkActuator::RestoreState(state);
+    state.Read(V);
+    state.Read(CG);
+}
+
+Actuator* VariableBuoyancy::Clone(CloneContext& ctx)
+{
+    VariableBuoyancy* copy = new VariableBuoyancy(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
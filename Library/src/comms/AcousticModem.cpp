@@ -30,12 +30,15 @@
 #include "core/SimulationManager.h"
 #include "graphics/OpenGLPipeline.h"
 #include "core/Console.h"
+#include "core/CloneContext.h"
+#include "core/StateBuffer.h"
 
 namespace sf
 {
  
 //Static
-std::map<uint64_t, AcousticModem*> AcousticModem::nodes; 
+std::map<SimulationManager*, std::map<uint64_t, AcousticModem*>> AcousticModem::nodes; 
+SDL_mutex* AcousticModem::nodesMutex = SDL_CreateMutex();
 
 void AcousticModem::addNode(AcousticModem* node)
 {
@@ -44,21 +47,29 @@ void AcousticModem::addNode(AcousticModem* node)
         cError("Modem device ID=0 not allowed!");
         return;
     }
-        
-    if(nodes.find(node->getDeviceId()) != nodes.end())
+    
+    SDL_LockMutex(nodesMutex);
+    std::map<uint64_t, AcousticModem*>& network = nodes[sm];
+    if(network.find(node->getDeviceId()) != network.end())
         cError("Modem node with ID=%d already exists!", node->getDeviceId());
     else
-        nodes[node->getDeviceId()] = node;
+        network[node->getDeviceId()] = node;
+    SDL_UnlockMutex(nodesMutex);
 }
 
 void AcousticModem::removeNode(uint64_t deviceId)
 {
     if(deviceId == 0)
         return;
-        
-    std::map<uint64_t, AcousticModem*>::iterator it = nodes.find(deviceId);
-    if(it != nodes.end())
-        nodes.erase(it);
+    
+    SDL_LockMutex(nodesMutex);
+    std::map<uint64_t, AcousticModem*>& network = nodes[sm];
+    std::map<uint64_t, AcousticModem*>::iterator it = network.find(deviceId);
+    if(it != network.end() && it->second == this)
+        network.erase(it);
+    if(network.empty())
+        nodes.erase(sm);
+    SDL_UnlockMutex(nodesMutex);
 }
 
 AcousticModem* AcousticModem::getNode(uint64_t deviceId)
@@ -66,14 +77,14 @@ AcousticModem* AcousticModem::getNode(uint64_t deviceId)
     if(deviceId == 0)
         return NULL;
     
-    try
-    {
-        return nodes.at(deviceId);
-    }
-    catch(const std::out_of_range& oor)
-    {
-        return NULL;
-    }
+    AcousticModem* node = NULL;
+    SDL_LockMutex(nodesMutex);
+    std::map<uint64_t, AcousticModem*>& network = nodes[sm];
+    std::map<uint64_t, AcousticModem*>::iterator it = network.find(deviceId);
+    if(it != network.end())
+        node = it->second;
+    SDL_UnlockMutex(nodesMutex);
+    return node;
 }   
 
 bool AcousticModem::mutualContact(uint64_t device1Id, uint64_t device2Id)
@@ -105,6 +116,7 @@ AcousticModem::AcousticModem(std::string uniqueName, uint64_t deviceId,
     range = operatingRange <= Scalar(0) ? Scalar(1000) : operatingRange;
     position = V0();
     frame = std::string("");
+    sm = SimulationApp::getApp()->getSimulationManager();
     addNode(this);
 }
 
@@ -250,4 +262,74 @@ std::vector<Renderable> AcousticModem::Render()
     return items;
 }
 
+Comm* AcousticModem::Clone(CloneContext& ctx)
+{
+    AcousticModem* copy = new AcousticModem(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
+void AcousticModem::InitCopy(CloneContext& ctx)
+{
+    Comm::InitCopy(ctx);
+    propagating.clear();
+    sm = ctx.getSimulationManager();
+    addNode(this);
+}
+
+void AcousticModem::SaveState(StateBuffer& state)
+{
+    SDL_LockMutex(updateMutex);
+    Comm::SaveState(state);
+    state.Write(position);
+    state.Write(frame);
+    state.Write((uint32_t)propagating.size());
+    std::map<AcousticDataFrame*, Vector3>::iterator mIt;
+    for(mIt = propagating.begin(); mIt != propagating.end(); ++mIt)
+    {
+        SaveFrame(state, mIt->first);
+        state.Write(mIt->second);
+    }
+    SDL_UnlockMutex(updateMutex);
+}
+
+void AcousticModem::RestoreState(StateBuffer& state)
+{
+    SDL_LockMutex(updateMutex);
+    Comm::RestoreState(state);
+    state.Read(position);
+    state.Read(frame);
+    
+    std::map<AcousticDataFrame*, Vector3>::iterator mIt;
+    for(mIt = propagating.begin(); mIt != propagating.end(); ++mIt)
+        delete mIt->first;
+    propagating.clear();
+    
+    uint32_t n;
+    state.Read(n);
+    for(uint32_t i=0; i<n && state.isValid(); ++i)
+    {
+        AcousticDataFrame* msg = (AcousticDataFrame*)RestoreFrame(state);
+        state.Read(propagating[msg]);
+    }
+    SDL_UnlockMutex(updateMutex);
+}
+
+void AcousticModem::SaveFrame(StateBuffer& state, const CommDataFrame* msg)
+{
+    Comm::SaveFrame(state, msg);
+    state.Write(((const AcousticDataFrame*)msg)->txPosition);
+    state.Write(((const AcousticDataFrame*)msg)->travelled);
+}
+
+CommDataFrame* AcousticModem::RestoreFrame(StateBuffer& state, CommDataFrame* data)
+{
+    AcousticDataFrame* msg = data != nullptr ? (AcousticDataFrame*)data : new AcousticDataFrame();
+    Comm::RestoreFrame(state, msg);
+    state.Read(msg->txPosition);
+    state.Read(msg->travelled);
+    return msg;
+}
+
 }
\ No newline at end of file
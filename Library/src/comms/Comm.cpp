@@ -30,6 +30,9 @@
 #include "graphics/OpenGLPipeline.h"
 #include "entities/SolidEntity.h"
 #include "entities/StaticEntity.h"
+#include "core/Console.h"
+#include "core/CloneContext.h"
+#include "core/StateBuffer.h"
 
 namespace sf
 {
@@ -181,4 +184,77 @@ std::vector<Renderable> Comm::Render()
     return items;
 }
     
+Comm* Comm::Clone(CloneContext& ctx)
+{
+    cError("Comm '%s' cannot be cloned!", name.c_str());
+    return nullptr;
+}
+
+void Comm::InitCopy(CloneContext& ctx)
+{
+    updateMutex = SDL_CreateMutex();
+    newDataAvailable = false;
+    txBuffer.clear(); //Messages in transit are not copied
+    rxBuffer.clear();
+    ctx.Remap(attach);
+}
+
+void Comm::SaveState(StateBuffer& state)
+{
+    SDL_LockMutex(updateMutex);
+    state.Write(newDataAvailable);
+    state.Write(txSeq);
+    state.Write((uint32_t)txBuffer.size());
+    for(size_t i=0; i<txBuffer.size(); ++i)
+        SaveFrame(state, txBuffer[i]);
+    state.Write((uint32_t)rxBuffer.size());
+    for(size_t i=0; i<rxBuffer.size(); ++i)
+        SaveFrame(state, rxBuffer[i]);
+    SDL_UnlockMutex(updateMutex);
+}
+
+void Comm::RestoreState(StateBuffer& state)
+{
+    SDL_LockMutex(updateMutex);
+    state.Read(newDataAvailable);
+    state.Read(txSeq);
+    
+    for(size_t i=0; i<txBuffer.size(); ++i)
+        delete txBuffer[i];
+    txBuffer.clear();
+    for(size_t i=0; i<rxBuffer.size(); ++i)
+        delete rxBuffer[i];
+    rxBuffer.clear();
+    
+    uint32_t n;
+    state.Read(n);
+    for(uint32_t i=0; i<n && state.isValid(); ++i)
+        txBuffer.push_back(RestoreFrame(state));
+    state.Read(n);
+    for(uint32_t i=0; i<n && state.isValid(); ++i)
+        rxBuffer.push_back(RestoreFrame(state));
+    SDL_UnlockMutex(updateMutex);
+}
+
+void Comm::SaveFrame(StateBuffer& state, const CommDataFrame* frame)
+{
+    state.Write(frame->timeStamp);
+    state.Write(frame->seq);
+    state.Write(frame->source);
+    state.Write(frame->destination);
+    state.Write(frame->data);
+}
+
+CommDataFrame* Comm::RestoreFrame(StateBuffer& state, CommDataFrame* frame)
+{
+    if(frame == nullptr)
+        frame = new CommDataFrame();
+    state.Read(frame->timeStamp);
+    state.Read(frame->seq);
+    state.Read(frame->source);
+    state.Read(frame->destination);
+    state.Read(frame->data);
+    return frame;
+}
+
 }
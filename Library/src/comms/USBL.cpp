@@ -25,17 +25,20 @@
 
 #include "comms/USBL.h"
 
+#include "core/CloneContext.h"
+#include "core/StateBuffer.h"
+
 namespace sf
 {
     
-std::random_device USBL::randomDevice;
-std::mt19937 USBL::randomGenerator(randomDevice());
-    
 USBL::USBL(std::string uniqueName, uint64_t deviceId, Scalar horizontalFOVDeg, Scalar verticalFOVDeg, Scalar operatingRange) 
            : AcousticModem(uniqueName, deviceId, horizontalFOVDeg, verticalFOVDeg, operatingRange)
 {
     ping = false;
+    pingRate = Scalar(0);
+    pingTime = Scalar(0);
     noise = false;
+    randomGenerator.seed(sm->DeriveRandomSeed(getName()));
 }
     
 void USBL::setNoise(Scalar rangeDev, Scalar angleDevDeg, Scalar nedDev, Scalar depthDev)
@@ -141,4 +144,62 @@ void USBL::ProcessMessages()
     }
 }
 
+Comm* USBL::Clone(CloneContext& ctx)
+{
+    USBL* copy = new USBL(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
+void USBL::SaveState(StateBuffer& state)
+{
+    SDL_LockMutex(updateMutex);
+    AcousticModem::SaveState(state);
+    state.Write(ping);
+    state.Write(pingRate);
+    state.Write(pingTime);
+    state.Write((uint32_t)transponderPos.size());
+    std::map<uint64_t, std::pair<Scalar, Vector3>>::iterator it;
+    for(it = transponderPos.begin(); it != transponderPos.end(); ++it)
+    {
+        state.Write(it->first);
+        state.Write(it->second.first);
+        state.Write(it->second.second);
+    }
+    state.Write(noiseRange);
+    state.Write(noiseAngle);
+    state.Write(noiseDepth);
+    state.Write(noiseNED);
+    state.Write(randomGenerator);
+    SDL_UnlockMutex(updateMutex);
+}
+
+void USBL::RestoreState(StateBuffer& state)
+{
+    SDL_LockMutex(updateMutex);
+    AcousticModem::RestoreState(state);
+    state.Read(ping);
+    state.Read(pingRate);
+    state.Read(pingTime);
+    transponderPos.clear();
+    uint32_t n;
+    state.Read(n);
+    for(uint32_t i=0; i<n && state.isValid(); ++i)
+    {
+        uint64_t id;
+        std::pair<Scalar, Vector3> pos;
+        state.Read(id);
+        state.Read(pos.first);
+        state.Read(pos.second);
+        transponderPos[id] = pos;
+    }
+    state.Read(noiseRange);
+    state.Read(noiseAngle);
+    state.Read(noiseDepth);
+    state.Read(noiseNED);
+    state.Read(randomGenerator);
+    SDL_UnlockMutex(updateMutex);
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,173 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  AssetCache.cpp
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/AssetCache.h"
+
+#include <sstream>
+#include "graphics/OpenGLDataStructs.h"
+
+namespace sf
+{
+
+unsigned int AssetCache::users = 0;
+std::map<std::string, const Mesh*> AssetCache::meshes;
+std::map<const void*, unsigned int> AssetCache::refs;
+SDL_mutex* AssetCache::cacheMutex = SDL_CreateMutex();
+
+void AssetCache::Acquire()
+{
+    SDL_LockMutex(cacheMutex);
+    ++users;
+    SDL_UnlockMutex(cacheMutex);
+}
+
+void AssetCache::Release()
+{
+    std::vector<const Mesh*> dropped;
+    SDL_LockMutex(cacheMutex);
+    if(users > 0 && --users == 0)
+    {
+        for(std::map<std::string, const Mesh*>::iterator it = meshes.begin(); it != meshes.end(); ++it)
+            dropped.push_back(it->second);
+        meshes.clear();
+    }
+    SDL_UnlockMutex(cacheMutex);
+    
+    //Drop the references held by the cache (meshes still used by entities stay alive)
+    for(size_t i=0; i<dropped.size(); ++i)
+        ReleaseMesh(dropped[i]);
+}
+
+bool AssetCache::isActive()
+{
+    SDL_LockMutex(cacheMutex);
+    bool active = users > 0;
+    SDL_UnlockMutex(cacheMutex);
+    return active;
+}
+
+const Mesh* AssetCache::getMesh(const std::string& key, const std::function<Mesh*()>& build)
+{
+    if(!isActive())
+        return build();
+    
+    SDL_LockMutex(cacheMutex);
+    std::map<std::string, const Mesh*>::iterator it = meshes.find(key);
+    if(it != meshes.end())
+    {
+        const Mesh* mesh = it->second;
+        ++refs[mesh];
+        SDL_UnlockMutex(cacheMutex);
+        return mesh;
+    }
+    SDL_UnlockMutex(cacheMutex);
+    
+    //Load outside of the lock, not to block other worlds
+    Mesh* mesh = build();
+    if(mesh == NULL)
+        return NULL;
+    
+    SDL_LockMutex(cacheMutex);
+    it = meshes.find(key);
+    if(it != meshes.end()) //Loaded by another thread in the meantime
+    {
+        const Mesh* cached = it->second;
+        ++refs[cached];
+        SDL_UnlockMutex(cacheMutex);
+        delete mesh;
+        return cached;
+    }
+    meshes[key] = mesh;
+    refs[mesh] = 2; //Cache and caller
+    SDL_UnlockMutex(cacheMutex);
+    return mesh;
+}
+
+std::string AssetCache::MeshKey(const std::string& filename, Scalar scale, const Transform& origin, const std::string& processing)
+{
+    std::ostringstream key;
+    key.precision(17);
+    key << filename << "|" << scale;
+    const Matrix3& basis = origin.getBasis();
+    for(int i=0; i<3; ++i)
+        key << "|" << basis[i].x() << "," << basis[i].y() << "," << basis[i].z();
+    key << "|" << origin.getOrigin().x() << "," << origin.getOrigin().y() << "," << origin.getOrigin().z();
+    key << "|" << processing;
+    return key.str();
+}
+
+void AssetCache::AddReference(const void* asset)
+{
+    if(asset == NULL)
+        return;
+    
+    SDL_LockMutex(cacheMutex);
+    std::map<const void*, unsigned int>::iterator it = refs.find(asset);
+    if(it == refs.end())
+        refs[asset] = 2; //Original owner and new one
+    else
+        ++it->second;
+    SDL_UnlockMutex(cacheMutex);
+}
+
+bool AssetCache::RemoveReference(const void* asset)
+{
+    if(asset == NULL)
+        return false;
+    
+    bool last = true;
+    SDL_LockMutex(cacheMutex);
+    std::map<const void*, unsigned int>::iterator it = refs.find(asset);
+    if(it != refs.end())
+    {
+        if(--it->second <= 1)
+            refs.erase(it); //Single owner left
+        last = false;
+    }
+    SDL_UnlockMutex(cacheMutex);
+    return last;
+}
+
+void AssetCache::ReleaseMesh(const Mesh* mesh)
+{
+    if(RemoveReference(mesh))
+        delete mesh;
+}
+
+void AssetCache::ReleaseShape(btCollisionShape* shape)
+{
+    if(!RemoveReference(shape))
+        return;
+    
+    if(shape->isCompound())
+    {
+        btCompoundShape* comp = (btCompoundShape*)shape;
+        for(int i=0; i<comp->getNumChildShapes(); ++i)
+            ReleaseShape(comp->getChildShape(i));
+    }
+    delete shape;
+}
+
+}
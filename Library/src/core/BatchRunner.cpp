@@ -0,0 +1,430 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  BatchRunner.cpp
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/BatchRunner.h"
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <SDL2/SDL_thread.h>
+#include "core/AssetCache.h"
+#include "core/ConsoleSimulationApp.h"
+#include "core/Console.h"
+#include "core/ScenarioParser.h"
+#include "sensors/ScalarSensor.h"
+#include "sensors/Sample.h"
+
+using namespace tinyxml2;
+
+namespace sf
+{
+
+//! A simulation manager building the scenario from an in-memory description and recording sensor samples.
+class BatchSimulationManager : public SimulationManager
+{
+public:
+    BatchSimulationManager(Scalar stepsPerSecond, SolverType st, CollisionFilteringType cft, const XMLDocument* description)
+        : SimulationManager(stepsPerSecond, st, cft), desc(description), built(false)
+    {
+    }
+
+    void BuildScenario()
+    {
+        built = false;
+        samples.clear();
+        if(desc == NULL)
+            return;
+
+        ScenarioParser parser(this);
+        desc->DeepCopy(parser.getDocument());
+        built = parser.Build();
+
+        Sensor* s;
+        unsigned int id = 0;
+        while((s = getSensor(id++)) != NULL)
+        {
+            ScalarSensor* ss = dynamic_cast<ScalarSensor*>(s);
+            if(ss != NULL)
+                samples.push_back(std::make_pair(ss, std::vector<Scalar>()));
+        }
+    }
+
+    void SimulationStepCompleted(Scalar timeStep)
+    {
+        for(size_t i = 0; i < samples.size(); ++i)
+        {
+            ScalarSensor* ss = samples[i].first;
+            if(!ss->isNewDataAvailable())
+                continue;
+            Sample s = ss->getLastSample();
+            samples[i].second.push_back(s.getTimestamp());
+            for(unsigned short h = 0; h < s.getNumOfDimensions(); ++h)
+                samples[i].second.push_back(s.getValue(h));
+            ss->MarkDataOld();
+        }
+    }
+
+    bool WriteSamples(const std::string& path, unsigned int runId)
+    {
+        std::ofstream out(path, std::ios::binary);
+        if(!out.is_open())
+            return false;
+
+        uint32_t u32 = 1;
+        out.write("SFBR", 4);
+        out.write((const char*)&u32, sizeof(u32));
+        u32 = runId;
+        out.write((const char*)&u32, sizeof(u32));
+        u32 = (uint32_t)samples.size();
+        out.write((const char*)&u32, sizeof(u32));
+
+        for(size_t i = 0; i < samples.size(); ++i)
+        {
+            ScalarSensor* ss = samples[i].first;
+            WriteString(out, ss->getName());
+            uint16_t nCh = ss->getNumOfChannels();
+            out.write((const char*)&nCh, sizeof(nCh));
+            for(unsigned short h = 0; h < nCh; ++h)
+                WriteString(out, ss->getSensorChannelDescription(h).name);
+            u32 = (uint32_t)(samples[i].second.size()/(nCh + 1));
+            out.write((const char*)&u32, sizeof(u32));
+            for(size_t h = 0; h < samples[i].second.size(); ++h)
+            {
+                double v = (double)samples[i].second[h];
+                out.write((const char*)&v, sizeof(v));
+            }
+        }
+        return out.good();
+    }
+
+    bool isBuilt()
+    {
+        return built;
+    }
+
+private:
+    static void WriteString(std::ofstream& out, const std::string& str)
+    {
+        uint16_t len = (uint16_t)str.size();
+        out.write((const char*)&len, sizeof(len));
+        out.write(str.data(), len);
+    }
+
+    const XMLDocument* desc;
+    bool built;
+    std::vector<std::pair<ScalarSensor*, std::vector<Scalar>>> samples;
+};
+
+//! A console application driving a single run of the batch in the calling thread.
+class BatchSimulationApp : public ConsoleSimulationApp
+{
+public:
+    BatchSimulationApp(std::string dataDirPath, SimulationManager* sim)
+        : ConsoleSimulationApp("Batch", dataDirPath, sim)
+    {
+    }
+
+    Scalar Execute(Scalar duration)
+    {
+        InitializeSimulation();
+        if(!((BatchSimulationManager*)getSimulationManager())->isBuilt())
+            return Scalar(-1);
+
+        SimulationManager* sm = getSimulationManager();
+        sm->setFixedStepMode(true);
+        if(!sm->StartSimulation())
+            return Scalar(-1);
+        sm->StepSimulation((unsigned int)std::round(duration * sm->getStepsPerSecond()));
+        return sm->getSimulationTime();
+    }
+};
+
+BatchRunner::BatchRunner(std::string dataDirPath, Scalar stepsPerSecond, SolverType st, CollisionFilteringType cft)
+{
+    dataPath = dataDirPath;
+    sps = stepsPerSecond;
+    solver = st;
+    collisionFilter = cft;
+    runDuration = Scalar(0);
+    nextRun = 0;
+    runMutex = SDL_CreateMutex();
+    AssetCache::Acquire(); //Meshes are loaded once and shared by all runs, until the runner is destroyed
+    //Loader app bound to the calling thread, used when pre-processing the scenario description
+    loaderManager = new BatchSimulationManager(sps, solver, collisionFilter, NULL);
+    loaderApp = new BatchSimulationApp(dataPath, loaderManager);
+}
+
+BatchRunner::~BatchRunner()
+{
+    delete loaderManager;
+    delete loaderApp;
+    AssetCache::Release();
+    SDL_DestroyMutex(runMutex);
+}
+
+bool BatchRunner::LoadScenario(const std::string& filename)
+{
+    loaderApp->BindToThread();
+    ScenarioParser parser(loaderManager);
+    if(!parser.Load(filename))
+        return false;
+    scenario.Clear();
+    parser.getDocument()->DeepCopy(&scenario);
+    return true;
+}
+
+void BatchRunner::AddRun(const std::vector<ScenarioOverride>& overrides)
+{
+    runs.push_back(overrides);
+}
+
+bool BatchRunner::LoadRuns(const std::string& filename)
+{
+    loaderApp->BindToThread();
+    std::ifstream in(filename);
+    if(!in.is_open())
+    {
+        cError("Batch runner: file '%s' not found!", filename.c_str());
+        return false;
+    }
+
+    std::string line;
+    unsigned int lineNo = 0;
+    while(std::getline(in, line))
+    {
+        ++lineNo;
+        size_t start = line.find_first_not_of(" \t\r");
+        if(start == std::string::npos || line[start] == '#')
+            continue;
+
+        //Split into tokens, respecting quotes
+        std::vector<std::string> tokens;
+        std::string token;
+        bool quoted = false;
+        for(size_t i = start; i < line.size(); ++i)
+        {
+            char c = line[i];
+            if(c == '"')
+                quoted = !quoted;
+            else if(!quoted && (c == ' ' || c == '\t' || c == '\r'))
+            {
+                if(!token.empty())
+                    tokens.push_back(token);
+                token.clear();
+            }
+            else
+                token += c;
+        }
+        if(!token.empty())
+            tokens.push_back(token);
+
+        std::vector<ScenarioOverride> overrides;
+        for(size_t i = 0; i < tokens.size(); ++i)
+        {
+            ScenarioOverride o;
+            if(!ParseOverride(tokens[i], o))
+            {
+                cError("Batch runner: wrong override '%s' in line %u!", tokens[i].c_str(), lineNo);
+                return false;
+            }
+            overrides.push_back(o);
+        }
+        AddRun(overrides);
+    }
+    return true;
+}
+
+unsigned int BatchRunner::getNumOfRuns()
+{
+    return (unsigned int)runs.size();
+}
+
+bool BatchRunner::ParseOverride(const std::string& text, ScenarioOverride& o)
+{
+    size_t at = text.find('@');
+    if(at == std::string::npos)
+        return false;
+    size_t eq = text.find('=', at);
+    if(eq == std::string::npos || eq == at + 1)
+        return false;
+    o.path = text.substr(0, at);
+    o.attribute = text.substr(at + 1, eq - at - 1);
+    o.value = text.substr(eq + 1);
+    return true;
+}
+
+bool BatchRunner::ApplyOverride(XMLDocument* doc, const ScenarioOverride& o)
+{
+    XMLElement* element = doc->FirstChildElement("scenario");
+    if(element == nullptr)
+        return false;
+
+    std::stringstream ss(o.path);
+    std::string segment;
+    while(std::getline(ss, segment, '/'))
+    {
+        if(segment.empty())
+            continue;
+
+        //Segment in the form tag or tag[key=value]
+        std::string tag = segment;
+        std::string key;
+        std::string value;
+        size_t bracket = segment.find('[');
+        if(bracket != std::string::npos)
+        {
+            size_t eq = segment.find('=', bracket);
+            size_t end = segment.find(']', bracket);
+            if(eq == std::string::npos || end == std::string::npos || end < eq)
+                return false;
+            tag = segment.substr(0, bracket);
+            key = segment.substr(bracket + 1, eq - bracket - 1);
+            value = segment.substr(eq + 1, end - eq - 1);
+        }
+
+        XMLElement* child = element->FirstChildElement(tag.c_str());
+        while(child != nullptr && !key.empty())
+        {
+            const char* attr = child->Attribute(key.c_str());
+            if(attr != nullptr && value == attr)
+                break;
+            child = child->NextSiblingElement(tag.c_str());
+        }
+        if(child == nullptr)
+            return false;
+        element = child;
+    }
+
+    element->SetAttribute(o.attribute.c_str(), o.value.c_str());
+    return true;
+}
+
+std::vector<BatchRunResult> BatchRunner::Run(Scalar duration, unsigned int numThreads, const std::string& outputDirPath)
+{
+    loaderApp->BindToThread();
+    if(scenario.FirstChildElement("scenario") == nullptr)
+    {
+        cError("Batch runner: scenario not loaded!");
+        return std::vector<BatchRunResult>(0);
+    }
+
+    runDuration = duration;
+    outputPath = outputDirPath;
+    nextRun = 0;
+    results = std::vector<BatchRunResult>(runs.size());
+    numThreads = std::max(1u, std::min(numThreads, (unsigned int)runs.size()));
+
+    cInfo("Batch runner: executing %u runs of %1.3lf s using %u threads...", (unsigned int)runs.size(), duration, numThreads);
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<SDL_Thread*> threads;
+    for(unsigned int i = 0; i < numThreads; ++i)
+        threads.push_back(SDL_CreateThread(BatchRunner::WorkerLoop, "batchWorker", this));
+    for(size_t i = 0; i < threads.size(); ++i)
+        SDL_WaitThread(threads[i], NULL);
+
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    //Summary
+    loaderApp->BindToThread();
+    unsigned int succeeded = 0;
+    double simTotal = 0.0;
+    double runWall = 0.0;
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        if(!results[i].success)
+        {
+            cWarning("Batch runner: run %u failed!", results[i].id);
+            continue;
+        }
+        ++succeeded;
+        simTotal += results[i].simulatedTime;
+        runWall += results[i].wallTime;
+    }
+    cInfo("Batch runner: %u/%u runs completed in %1.3lf s.", succeeded, (unsigned int)results.size(), wall);
+    if(succeeded > 0 && wall > 0.0 && runWall > 0.0)
+        cInfo("Batch runner: throughput %1.3lf simulated s/s (%1.3lf simulated s/s per run).", simTotal/wall, simTotal/runWall);
+
+    return results;
+}
+
+int BatchRunner::WorkerLoop(void* data)
+{
+    BatchRunner* runner = (BatchRunner*)data;
+    while(true)
+    {
+        runner->loaderApp->BindToThread(); //Console output outside of runs
+        SDL_LockMutex(runner->runMutex);
+        unsigned int id = runner->nextRun++;
+        SDL_UnlockMutex(runner->runMutex);
+        if(id >= runner->runs.size())
+            break;
+        runner->results[id] = runner->ExecuteRun(id);
+    }
+    return 0;
+}
+
+BatchRunResult BatchRunner::ExecuteRun(unsigned int id)
+{
+    BatchRunResult result;
+    result.id = id;
+    result.success = false;
+    result.simulatedTime = Scalar(0);
+    result.wallTime = Scalar(0);
+    auto start = std::chrono::steady_clock::now();
+
+    //Copy and modify the description
+    XMLDocument desc;
+    scenario.DeepCopy(&desc);
+    for(size_t i = 0; i < runs[id].size(); ++i)
+        if(!ApplyOverride(&desc, runs[id][i]))
+        {
+            cError("Batch runner: override '%s@%s' of run %u could not be applied!", runs[id][i].path.c_str(), runs[id][i].attribute.c_str(), id);
+            return result;
+        }
+
+    //Build and run the simulation (the app binds itself to this thread, meshes come from the cache held by the runner)
+    BatchSimulationManager* sim = new BatchSimulationManager(sps, solver, collisionFilter, &desc);
+    BatchSimulationApp* app = new BatchSimulationApp(dataPath, sim);
+    Scalar simTime = app->Execute(runDuration);
+    if(simTime >= Scalar(0))
+    {
+        char filename[32];
+        snprintf(filename, 32, "run_%04u.sfb", id);
+        result.outputPath = outputPath + "/" + std::string(filename);
+        result.simulatedTime = simTime;
+        result.success = sim->WriteSamples(result.outputPath, id);
+        if(!result.success)
+            cError("Batch runner: could not write '%s'!", result.outputPath.c_str());
+    }
+    delete sim;
+    delete app;
+
+    result.wallTime = std::chrono::duration<Scalar>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+}
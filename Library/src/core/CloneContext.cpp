@@ -0,0 +1,69 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  CloneContext.cpp
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/CloneContext.h"
+
+#include "core/SimulationApp.h"
+#include "core/Console.h"
+
+namespace sf
+{
+
+CloneContext::CloneContext(SimulationManager* target) : sm(target)
+{
+}
+
+void CloneContext::AddCopy(const void* original, void* copy)
+{
+    copies[original] = copy;
+}
+
+bool CloneContext::Resolve()
+{
+    bool ok = true;
+    for(size_t i=0; i<pending.size(); ++i)
+    {
+        std::map<const void*, void*>::const_iterator it = copies.find(pending[i].second);
+        if(it != copies.end())
+            *pending[i].first = it->second;
+        else
+        {
+            *pending[i].first = NULL;
+            ok = false;
+        }
+    }
+    pending.clear();
+    
+    if(!ok)
+        cError("Clone: Some of the objects referenced in the cloned world could not be copied!");
+    return ok;
+}
+
+SimulationManager* CloneContext::getSimulationManager() const
+{
+    return sm;
+}
+
+}
@@ -27,6 +27,7 @@
 
 #include <chrono>
 #include <thread>
+#include <SDL2/SDL_timer.h>
 #include "core/Console.h"
 #include "core/SimulationManager.h"
 #include "utils/SystemUtil.hpp"
@@ -38,10 +39,15 @@ ConsoleSimulationApp::ConsoleSimulationApp(std::string name, std::string dataDir
 : SimulationApp(name, dataDirPath, sim)
 {
     simulationThread = NULL;
+    loopMutex = SDL_CreateMutex();
+    loopCond = SDL_CreateCond();
+    periodicFreq = Scalar(0);
 }
 
 ConsoleSimulationApp::~ConsoleSimulationApp()
 {
+    SDL_DestroyCond(loopCond);
+    SDL_DestroyMutex(loopMutex);
     delete console;
 }
 
@@ -58,9 +64,55 @@ void ConsoleSimulationApp::Init()
     cInfo("Ready for running...");
 }
 
+void ConsoleSimulationApp::setPeriodicUpdateFrequency(Scalar f)
+{
+    SDL_LockMutex(loopMutex);
+    periodicFreq = f > Scalar(0) ? f : Scalar(0);
+    SDL_CondSignal(loopCond);
+    SDL_UnlockMutex(loopMutex);
+}
+
+Scalar ConsoleSimulationApp::getPeriodicUpdateFrequency()
+{
+    return periodicFreq;
+}
+
+void ConsoleSimulationApp::PeriodicUpdate()
+{
+}
+
 void ConsoleSimulationApp::Loop()
 {
-    while(!hasFinished());
+    //Sleep until the application is finished, waking up only to call the periodic update
+    uint32_t nextUpdate = SDL_GetTicks();
+    
+    SDL_LockMutex(loopMutex);
+    while(!hasFinished())
+    {
+        if(periodicFreq > Scalar(0))
+        {
+            uint32_t now = SDL_GetTicks();
+            if(!SDL_TICKS_PASSED(now, nextUpdate))
+            {
+                SDL_CondWaitTimeout(loopCond, loopMutex, nextUpdate - now);
+                continue;
+            }
+            
+            nextUpdate += (uint32_t)btMax(Scalar(1), Scalar(1000)/periodicFreq);
+            if(SDL_TICKS_PASSED(now, nextUpdate)) //Skip missed updates
+                nextUpdate = now;
+            
+            SDL_UnlockMutex(loopMutex);
+            PeriodicUpdate();
+            SDL_LockMutex(loopMutex);
+        }
+        else
+        {
+            SDL_CondWait(loopCond, loopMutex);
+            nextUpdate = SDL_GetTicks();
+        }
+    }
+    SDL_UnlockMutex(loopMutex);
 }
 
 void ConsoleSimulationApp::StartSimulation()
@@ -88,12 +140,25 @@ void ConsoleSimulationApp::StopSimulation()
     int status;
     SDL_WaitThread(simulationThread, &status);
     simulationThread = NULL;
+    
+    SDL_LockMutex(loopMutex);
+    SDL_CondSignal(loopCond);
+    SDL_UnlockMutex(loopMutex);
+}
+
+void ConsoleSimulationApp::Quit()
+{
+    SDL_LockMutex(loopMutex);
+    SimulationApp::Quit();
+    SDL_CondSignal(loopCond);
+    SDL_UnlockMutex(loopMutex);
 }
 
 //Static
 int ConsoleSimulationApp::RunSimulation(void* data)
 {
     ConsoleSimulationThreadData* stdata = (ConsoleSimulationThreadData*)data;
+    stdata->app->BindToThread();
     SimulationManager* sim = stdata->app->getSimulationManager();
     
     while(stdata->app->isRunning())
@@ -0,0 +1,100 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  ContactInfoPool.cpp
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/ContactInfoPool.h"
+
+namespace sf
+{
+
+ContactInfoPool::ContactInfoPool(unsigned int blocksPerChunk) : freeList(NULL), capacity(0), used(0), highWaterMark(0)
+{
+    chunkSize = blocksPerChunk > 0 ? blocksPerChunk : 1;
+}
+
+ContactInfoPool::~ContactInfoPool()
+{
+    for(size_t i=0; i<chunks.size(); ++i)
+        delete [] chunks[i];
+}
+
+void ContactInfoPool::AddChunk()
+{
+    Block* chunk = new Block[chunkSize];
+    for(unsigned int i=0; i<chunkSize; ++i)
+    {
+        chunk[i].owner = this;
+        chunk[i].next = i < chunkSize-1 ? &chunk[i+1] : freeList;
+    }
+    freeList = chunk;
+    chunks.push_back(chunk);
+    capacity.store((unsigned int)(chunks.size() * chunkSize), std::memory_order_relaxed);
+}
+
+ContactInfo* ContactInfoPool::Allocate()
+{
+    if(freeList == NULL)
+        AddChunk();
+    
+    Block* b = freeList;
+    freeList = b->next;
+    b->info.totalAppliedImpulse = Scalar(0);
+    b->info.slip.setZero();
+    
+    unsigned int n = used.load(std::memory_order_relaxed) + 1;
+    used.store(n, std::memory_order_relaxed);
+    if(n > highWaterMark.load(std::memory_order_relaxed))
+        highWaterMark.store(n, std::memory_order_relaxed);
+    
+    return &b->info;
+}
+
+void ContactInfoPool::Release(ContactInfo* info)
+{
+    if(info == NULL)
+        return;
+    
+    Block* b = (Block*)info;
+    ContactInfoPool* pool = b->owner;
+    b->next = pool->freeList;
+    pool->freeList = b;
+    pool->used.store(pool->used.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+}
+
+unsigned int ContactInfoPool::getNumOfUsedBlocks() const
+{
+    return used.load(std::memory_order_relaxed);
+}
+
+unsigned int ContactInfoPool::getHighWaterMark() const
+{
+    return highWaterMark.load(std::memory_order_relaxed);
+}
+
+unsigned int ContactInfoPool::getCapacity() const
+{
+    return capacity.load(std::memory_order_relaxed);
+}
+
+}
@@ -26,17 +26,21 @@
 #include "core/FilteredCollisionDispatcher.h"
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
-#include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/StepProfiler.h"
 #include "entities/SolidEntity.h"
 #include "sensors/Contact.h"
 
 namespace sf
 {
 
-FilteredCollisionDispatcher::FilteredCollisionDispatcher(btCollisionConfiguration* collisionConfiguration, bool inclusiveMode) : btCollisionDispatcher(collisionConfiguration)
+thread_local SimulationManager* FilteredCollisionDispatcher::dispatchingManager = NULL;
+
+FilteredCollisionDispatcher::FilteredCollisionDispatcher(btCollisionConfiguration* collisionConfiguration, SimulationManager* simManager, bool inclusiveMode, StepProfiler* prof) : btCollisionDispatcher(collisionConfiguration)
 {
+    sm = simManager;
     inclusive = inclusiveMode;
+    profiler = prof;
     //setNearCallback(myNearCallback);
 }
 
@@ -55,9 +59,22 @@ bool FilteredCollisionDispatcher::needsCollision(const btCollisionObject* body0,
         return false;
     
     if(inclusive)
-        return SimulationApp::getApp()->getSimulationManager()->CheckCollision(ent0, ent1) > -1;
+        return sm->CheckCollision(ent0, ent1) > -1;
     else //exclusive
-        return SimulationApp::getApp()->getSimulationManager()->CheckCollision(ent0, ent1) == -1;
+        return sm->CheckCollision(ent0, ent1) == -1;
+}
+
+void FilteredCollisionDispatcher::dispatchAllCollisionPairs(btOverlappingPairCache* pairCache, const btDispatcherInfo& dispatchInfo, btDispatcher* dispatcher)
+{
+    //Everything since the end of the pre-tick callback was broadphase (AABB update and pair search)
+    SF_PROFILE_END(profiler, StepPhase::BROADPHASE);
+    SF_PROFILE_BEGIN(profiler, StepPhase::NARROWPHASE);
+    SimulationManager* previous = dispatchingManager; //Another world may be stepped from a callback
+    dispatchingManager = sm;
+    btCollisionDispatcher::dispatchAllCollisionPairs(pairCache, dispatchInfo, dispatcher);
+    dispatchingManager = previous;
+    SF_PROFILE_END(profiler, StepPhase::NARROWPHASE);
+    SF_PROFILE_BEGIN(profiler, StepPhase::SOLVER);
 }
 
 void FilteredCollisionDispatcher::myNearCallback(btBroadphasePair& collisionPair, btCollisionDispatcher& dispatcher, const btDispatcherInfo& dispatchInfo)
@@ -94,4 +111,9 @@ void FilteredCollisionDispatcher::myNearCallback(btBroadphasePair& collisionPair
     }
 }
 
+SimulationManager* FilteredCollisionDispatcher::getDispatchingManager()
+{
+    return dispatchingManager;
+}
+
 }
@@ -40,6 +40,7 @@
 #include "entities/StaticEntity.h"
 #include "entities/SolidEntity.h"
 #include "entities/solids/Compound.h"
+#include "entities/forcefields/Ocean.h"
 #include "utils/icon.h"
 
 namespace sf
@@ -612,6 +613,11 @@ void GraphicalSimulationApp::RenderLoop()
         getSimulationManager()->UpdateDrawingQueue();
     }
     
+    //Wave sampling points are captured only when hydrodynamics helpers are displayed
+    Ocean* ocn = getSimulationManager()->getOcean();
+    if(ocn != NULL && ocn->isWavesDebugEnabled() != getHelperSettings().showFluidDynamics)
+        ocn->setWavesDebug(getHelperSettings().showFluidDynamics);
+    
     //Rendering
     glBeginQuery(GL_TIME_ELAPSED, timeQuery[timeQueryPingpong]);
     glPipeline->Render(getSimulationManager());
@@ -869,6 +875,31 @@ void GraphicalSimulationApp::DoHUD()
         }
     }
     
+    //Step profile (only available when compiled with profiling)
+    StepProfile profile = getSimulationManager()->getStepProfile();
+    if(profile.enabled && profile.samples > 0)
+    {
+        GLfloat pOffset = 10.f;
+        GLfloat pLeft = getWindowWidth() - 250.f;
+        gui->DoPanel(pLeft, pOffset, 240.f, 40.f + STEP_PHASE_COUNT * 14.f);
+        pOffset += 5.f;
+        gui->DoLabel(pLeft + 5.f, pOffset, "STEP PROFILE [ms] (mean/p95/max)");
+        pOffset += 16.f;
+        
+        for(unsigned int i = 0; i < STEP_PHASE_COUNT; ++i)
+        {
+            const PhaseTiming& pt = profile.phases[i];
+            gui->DoLabel(pLeft + 8.f, pOffset, StepProfiler::getPhaseName((StepPhase)i));
+            std::sprintf(buf, "%1.3lf / %1.3lf / %1.3lf", pt.mean, pt.p95, pt.max);
+            gui->DoLabel(pLeft + 100.f, pOffset, buf);
+            pOffset += 14.f;
+        }
+        
+        gui->DoLabel(pLeft + 8.f, pOffset, "Contact data");
+        std::sprintf(buf, "%u / %u peak / %u", profile.contactsInUse, profile.contactsHighWater, profile.contactsCapacity);
+        gui->DoLabel(pLeft + 100.f, pOffset, buf);
+    }
+    
     //Bottom panel
     gui->DoPanel(-10, getWindowHeight()-30.f, getWindowWidth()+20, 30.f);
     
@@ -933,6 +964,7 @@ int GraphicalSimulationApp::RenderLoadingScreen(void* data)
 {
     //Get application
     LoadingThreadData* ltdata = (LoadingThreadData*)data;
+    ltdata->app->BindToThread();
     
     //Make drawing in this thread possible
     SDL_GL_MakeCurrent(ltdata->app->window, ltdata->app->glLoadingContext);  
@@ -974,6 +1006,7 @@ int GraphicalSimulationApp::RenderLoadingScreen(void* data)
 int GraphicalSimulationApp::RunSimulation(void* data)
 {
     GraphicalSimulationThreadData* stdata = (GraphicalSimulationThreadData*)data;
+    stdata->app->BindToThread();
     SimulationManager* sim = stdata->app->getSimulationManager();
     
     while(stdata->app->isRunning())
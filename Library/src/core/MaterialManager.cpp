@@ -55,27 +55,22 @@ std::string MaterialManager::CreateMaterial(const std::string& uniqueName, Scala
     mat.name = materialNameManager.AddName(uniqueName);
     mat.density = density;
     mat.restitution = restitution;
+    mat.index = (int)materials.size();
     materials.push_back(mat);
     
     cInfo("Material %s (%d) created.", mat.name.c_str(), materials.size()-1);
     
-    //Set initial friction coefficients
+    //Grow interaction table, keeping existing coefficients
     Friction f;
     f.fStatic = Scalar(1);
     f.fDynamic = Scalar(1);
     
-    MaterialPair p;
-    p.mat1Id = (int)materials.size()-1;
-    
-    for(unsigned int i=0; i < materials.size(); ++i)
-    {
-        p.mat2Id = i;
-        interactions.insert({p,f});
-    }
-    
-    //Display interactions
-    //for(std::pair<MaterialPair, Friction> element : interactions)
-    //	std::cout << "(" << element.first.mat1Id << "," << element.first.mat2Id << ")" << std::endl;
+    size_t n = materials.size();
+    std::vector<Friction> table(n * n, f);
+    for(size_t i=0; i < n-1; ++i)
+        for(size_t h=0; h < n-1; ++h)
+            table[i * n + h] = interactions[i * (n-1) + h];
+    interactions.swap(table);
 
     return mat.name;
 }
@@ -94,47 +89,37 @@ std::string MaterialManager::CreateFluid(const std::string& uniqueName, Scalar d
 
 bool MaterialManager::SetMaterialsInteraction(const std::string& firstMaterialName, const std::string& secondMaterialName, Scalar staticFricCoeff, Scalar dynamicFricCoeff)
 {
-    MaterialPair p;
-    p.mat1Id = getMaterialIndex(firstMaterialName);
-    p.mat2Id = getMaterialIndex(secondMaterialName);
-    
-    Friction f;
-    f.fStatic = staticFricCoeff;
-    f.fDynamic = dynamicFricCoeff;
+    int id1 = getMaterialIndex(firstMaterialName);
+    int id2 = getMaterialIndex(secondMaterialName);
     
-    try
-    {
-        interactions.at(p) = f;
-        return true;
-    }
-    catch(const std::out_of_range& e)
+    if(id1 < 0 || id2 < 0)
     {
         cError("Material pair (%s,%s) not found!", firstMaterialName.c_str(), secondMaterialName.c_str());
         return false;
     }
+    
+    Friction f;
+    f.fStatic = staticFricCoeff;
+    f.fDynamic = dynamicFricCoeff;
+    
+    size_t n = materials.size();
+    interactions[id1 * n + id2] = f;
+    interactions[id2 * n + id1] = f;
+    return true;
 }
 
-Friction MaterialManager::GetMaterialsInteraction(int mat1Index, int mat2Index)
+Friction MaterialManager::GetMaterialsInteraction(int mat1Index, int mat2Index) const
 {
-    MaterialPair p;
-    p.mat1Id = mat1Index;
-    p.mat2Id = mat2Index;
-        
-    try
-    {
-        Friction f = interactions.at(p);
-        return f;
-    }
-    catch(const std::out_of_range& e)
-    {
-        cError("Material pair (%d,%d) not found!", mat1Index, mat2Index);
-        
-        Friction f;
-        f.fStatic = Scalar(1);
-        f.fDynamic = Scalar(2);
+    int n = (int)materials.size();
+    if(mat1Index >= 0 && mat1Index < n && mat2Index >= 0 && mat2Index < n)
+        return interactions[mat1Index * n + mat2Index];
+    
+    cError("Material pair (%d,%d) not found!", mat1Index, mat2Index);
         
-        return f;
-    }
+    Friction f;
+    f.fStatic = Scalar(1);
+    f.fDynamic = Scalar(2);
+    return f;
 }
 
 Friction MaterialManager::GetMaterialsInteraction(const std::string& mat1Name, const std::string& mat2Name)
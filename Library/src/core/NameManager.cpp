@@ -25,12 +25,13 @@
 
 #include "core/NameManager.h"
 
+#include <algorithm>
+
 namespace sf
 {
 
 NameManager::NameManager()
 {
-    names = std::vector<std::string>(0);
 }
 
 NameManager::~NameManager()
@@ -40,38 +41,48 @@ NameManager::~NameManager()
 
 std::string NameManager::AddName(std::string proposedName)
 {
-    std::string goodName = proposedName;
-    int number = 1;
+    if(names.insert(proposedName).second)
+        return proposedName;
     
-checkname:
-    for(unsigned int i = 0; i < names.size(); i++)
-    {
-        if(goodName == names[i])
-        {
-            goodName = proposedName + std::to_string(number);
-            number++;
-            goto checkname;
-        }
-    }
+    //Continue numbering from the last name generated for this proposal
+    unsigned int& number = nextSuffix[proposedName];
+    if(number == 0)
+        number = 1;
+    
+    std::string goodName = proposedName + std::to_string(number++);
+    while(!names.insert(goodName).second)
+        goodName = proposedName + std::to_string(number++);
     
-    names.push_back(goodName);
     return goodName;
 }
 
 void NameManager::RemoveName(std::string name)
 {
-    std::vector<std::string>::iterator it;
-    for(it = names.begin(); it < names.end(); it++)
-        if(*it == name)
-        {
-            names.erase(it);
-            break;
-        }
+    if(names.erase(name) == 0 || nextSuffix.empty())
+        return;
+    
+    //The name may have been generated from any prefix followed by a part of its trailing digits,
+    //so the numbering of these prefixes is lowered to reuse the freed suffix
+    size_t digits = name.size();
+    while(digits > 0 && name[digits-1] >= '0' && name[digits-1] <= '9')
+        --digits;
+    
+    for(size_t k=std::max(digits, name.size() > 9 ? name.size()-9 : 0); k<name.size(); ++k)
+    {
+        if(name[k] == '0') //Suffixes are generated without leading zeros
+            continue;
+        
+        std::unordered_map<std::string, unsigned int>::iterator it = nextSuffix.find(name.substr(0, k));
+        unsigned int number = (unsigned int)std::stoul(name.substr(k));
+        if(it != nextSuffix.end() && number < it->second)
+            it->second = number;
+    }
 }
 
 void NameManager::ClearNames()
 {
     names.clear();
+    nextSuffix.clear();
 }
 
 }
@@ -49,9 +49,10 @@
 namespace sf
 {
 
-ResearchConstraintSolver::ResearchConstraintSolver(btMLCPSolverInterface* mlcp) : btMultiBodyConstraintSolver()
+ResearchConstraintSolver::ResearchConstraintSolver(btMLCPSolverInterface* mlcp, StepProfiler* prof) : btMultiBodyConstraintSolver()
 {
     m_solver = mlcp;
+    m_profiler = prof;
     m_fallback = 0;
     m_cfm = 0.0;
     m_interleaveContactAndFriction = false;
@@ -174,12 +175,12 @@ void ResearchConstraintSolver::createMLCPFast(const btContactSolverInfo& infoGlo
         jointNodeArray.reserve(2*m_allConstraintPtrArray.size());
     }
     
-    static btMatrixXu J3;
+    btMatrixXu& J3 = m_scratchJ3;
     {
         BT_PROFILE("J3.resize");
         J3.resize(2*m,8);
     }
-    static btMatrixXu JinvM3;
+    btMatrixXu& JinvM3 = m_scratchJInvM3;
     {
         BT_PROFILE("JinvM3.resize/setZero");
         
@@ -189,7 +190,7 @@ void ResearchConstraintSolver::createMLCPFast(const btContactSolverInfo& infoGlo
     }
     int cur=0;
     int rowOffset = 0;
-    static btAlignedObjectArray<int> ofs;
+    btAlignedObjectArray<int>& ofs = m_scratchOfs;
     {
         BT_PROFILE("ofs resize");
         ofs.resize(0);
@@ -449,7 +450,7 @@ void ResearchConstraintSolver::createMLCP(const btContactSolverInfo& infoGlobal)
         }
     }
     
-    static btMatrixXu Minv;
+    btMatrixXu& Minv = m_scratchMInv;
     Minv.resize(6*numBodies,6*numBodies);
     Minv.setZero();
     for (int i=0;i<numBodies;i++)
@@ -466,7 +467,7 @@ void ResearchConstraintSolver::createMLCP(const btContactSolverInfo& infoGlobal)
                 setElem(Minv,i*6+3+r,i*6+3+c,orgBody? orgBody->getInvInertiaTensorWorld()[r][c] : 0);
     }
     
-    static btMatrixXu J;
+    btMatrixXu& J = m_scratchJ;
     J.resize(numConstraintRows,6*numBodies);
     J.setZero();
     
@@ -501,10 +502,10 @@ void ResearchConstraintSolver::createMLCP(const btContactSolverInfo& infoGlobal)
         }
     }
     
-    static btMatrixXu J_transpose;
+    btMatrixXu& J_transpose = m_scratchJTranspose;
     J_transpose= J.transpose();
     
-    static btMatrixXu tmp;
+    btMatrixXu& tmp = m_scratchTmp;
     
     {
         {
@@ -619,6 +620,7 @@ Scalar ResearchConstraintSolver::solveGroupCacheFriendlySetup(btCollisionObject*
     else
     {
         BT_PROFILE("createMLCPFast");
+        SF_PROFILE_SCOPE(m_profiler, StepPhase::MLCP);
         createMLCPFast(infoGlobal);
     }
     
@@ -631,7 +633,9 @@ Scalar ResearchConstraintSolver::solveGroupCacheFriendlyIterations(btCollisionOb
     
     //Try using MLCP solver
     BT_PROFILE("solveMLCP");
+    SF_PROFILE_BEGIN(m_profiler, StepPhase::MLCP);
     result = solveMLCP(infoGlobal);
+    SF_PROFILE_END(m_profiler, StepPhase::MLCP);
     
     //Check if solution is valid, and otherwise fallback to btSequentialImpulseConstraintSolver
     if(result)
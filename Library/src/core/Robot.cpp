@@ -36,6 +36,7 @@
 #include "sensors/scalar/JointSensor.h"
 #include "sensors/VisionSensor.h"
 #include "comms/Comm.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -87,13 +88,8 @@ void Robot::getFreeLinkPair(const std::string& parentName, const std::string& ch
 
 SolidEntity* Robot::getLink(const std::string& name)
 {
-    for(size_t i=0; i<links.size(); ++i)
-        if(links[i]->getName() == name) return links[i];
-    
-    for(size_t i=0; i<detachedLinks.size(); ++i)
-        if(detachedLinks[i]->getName() == name) return detachedLinks[i];
-    
-    return NULL;
+    auto it = linksByName.find(name);
+    return it == linksByName.end() ? NULL : it->second;
 }
 
 int Robot::getJoint(const std::string& name)
@@ -101,19 +97,14 @@ int Robot::getJoint(const std::string& name)
     if(dynamics == NULL)
         cCritical("Robot links not defined!");
     
-    for(unsigned int i=0; i<dynamics->getNumOfJoints(); ++i)
-        if(dynamics->getJointName(i) == name) return i;
-    
-    return -1;
+    auto it = jointIds.find(name);
+    return it == jointIds.end() ? -1 : it->second;
 }
     
 Actuator* Robot::getActuator(std::string name)
 {
-    for(size_t i=0; i<actuators.size(); ++i)
-        if(actuators[i]->getName() == name)
-            return actuators[i];
-
-    return NULL;
+    auto it = actuatorsByName.find(name);
+    return it == actuatorsByName.end() ? NULL : it->second;
 }
 
 Actuator* Robot::getActuator(unsigned int index)
@@ -126,11 +117,8 @@ Actuator* Robot::getActuator(unsigned int index)
     
 Sensor* Robot::getSensor(std::string name)
 {
-    for(size_t i=0; i<sensors.size(); ++i)
-        if(sensors[i]->getName() == name)
-            return sensors[i];
-    
-    return NULL;
+    auto it = sensorsByName.find(name);
+    return it == sensorsByName.end() ? NULL : it->second;
 }
 
 Sensor* Robot::getSensor(unsigned int index)
@@ -143,11 +131,8 @@ Sensor* Robot::getSensor(unsigned int index)
 
 Comm* Robot::getComm(std::string name)
 {
-    for(size_t i=0; i<comms.size(); ++i)
-        if(comms[i]->getName() == name)
-            return comms[i];
-    
-    return NULL;
+    auto it = commsByName.find(name);
+    return it == commsByName.end() ? NULL : it->second;
 }
 
 Comm* Robot::getComm(unsigned int index)
@@ -178,6 +163,9 @@ void Robot::DefineLinks(SolidEntity* baseLink, std::vector<SolidEntity*> otherLi
     
     links.push_back(baseLink);
     detachedLinks = otherLinks;
+    linksByName.insert({baseLink->getName(), baseLink});
+    for(size_t i=0; i<detachedLinks.size(); ++i)
+        linksByName.insert({detachedLinks[i]->getName(), detachedLinks[i]});
     dynamics = new FeatherstoneEntity(name + "_Dynamics", (unsigned short)detachedLinks.size() + 1, baseLink, fixed);
     dynamics->setSelfCollision(selfCollision);
 }
@@ -278,6 +266,7 @@ void Robot::BuildKinematicTree()
         links.push_back(detachedLinks[childId]);
         detachedLinks.erase(detachedLinks.begin()+childId);
         
+        unsigned int numOfJoints = dynamics->getNumOfJoints();
         switch(joints[i].jtype)
         {
             case 0: //FIXED
@@ -317,6 +306,9 @@ void Robot::BuildKinematicTree()
             default:
                 break;
         }
+        
+        if(dynamics->getNumOfJoints() > numOfJoints)
+            jointIds.insert({joints[i].name, (int)numOfJoints});
     }
 }
 
@@ -327,6 +319,7 @@ void Robot::AddLinkSensor(LinkSensor* s, const std::string& monitoredLinkName, c
     {
         s->AttachToSolid(link, origin);
         sensors.push_back(s);
+        sensorsByName.insert({s->getName(), s});
     }
     else
         cCritical("Link '%s' doesn't exist. Sensor '%s' cannot be attached!", monitoredLinkName.c_str(), s->getName().c_str());
@@ -339,6 +332,7 @@ void Robot::AddJointSensor(JointSensor* s, const std::string& monitoredJointName
     {
         s->AttachToJoint(dynamics, jointId);
         sensors.push_back(s);
+        sensorsByName.insert({s->getName(), s});
     }
     else
         cCritical("Joint '%s' doesn't exist. Sensor '%s' cannot be attached!", monitoredJointName.c_str(), s->getName().c_str());
@@ -351,6 +345,7 @@ void Robot::AddVisionSensor(VisionSensor* s, const std::string& attachmentLinkNa
     {
         s->AttachToSolid(link, origin);
         sensors.push_back(s);
+        sensorsByName.insert({s->getName(), s});
     }
     else
         cCritical("Link '%s' doesn't exist. Sensor '%s' cannot be attached!", attachmentLinkName.c_str(), s->getName().c_str());
@@ -363,6 +358,7 @@ void Robot::AddLinkActuator(LinkActuator* a, const std::string& actuatedLinkName
     {
         a->AttachToSolid(link, origin);
         actuators.push_back(a);
+        actuatorsByName.insert({a->getName(), a});
     }
     else
         cCritical("Link '%s' doesn't exist. Actuator '%s' cannot be attached!", actuatedLinkName.c_str(), a->getName().c_str());
@@ -375,6 +371,7 @@ void Robot::AddJointActuator(JointActuator* a, const std::string& actuatedJointN
     {
         a->AttachToJoint(dynamics, jointId);
         actuators.push_back(a);
+        actuatorsByName.insert({a->getName(), a});
     }
     else
         cCritical("Joint '%s' doesn't exist. Actuator '%s' cannot be attached!", actuatedJointName.c_str(), a->getName().c_str());
@@ -387,6 +384,7 @@ void Robot::AddComm(Comm* c, const std::string& attachmentLinkName, const Transf
     {
         c->AttachToSolid(link, origin);
         comms.push_back(c);
+        commsByName.insert({c->getName(), c});
     }
     else
         cCritical("Link '%s' doesn't exist. Communication device '%s' cannot be attached!", attachmentLinkName.c_str(), c->getName().c_str());
@@ -406,4 +404,30 @@ void Robot::AddToSimulation(SimulationManager* sm, const Transform& origin)
         sm->AddComm(comms[i]);
 }
 
+Robot* Robot::Clone(CloneContext& ctx)
+{
+    Robot* copy = new Robot(*this);
+    ctx.Remap(copy->dynamics);
+    for(size_t i = 0; i < copy->detachedLinks.size(); ++i)
+        ctx.Remap(copy->detachedLinks[i]);
+    for(size_t i = 0; i < copy->links.size(); ++i)
+        ctx.Remap(copy->links[i]);
+    for(size_t i = 0; i < copy->sensors.size(); ++i)
+        ctx.Remap(copy->sensors[i]);
+    for(size_t i = 0; i < copy->actuators.size(); ++i)
+        ctx.Remap(copy->actuators[i]);
+    for(size_t i = 0; i < copy->comms.size(); ++i)
+        ctx.Remap(copy->comms[i]);
+    for(auto it = copy->linksByName.begin(); it != copy->linksByName.end(); ++it)
+        ctx.Remap(it->second);
+    for(auto it = copy->sensorsByName.begin(); it != copy->sensorsByName.end(); ++it)
+        ctx.Remap(it->second);
+    for(auto it = copy->actuatorsByName.begin(); it != copy->actuatorsByName.end(); ++it)
+        ctx.Remap(it->second);
+    for(auto it = copy->commsByName.begin(); it != copy->commsByName.end(); ++it)
+        ctx.Remap(it->second);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
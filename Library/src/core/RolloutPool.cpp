@@ -0,0 +1,111 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RolloutPool.cpp
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/RolloutPool.h"
+
+#include <cmath>
+#include "core/AssetCache.h"
+#include "core/ConsoleSimulationApp.h"
+#include "core/SimulationManager.h"
+#include "core/ThreadPool.h"
+#include "core/Console.h"
+
+namespace sf
+{
+
+RolloutPool::RolloutPool(SimulationManager* source, unsigned int numOfClones, const std::function<SimulationManager*()>& factory, unsigned int numOfThreads)
+{
+    src = source;
+    srcApp = SimulationApp::getApp();
+    AssetCache::Acquire();
+    
+    for(unsigned int i=0; i<numOfClones; ++i)
+    {
+        //Each copy is hosted by a headless application, bound to the thread stepping it
+        SimulationManager* sm = factory();
+        SimulationApp* app = new ConsoleSimulationApp(srcApp->getName() + " (copy " + std::to_string(i) + ")", srcApp->getDataPath(), sm);
+        sm->setFixedStepMode(true);
+        if(!sm->CloneScenario(src))
+            cError("Rollout pool: source world could not be copied (copy %u)!", i);
+        clones.push_back(sm);
+        apps.push_back(app);
+    }
+    
+    srcApp->BindToThread();
+    pool = new ThreadPool(numOfThreads == 0 ? numOfClones : numOfThreads);
+}
+
+RolloutPool::~RolloutPool()
+{
+    delete pool;
+    for(size_t i=0; i<clones.size(); ++i)
+    {
+        apps[i]->BindToThread();
+        delete clones[i];
+        delete apps[i];
+    }
+    srcApp->BindToThread();
+    AssetCache::Release();
+}
+
+bool RolloutPool::Branch()
+{
+    std::vector<uint8_t> state = src->SaveState();
+    bool success = true;
+    for(size_t i=0; i<clones.size(); ++i)
+    {
+        apps[i]->BindToThread();
+        success &= clones[i]->RestoreState(state);
+    }
+    srcApp->BindToThread();
+    return success;
+}
+
+void RolloutPool::Rollout(Scalar duration, const std::function<void(unsigned int, SimulationManager*)>& control)
+{
+    pool->ParallelFor((unsigned int)clones.size(), [&](unsigned int i)
+    {
+        apps[i]->BindToThread();
+        if(control)
+            control(i, clones[i]);
+        clones[i]->StepSimulation((unsigned int)std::round(duration * clones[i]->getStepsPerSecond()));
+    });
+    srcApp->BindToThread();
+}
+
+SimulationManager* RolloutPool::getClone(unsigned int index)
+{
+    if(index < clones.size())
+        return clones[index];
+    else
+        return NULL;
+}
+
+unsigned int RolloutPool::getNumOfClones()
+{
+    return (unsigned int)clones.size();
+}
+
+}
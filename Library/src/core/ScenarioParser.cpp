@@ -40,6 +40,8 @@
 #include "entities/solids/Compound.h"
 #include "entities/forcefields/Uniform.h"
 #include "entities/forcefields/Jet.h"
+#include "entities/forcefields/GriddedCurrent.h"
+#include "entities/forcefields/Stream.h"
 #include "sensors/scalar/IMU.h"
 #include "sensors/scalar/DVL.h"
 #include "sensors/scalar/GPS.h"
@@ -80,7 +82,19 @@ SimulationManager* ScenarioParser::getSimulationManager()
     return sm;
 }
 
+XMLDocument* ScenarioParser::getDocument()
+{
+    return &doc;
+}
+
 bool ScenarioParser::Parse(std::string filename)
+{
+    if(!Load(filename))
+        return false;
+    return Build();
+}
+
+bool ScenarioParser::Load(const std::string& filename)
 {
     cInfo("Loading scenario from: %s", filename.c_str());
     
@@ -150,8 +164,21 @@ bool ScenarioParser::Parse(std::string filename)
         element = root->FirstChildElement("include");
     }
     
+    return true;
+}
+
+bool ScenarioParser::Build()
+{
+    //Find root node
+    XMLNode* root = doc.FirstChildElement("scenario");
+    if(root == nullptr)
+    {
+        cError("Scenario parser: root node not found!");
+        return false;
+    }
+    
     //Load environment settings
-    element = root->FirstChildElement("environment");
+    XMLElement* element = root->FirstChildElement("environment");
     if(element == nullptr)
     {
         cError("Scenario parser: environment settings not defined!");
@@ -370,6 +397,54 @@ bool ScenarioParser::ParseEnvironment(XMLElement* element)
                 Vector3 dir = velocity.normalized();
                 ocn->AddVelocityField(new Jet(Vector3(cx, cy, cz), dir, radius, velocity.norm()));
             }
+            else if(currentTypeStr == "gridded")
+            {
+                const char* file;
+                
+                if((item2 = item->FirstChildElement("data")) == nullptr)
+                    return false;
+                if(item2->QueryStringAttribute("file", &file) != XML_SUCCESS)
+                    return false;
+                
+                GriddedCurrent* gc = new GriddedCurrent(GetFullPath(std::string(file)));
+                if(!gc->isValid())
+                {
+                    delete gc;
+                    return false;
+                }
+                ocn->AddVelocityField(gc);
+            }
+            else if(currentTypeStr == "stream")
+            {
+                const char* point;
+                Scalar px, py, pz;
+                Scalar radius;
+                Scalar velocity, exponent;
+                std::vector<Vector3> streamline;
+                std::vector<Scalar> radii;
+                
+                for(item2 = item->FirstChildElement("point"); item2 != nullptr; item2 = item2->NextSiblingElement("point"))
+                {
+                    if(item2->QueryStringAttribute("xyz", &point) != XML_SUCCESS)
+                        return false;
+                    if(sscanf(point, "%lf %lf %lf", &px, &py, &pz) != 3)
+                        return false;
+                    if(item2->QueryAttribute("radius", &radius) != XML_SUCCESS)
+                        return false;
+                    streamline.push_back(Vector3(px, py, pz));
+                    radii.push_back(radius);
+                }
+                if(streamline.size() < 2)
+                    return false;
+                if((item2 = item->FirstChildElement("flow")) == nullptr)
+                    return false;
+                if(item2->QueryAttribute("velocity", &velocity) != XML_SUCCESS)
+                    return false;
+                if(item2->QueryAttribute("exponent", &exponent) != XML_SUCCESS)
+                    return false;
+                
+                ocn->AddVelocityField(new Stream(streamline, radii, velocity, exponent));
+            }
         }
         while((item = item->NextSiblingElement("current")) != nullptr);
     }
@@ -839,6 +914,13 @@ bool ScenarioParser::ParseSolid(XMLElement* element, SolidEntity*& solid, std::s
                 thickness = Scalar(-1);
             if((item2 = item->FirstChildElement("origin")) == nullptr || !ParseTransform(item2, phyOrigin))
                 return false;
+            unsigned int hydroFaces = 0;
+            Scalar hydroTolerance = Scalar(0);
+            if((item2 = item->FirstChildElement("hydro_mesh")) != nullptr)
+            {
+                item2->QueryAttribute("faces", &hydroFaces);
+                item2->QueryAttribute("tolerance", &hydroTolerance);
+            }
         
             if((item = element->FirstChildElement("visual")) != nullptr)
             {
@@ -861,6 +943,9 @@ bool ScenarioParser::ParseSolid(XMLElement* element, SolidEntity*& solid, std::s
             {
                 solid = new Polyhedron(solidName, GetFullPath(std::string(phyMesh)), phyScale, phyOrigin, std::string(mat), ePhyType, std::string(look), thickness, buoyant); 
             }
+            
+            if(hydroFaces > 0 || hydroTolerance > Scalar(0))
+                solid->SimplifyHydroMesh(hydroFaces, hydroTolerance);
         }
         else
             return false;
@@ -33,7 +33,7 @@ namespace sf
 
 SimulationApp::SimulationApp(std::string name, std::string dataDirPath, SimulationManager* sim)
 {
-    SimulationApp::handle = this;
+    BindToThread();
 	appName = name;
     dataPath = dataDirPath;
     simulation = sim;
@@ -50,8 +50,8 @@ SimulationApp::SimulationApp(std::string name, std::string dataDirPath, Simulati
 
 SimulationApp::~SimulationApp()
 {
-    if(SimulationApp::handle == this)
-        SimulationApp::handle = NULL;
+    if(SimulationApp::threadHandle == this)
+        SimulationApp::threadHandle = NULL;
 }
 
 SimulationManager* SimulationApp::getSimulationManager()
@@ -134,12 +134,17 @@ void SimulationApp::CleanUp()
 {
 }
 
+void SimulationApp::BindToThread()
+{
+    SimulationApp::threadHandle = this;
+}
+
 //Static
-SimulationApp* SimulationApp::handle = NULL;
+thread_local SimulationApp* SimulationApp::threadHandle = NULL;
 
 SimulationApp* SimulationApp::getApp()
 {
-    return SimulationApp::handle;
+    return SimulationApp::threadHandle;
 }
 
 }
@@ -33,6 +33,7 @@
 #include <BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h>
 #include <BulletCollision/Gimpact/btGImpactShape.h>
 #include <chrono>
+#include <map>
 #include <thread>
 #include "core/FilteredCollisionDispatcher.h"
 #include "core/GraphicalSimulationApp.h"
@@ -41,7 +42,11 @@
 #include "core/Robot.h"
 #include "core/ResearchConstraintSolver.h"
 #include "core/Console.h"
+#include "core/ContactInfoPool.h"
 #include "core/NED.h"
+#include "core/StateBuffer.h"
+#include "core/AssetCache.h"
+#include "core/CloneContext.h"
 #include "graphics/OpenGLState.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
@@ -74,10 +79,18 @@ extern ContactDestroyedCallback gContactDestroyedCallback;
 namespace sf
 {
 
+template<typename T> static T* FindByName(const std::unordered_map<std::string, T*>& registry, const std::string& name)
+{
+    auto it = registry.find(name);
+    return it == registry.end() ? NULL : it->second;
+}
+
 SimulationManager::SimulationManager(Scalar stepsPerSecond, SolverType st, CollisionFilteringType cft)
 {
     //Initialize simulation world
     realtimeFactor = Scalar(1);
+    fixedStep = false;
+    randomSeed = 0;
     cpuUsage = Scalar(0);
     solver = st;
     collisionFilter = cft;
@@ -95,9 +108,12 @@ SimulationManager::SimulationManager(Scalar stepsPerSecond, SolverType st, Colli
     atmosphere = NULL;
     trackball = NULL;
     sdm = DisplayMode::GRAPHICAL;
-    simHydroMutex = SDL_CreateMutex();
     simSettingsMutex = SDL_CreateMutex();
     simInfoMutex = SDL_CreateMutex();
+    profiler = new StepProfiler();
+    contactInfoPool = new ContactInfoPool();
+    threadPool = NULL;
+    sensorScheduleChanged = true;
     setStepsPerSecond(stepsPerSecond);
     
     //Set IC solver params
@@ -113,11 +129,13 @@ SimulationManager::SimulationManager(Scalar stepsPerSecond, SolverType st, Colli
 
 SimulationManager::~SimulationManager()
 {
-    DestroyScenario();
+    DestroyScenario(); //Releases contact data to the pool
     if(atmosphere != NULL) delete atmosphere;
     SDL_DestroyMutex(simSettingsMutex);
     SDL_DestroyMutex(simInfoMutex);
-    SDL_DestroyMutex(simHydroMutex);
+    delete profiler;
+    delete contactInfoPool;
+    if(threadPool != NULL) delete threadPool;
     delete materialManager;
     delete nameManager;
     delete ned;
@@ -135,15 +153,46 @@ void SimulationManager::AddRobot(Robot* robot, const Transform& worldTransform)
     if(robot != NULL)
     {
         robots.push_back(robot);
+        robotsByName.insert({robot->getName(), robot});
         robot->AddToSimulation(this, worldTransform);
     }
 }
 
+void SimulationManager::RegisterEntity(Entity* ent)
+{
+    entities.push_back(ent);
+    entitiesByName.insert({ent->getName(), ent});
+    
+    //Keep entities updated in the tick callbacks in separate arrays, so that static ones cost nothing
+    switch(ent->getType())
+    {
+        case EntityType::SOLID:
+            solidEntities.push_back((SolidEntity*)ent);
+            break;
+            
+        case EntityType::FEATHERSTONE:
+            featherstoneEntities.push_back((FeatherstoneEntity*)ent);
+            break;
+            
+        case EntityType::ANIMATED:
+            animatedEntities.push_back((AnimatedEntity*)ent);
+            break;
+            
+        case EntityType::FORCEFIELD:
+            if(((ForcefieldEntity*)ent)->getForcefieldType() == ForcefieldType::TRIGGER)
+                triggers.push_back((Trigger*)ent);
+            break;
+            
+        default:
+            break;
+    }
+}
+
 void SimulationManager::AddEntity(Entity *ent)
 {
     if(ent != NULL)
     {
-        entities.push_back(ent);
+        RegisterEntity(ent);
         ent->AddToSimulation(this);
     }
 }
@@ -152,7 +201,7 @@ void SimulationManager::AddStaticEntity(StaticEntity* ent, const Transform& orig
 {
     if(ent != NULL)
     {
-        entities.push_back(ent);
+        RegisterEntity(ent);
         ent->AddToSimulation(this, origin);
     }
 }
@@ -161,7 +210,7 @@ void SimulationManager::AddAnimatedEntity(AnimatedEntity* ent, const Transform&
 {
     if(ent != NULL)
     {
-        entities.push_back(ent);
+        RegisterEntity(ent);
         ent->AddToSimulation(this, origin);
     }
 }
@@ -170,7 +219,7 @@ void SimulationManager::AddSolidEntity(SolidEntity* ent, const Transform& origin
 {
     if(ent != NULL)
     {
-        entities.push_back(ent);
+        RegisterEntity(ent);
         ent->AddToSimulation(this, origin);
     }
 }
@@ -179,7 +228,7 @@ void SimulationManager::AddSolidEntity(SolidEntity* ent, const Transform& origin
  {
      if(ent != NULL)
      {
-         entities.push_back(ent);
+         RegisterEntity(ent);
          ent->AddToSimulation(this, origin);
      }
  }
@@ -200,9 +249,11 @@ void SimulationManager::EnableOcean(Scalar waves, Fluid f)
     
     if(SimulationApp::getApp()->hasGraphics())
     {
-        ocean->InitGraphics(simHydroMutex);
+        ocean->InitGraphics();
         ocean->setRenderable(true);
     }
+    else
+        ocean->InitWaveSimulation();
 }
     
 void SimulationManager::EnableAtmosphere()
@@ -226,13 +277,25 @@ void SimulationManager::EnableAtmosphere()
 void SimulationManager::AddSensor(Sensor* sens)
 {
     if(sens != NULL)
+    {
         sensors.push_back(sens);
+        sensorsByName.insert({sens->getName(), sens});
+        sensorScheduleChanged = true;
+    }
+}
+
+void SimulationManager::RescheduleSensors()
+{
+    sensorScheduleChanged = true;
 }
 
 void SimulationManager::AddComm(Comm* comm)
 {
     if(comm != NULL)
+    {
         comms.push_back(comm);
+        commsByName.insert({comm->getName(), comm});
+    }
 }
 
 void SimulationManager::AddJoint(Joint* jnt)
@@ -240,6 +303,7 @@ void SimulationManager::AddJoint(Joint* jnt)
     if(jnt != NULL)
     {
         joints.push_back(jnt);
+        jointsByName.insert({jnt->getName(), jnt});
         jnt->AddToSimulation(this);
     }
 }
@@ -247,7 +311,10 @@ void SimulationManager::AddJoint(Joint* jnt)
 void SimulationManager::AddActuator(Actuator *act)
 {
     if(act != NULL)
+    {
         actuators.push_back(act);
+        actuatorsByName.insert({act->getName(), act});
+    }
 }
 
 void SimulationManager::AddContact(Contact* cnt)
@@ -255,20 +322,37 @@ void SimulationManager::AddContact(Contact* cnt)
     if(cnt != NULL)
     {
         contacts.push_back(cnt);
+        contactsByName.insert({cnt->getName(), cnt});
+        contactsByPair.insert({MakeEntityPair(cnt->getEntityA(), cnt->getEntityB()), cnt}); //First contact defined for the pair is used
         EnableCollision(cnt->getEntityA(), cnt->getEntityB());
     }
 }
 
 int SimulationManager::CheckCollision(const Entity *entA, const Entity *entB)
 {
-    for(size_t i = 0; i < collisions.size(); ++i)
+    auto it = collisionIds.find(MakeEntityPair(entA, entB));
+    return it == collisionIds.end() ? -1 : (int)it->second;
+}
+
+void SimulationManager::AddCollisionRule(const Entity* entA, const Entity* entB)
+{
+    Collision c;
+    c.A = const_cast<Entity*>(entA);
+    c.B = const_cast<Entity*>(entB);
+    collisionIds[MakeEntityPair(entA, entB)] = collisions.size();
+    collisions.push_back(c);
+}
+
+void SimulationManager::RemoveCollisionRule(int colId)
+{
+    //Move the last rule in place of the removed one, to keep the ids dense
+    collisionIds.erase(MakeEntityPair(collisions[colId].A, collisions[colId].B));
+    if(colId < (int)collisions.size()-1)
     {
-        if((collisions[i].A == entA && collisions[i].B == entB) 
-            || (collisions[i].B == entA && collisions[i].A == entB))
-                return (int)i;
+        collisions[colId] = collisions.back();
+        collisionIds[MakeEntityPair(collisions[colId].A, collisions[colId].B)] = colId;
     }
-    
-    return -1;
+    collisions.pop_back();
 }
 
 void SimulationManager::EnableCollision(const Entity* entA, const Entity* entB)
@@ -276,16 +360,9 @@ void SimulationManager::EnableCollision(const Entity* entA, const Entity* entB)
     int colId = CheckCollision(entA, entB);
     
     if(collisionFilter == CollisionFilteringType::COLLISION_INCLUSIVE && colId == -1)
-    {
-        Collision c;
-        c.A = const_cast<Entity*>(entA);
-        c.B = const_cast<Entity*>(entB);
-        collisions.push_back(c);
-    }
+        AddCollisionRule(entA, entB);
     else if(collisionFilter == CollisionFilteringType::COLLISION_EXCLUSIVE && colId > -1)
-    {
-        collisions.erase(collisions.begin() + colId);
-    }
+        RemoveCollisionRule(colId);
 }
     
 void SimulationManager::DisableCollision(const Entity* entA, const Entity* entB)
@@ -293,35 +370,15 @@ void SimulationManager::DisableCollision(const Entity* entA, const Entity* entB)
     int colId = CheckCollision(entA, entB);
     
     if(collisionFilter == CollisionFilteringType::COLLISION_EXCLUSIVE && colId == -1)
-    {
-        Collision c;
-        c.A = const_cast<Entity*>(entA);
-        c.B = const_cast<Entity*>(entB);
-        collisions.push_back(c);
-    }
+        AddCollisionRule(entA, entB);
     else if(collisionFilter == CollisionFilteringType::COLLISION_INCLUSIVE && colId > -1)
-    {
-        collisions.erase(collisions.begin() + colId);
-    }
+        RemoveCollisionRule(colId);
 }
 
 Contact* SimulationManager::getContact(Entity* entA, Entity* entB)
 {
-    for(size_t i = 0; i < contacts.size(); ++i)
-    {
-        if(contacts[i]->getEntityA() == entA)
-        {
-            if(contacts[i]->getEntityB() == entB)
-                return contacts[i];
-        }
-        else if(contacts[i]->getEntityB() == entA)
-        {
-            if(contacts[i]->getEntityA() == entB)
-                return contacts[i];
-        }
-    }
-    
-    return NULL;
+    auto it = contactsByPair.find(MakeEntityPair(entA, entB));
+    return it == contactsByPair.end() ? NULL : it->second;
 }
 
 Contact* SimulationManager::getContact(unsigned int index)
@@ -334,11 +391,7 @@ Contact* SimulationManager::getContact(unsigned int index)
 
 Contact* SimulationManager::getContact(const std::string& name)
 {
-    for(size_t i = 0; i < contacts.size(); ++i)
-        if(contacts[i]->getName() == name)
-            return contacts[i];
-    
-    return NULL;
+    return FindByName(contactsByName, name);
 }
 
 CollisionFilteringType SimulationManager::getCollisionFilter()
@@ -361,11 +414,7 @@ Robot* SimulationManager::getRobot(unsigned int index)
 
 Robot* SimulationManager::getRobot(const std::string& name)
 {
-    for(size_t i = 0; i < robots.size(); ++i)
-        if(robots[i]->getName() == name)
-            return robots[i];
-    
-    return NULL;
+    return FindByName(robotsByName, name);
 }
 
 Entity* SimulationManager::getEntity(unsigned int index)
@@ -378,11 +427,7 @@ Entity* SimulationManager::getEntity(unsigned int index)
 
 Entity* SimulationManager::getEntity(const std::string& name)
 {
-    for(size_t i = 0; i < entities.size(); ++i)
-        if(entities[i]->getName() == name)
-            return entities[i];
-    
-    return NULL;
+    return FindByName(entitiesByName, name);
 }
 
 Joint* SimulationManager::getJoint(unsigned int index)
@@ -395,11 +440,7 @@ Joint* SimulationManager::getJoint(unsigned int index)
 
 Joint* SimulationManager::getJoint(const std::string& name)
 {
-    for(size_t i = 0; i < joints.size(); ++i)
-        if(joints[i]->getName() == name)
-            return joints[i];
-    
-    return NULL;
+    return FindByName(jointsByName, name);
 }
 
 Actuator* SimulationManager::getActuator(unsigned int index)
@@ -412,11 +453,7 @@ Actuator* SimulationManager::getActuator(unsigned int index)
 
 Actuator* SimulationManager::getActuator(const std::string& name)
 {
-    for(size_t i = 0; i < actuators.size(); ++i)
-        if(actuators[i]->getName() == name)
-            return actuators[i];
-    
-    return NULL;
+    return FindByName(actuatorsByName, name);
 }
 
 Sensor* SimulationManager::getSensor(unsigned int index)
@@ -429,11 +466,7 @@ Sensor* SimulationManager::getSensor(unsigned int index)
 
 Sensor* SimulationManager::getSensor(const std::string& name)
 {
-    for(size_t i = 0; i < sensors.size(); ++i)
-        if(sensors[i]->getName() == name)
-            return sensors[i];
-    
-    return NULL;
+    return FindByName(sensorsByName, name);
 }
 
 Comm* SimulationManager::getComm(unsigned int index)
@@ -446,11 +479,7 @@ Comm* SimulationManager::getComm(unsigned int index)
 
 Comm* SimulationManager::getComm(const std::string& name)
 {
-    for(size_t i = 0; i < comms.size(); ++i)
-        if(comms[i]->getName() == name)
-            return comms[i];
-    
-    return NULL;
+    return FindByName(commsByName, name);
 }
 
 NED* SimulationManager::getNED()
@@ -521,6 +550,67 @@ void SimulationManager::setRealtimeFactor(Scalar f)
     SDL_UnlockMutex(simInfoMutex);
 }
 
+void SimulationManager::setFixedStepMode(bool enabled)
+{
+    SDL_LockMutex(simSettingsMutex);
+    fixedStep = enabled;
+    currentTime = 0;
+    SDL_UnlockMutex(simSettingsMutex);
+}
+
+bool SimulationManager::isFixedStepMode()
+{
+    return fixedStep;
+}
+
+void SimulationManager::setNumOfWorkerThreads(unsigned int n)
+{
+    SDL_LockMutex(simSettingsMutex);
+    if(threadPool != NULL)
+    {
+        delete threadPool;
+        threadPool = NULL;
+    }
+    if(n > 1)
+        threadPool = new ThreadPool(n);
+    SDL_UnlockMutex(simSettingsMutex);
+}
+
+unsigned int SimulationManager::getNumOfWorkerThreads()
+{
+    return threadPool != NULL ? threadPool->getNumOfThreads() : 1;
+}
+
+void SimulationManager::setRandomSeed(uint32_t seed)
+{
+    randomSeed = seed;
+    for(size_t i=0; i<sensors.size(); ++i)
+        sensors[i]->setRandomSeed(DeriveRandomSeed(sensors[i]->getName()));
+}
+
+uint32_t SimulationManager::getRandomSeed() const
+{
+    return randomSeed;
+}
+
+uint32_t SimulationManager::DeriveRandomSeed(const std::string& key) const
+{
+    //FNV-1a hash of the key, mixed with the simulation seed (independent of the platform, unlike std::hash)
+    uint32_t h = 2166136261u ^ randomSeed;
+    for(size_t i=0; i<key.size(); ++i)
+    {
+        h ^= (uint8_t)key[i];
+        h *= 16777619u;
+    }
+    //Final avalanche, so that similar names give unrelated seeds
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
 Scalar SimulationManager::getStepsPerSecond()
 {
     return sps;
@@ -542,6 +632,15 @@ Scalar SimulationManager::getCpuUsage()
     return cpu;
 }
 
+StepProfile SimulationManager::getStepProfile()
+{
+    StepProfile profile = profiler->getProfile();
+    profile.contactsInUse = contactInfoPool->getNumOfUsedBlocks();
+    profile.contactsHighWater = contactInfoPool->getHighWaterMark();
+    profile.contactsCapacity = contactInfoPool->getCapacity();
+    return profile;
+}
+
 Scalar SimulationManager::getRealtimeFactor()
 {
     SDL_LockMutex(simInfoMutex);
@@ -627,11 +726,11 @@ void SimulationManager::InitializeSolver()
     switch(collisionFilter)
     {
         case CollisionFilteringType::COLLISION_INCLUSIVE:
-            dwDispatcher = new FilteredCollisionDispatcher(dwCollisionConfig, true);
+            dwDispatcher = new FilteredCollisionDispatcher(dwCollisionConfig, this, true, profiler);
             break;
 
         case CollisionFilteringType::COLLISION_EXCLUSIVE:
-            dwDispatcher = new FilteredCollisionDispatcher(dwCollisionConfig, false);
+            dwDispatcher = new FilteredCollisionDispatcher(dwCollisionConfig, this, false, profiler);
             break;
     }
     
@@ -661,7 +760,7 @@ void SimulationManager::InitializeSolver()
                 break;
         }
         
-        dwSolver = new ResearchConstraintSolver(mlcp);
+        dwSolver = new ResearchConstraintSolver(mlcp, profiler);
     }
     
     //Create dynamics world
@@ -706,6 +805,7 @@ void SimulationManager::InitializeSolver()
     //Override default callbacks
     dynamicsWorld->setWorldUserInfo(this);
     dynamicsWorld->getPairCache()->setInternalGhostPairCallback(new btGhostPairCallback());
+    //Bullet callbacks are global but shared by all simulation managers (they resolve the manager through the dispatcher of the world)
     gContactAddedCallback = SimulationManager::CustomMaterialCombinerCallback; //Compute combined friction and restitution
     //gContactProcessedCallback = SimulationManager::ContactInfoUpdateCallback; //Update user data
     gContactDestroyedCallback = SimulationManager::ContactInfoDestroyCallback; //Clear user data allocated in contact points
@@ -751,6 +851,113 @@ void SimulationManager::RestartScenario()
     simulationFresh = true;
 }
 
+bool SimulationManager::CloneScenario(SimulationManager* source)
+{
+    if(SimulationApp::getApp()->hasGraphics())
+    {
+        cError("Scenario can only be cloned in a simulation without graphics!");
+        return false;
+    }
+    
+    DestroyScenario();
+    
+    //Copy settings
+    solver = source->solver;
+    collisionFilter = source->collisionFilter;
+    setStepsPerSecond(source->sps);
+    setICSolverParams(source->icUseGravity, source->icTimeStep, source->icMaxIter, source->icMaxTime, source->icLinTolerance, source->icAngTolerance);
+    randomSeed = source->randomSeed;
+    sdm = source->sdm;
+    *nameManager = *source->nameManager;
+    *materialManager = *source->materialManager;
+    *ned = *source->ned;
+    InitializeSolver();
+    g = source->g;
+    
+    //Copy objects in the order of their dependencies
+    CloneContext ctx(this);
+    bool success = true;
+    
+    if(source->ocean != NULL)
+    {
+        ocean = (Ocean*)source->ocean->Clone(ctx);
+        success &= ocean != NULL;
+    }
+    
+    if(source->atmosphere != NULL)
+    {
+        atmosphere = (Atmosphere*)source->atmosphere->Clone(ctx);
+        success &= atmosphere != NULL;
+    }
+    
+    for(size_t i=0; i<source->entities.size(); ++i)
+    {
+        Entity* ent = source->entities[i]->Clone(ctx);
+        if(ent != NULL)
+            RegisterEntity(ent);
+        else
+            success = false;
+    }
+    
+    if(!success)
+    {
+        cError("Scenario contains entities which cannot be cloned!");
+        return false;
+    }
+    
+    for(size_t i=0; i<source->joints.size(); ++i)
+    {
+        Joint* jnt = source->joints[i]->Clone(ctx);
+        success &= jnt != NULL;
+        AddJoint(jnt);
+    }
+    
+    for(size_t i=0; i<source->actuators.size(); ++i)
+    {
+        Actuator* act = source->actuators[i]->Clone(ctx);
+        success &= act != NULL;
+        AddActuator(act);
+    }
+    
+    for(size_t i=0; i<source->sensors.size(); ++i)
+    {
+        Sensor* sens = source->sensors[i]->Clone(ctx);
+        success &= sens != NULL;
+        AddSensor(sens);
+    }
+    
+    for(size_t i=0; i<source->comms.size(); ++i)
+    {
+        Comm* comm = source->comms[i]->Clone(ctx);
+        success &= comm != NULL;
+        AddComm(comm);
+    }
+    
+    for(size_t i=0; i<source->contacts.size(); ++i)
+        AddContact(source->contacts[i]->Clone(ctx));
+    
+    for(size_t i=0; i<source->robots.size(); ++i)
+    {
+        Robot* robot = source->robots[i]->Clone(ctx);
+        robots.push_back(robot);
+        robotsByName.insert({robot->getName(), robot});
+    }
+    
+    if(!success || !ctx.Resolve())
+    {
+        cError("Scenario contains joints, actuators, sensors or comms which cannot be cloned!");
+        return false;
+    }
+    
+    //Collision rules are copied as they are (adding contacts modifies them)
+    collisions.clear();
+    collisionIds.clear();
+    for(size_t i=0; i<source->collisions.size(); ++i)
+        AddCollisionRule(ctx.getCopy(source->collisions[i].A), ctx.getCopy(source->collisions[i].B));
+    
+    return StartSimulation(source->SaveState());
+}
+
 void SimulationManager::DestroyScenario()
 {
     if(dynamicsWorld != NULL)
@@ -770,6 +977,7 @@ void SimulationManager::DestroyScenario()
             if (body && body->getMotionState())
                 delete body->getMotionState();
             dynamicsWorld->removeCollisionObject(obj);
+            AssetCache::ReleaseShape(obj->getCollisionShape()); //Shapes can be shared with cloned worlds
             delete obj;
         }
     
@@ -785,10 +993,18 @@ void SimulationManager::DestroyScenario()
     for(size_t i=0; i<robots.size(); ++i)
         delete robots[i];
     robots.clear();
+    robotsByName.clear();
     
     for(size_t i=0; i<entities.size(); ++i)
         delete entities[i];
     entities.clear();
+    entitiesByName.clear();
+    solidEntities.clear();
+    featherstoneEntities.clear();
+    animatedEntities.clear();
+    triggers.clear();
+    collisions.clear();
+    collisionIds.clear();
     
     if(ocean != NULL)
     {
@@ -805,22 +1021,30 @@ void SimulationManager::DestroyScenario()
     for(size_t i=0; i<joints.size(); ++i)
         delete joints[i];
     joints.clear();
+    jointsByName.clear();
     
     for(size_t i=0; i<contacts.size(); ++i)
         delete contacts[i];
     contacts.clear();
+    contactsByName.clear();
+    contactsByPair.clear();
     
     for(size_t i=0; i<sensors.size(); ++i)
         delete sensors[i];
     sensors.clear();
+    sensorsByName.clear();
+    sensorQueue = std::priority_queue<SensorDeadline, std::vector<SensorDeadline>, std::greater<SensorDeadline>>();
+    sensorScheduleChanged = true;
     
     for(size_t i=0; i<comms.size(); ++i)
         delete comms[i];
     comms.clear();
+    commsByName.clear();
     
     for(size_t i=0; i<actuators.size(); ++i)
         delete actuators[i];
     actuators.clear();
+    actuatorsByName.clear();
     
     if(nameManager != NULL)
         nameManager->ClearNames();
@@ -843,6 +1067,7 @@ bool SimulationManager::StartSimulation()
     simulationTime = 0;
     mlcpFallbacks = 0;
     fdCounter = 0;
+    profiler->Reset();
     
     //Solve initial conditions problem
     if(!SolveICProblem())
@@ -855,7 +1080,39 @@ bool SimulationManager::StartSimulation()
     //Reset sensors
     for(unsigned int i = 0; i < sensors.size(); i++)
         sensors[i]->Reset();
+    sensorQueue = std::priority_queue<SensorDeadline, std::vector<SensorDeadline>, std::greater<SensorDeadline>>();
+    sensorScheduleChanged = true;
+    
+    return true;
+}
+
+bool SimulationManager::StartSimulation(const std::vector<uint8_t>& state)
+{
+    simulationFresh = false;
+    currentTime = 0;
+    physicsTime = 0;
+    simulationTime = 0;
+    mlcpFallbacks = 0;
+    fdCounter = 0;
+    profiler->Reset();
+    
+    //Initial conditions are taken from the state
+    dynamicsWorld->setGravity(Vector3(0,0,g));
+    dynamicsWorld->setInternalTickCallback(SimulationTickCallback, this, true); //Pre-tick
+    dynamicsWorld->setInternalTickCallback(SimulationPostTickCallback, this, false); //Post-tick
+    icProblemSolved = true;
+    
+    for(unsigned int i = 0; i < sensors.size(); i++)
+        sensors[i]->Reset();
+    sensorQueue = std::priority_queue<SensorDeadline, std::vector<SensorDeadline>, std::greater<SensorDeadline>>();
+    sensorScheduleChanged = true;
     
+    if(!RestoreState(state))
+    {
+        icProblemSolved = false;
+        return false;
+    }
+    dynamicsWorld->synchronizeMotionStates();
     return true;
 }
 
@@ -931,6 +1188,13 @@ void SimulationManager::AdvanceSimulation()
     //Check if initial conditions solved
     if(!icProblemSolved)
         return;
+    
+    //Run without synchronization to real time
+    if(fixedStep)
+    {
+        StepSimulation(1);
+        return;
+    }
         
     //Calculate eleapsed time
     uint64_t timeInMicroseconds = GetTimeInMicroseconds();
@@ -973,6 +1237,149 @@ void SimulationManager::AdvanceSimulation()
     realtimeFactor = realtimeFactor < Scalar(0.05) ? Scalar(0.05) : (realtimeFactor > Scalar(1) ? Scalar(1) : realtimeFactor);*/
     //realtimeFactor = Scalar(1);
     
+    CheckSolverFallbacks();
+    SDL_UnlockMutex(simInfoMutex);
+}
+
+void SimulationManager::StepSimulation(unsigned int nSteps)
+{
+    //Check if initial conditions solved
+    if(!icProblemSolved || nSteps == 0)
+        return;
+    
+    //Step simulation with a constant time step (no interpolation of motion states)
+    SDL_LockMutex(simSettingsMutex);
+    Scalar dt = Scalar(1)/sps;
+    uint64_t physicsStart = GetTimeInMicroseconds();
+    for(unsigned int i = 0; i < nSteps; ++i)
+        dynamicsWorld->stepSimulation(dt, 0, dt);
+    uint64_t physicsEnd = GetTimeInMicroseconds();
+    SDL_UnlockMutex(simSettingsMutex);
+    
+    SDL_LockMutex(simInfoMutex);
+    physicsTime = physicsEnd - physicsStart;
+    cpuUsage = Scalar(physicsTime)/(Scalar(nSteps) * dt * Scalar(1000000.0)) * Scalar(100); //Percent of real time needed
+    CheckSolverFallbacks();
+    SDL_UnlockMutex(simInfoMutex);
+}
+
+std::vector<uint8_t> SimulationManager::SaveState()
+{
+    SDL_LockMutex(simSettingsMutex);
+    StateBuffer state;
+    
+    //Header used to check if the state matches the world
+    state.Write((uint32_t)0x53465753); //"SFWS"
+    state.Write((uint32_t)entities.size());
+    state.Write((uint32_t)actuators.size());
+    state.Write((uint32_t)sensors.size());
+    state.Write((uint32_t)comms.size());
+    
+    state.Write(simulationTime);
+    state.Write((uint32_t)fdCounter);
+    
+    //Sensor schedule
+    std::map<Sensor*, uint32_t> sensorIds;
+    for(size_t i=0; i<sensors.size(); ++i)
+        sensorIds[sensors[i]] = (uint32_t)i;
+    state.Write(sensorScheduleChanged.load());
+    state.Write((uint32_t)sensorQueue.size());
+    for(std::priority_queue<SensorDeadline, std::vector<SensorDeadline>, std::greater<SensorDeadline>> q = sensorQueue; !q.empty(); q.pop())
+    {
+        state.Write(sensorIds[q.top().sensor]);
+        state.Write(q.top().time);
+        state.Write(q.top().period);
+    }
+    
+    for(size_t i=0; i<entities.size(); ++i)
+        entities[i]->SaveState(state);
+    for(size_t i=0; i<actuators.size(); ++i)
+        actuators[i]->SaveState(state);
+    for(size_t i=0; i<sensors.size(); ++i)
+        sensors[i]->SaveState(state);
+    for(size_t i=0; i<comms.size(); ++i)
+        comms[i]->SaveState(state);
+    
+    SDL_UnlockMutex(simSettingsMutex);
+    return state.getBytes();
+}
+
+bool SimulationManager::RestoreState(const std::vector<uint8_t>& bytes)
+{
+    if(!icProblemSolved)
+    {
+        cError("Simulation state can only be restored after the simulation was started!");
+        return false;
+    }
+    
+    StateBuffer state(bytes);
+    uint32_t magic, nEntities, nActuators, nSensors, nComms;
+    state.Read(magic);
+    state.Read(nEntities);
+    state.Read(nActuators);
+    state.Read(nSensors);
+    state.Read(nComms);
+    if(!state.isValid() || magic != 0x53465753 || nEntities != entities.size() 
+       || nActuators != actuators.size() || nSensors != sensors.size() || nComms != comms.size())
+    {
+        cError("Simulation state does not match the simulation world!");
+        return false;
+    }
+    
+    SDL_LockMutex(simSettingsMutex);
+    uint32_t n;
+    state.Read(simulationTime);
+    state.Read(n);
+    fdCounter = n;
+    
+    //Sensor schedule
+    bool changed;
+    state.Read(changed);
+    sensorScheduleChanged = changed;
+    state.Read(n);
+    sensorQueue = std::priority_queue<SensorDeadline, std::vector<SensorDeadline>, std::greater<SensorDeadline>>();
+    for(uint32_t i=0; i<n; ++i)
+    {
+        uint32_t id;
+        SensorDeadline d;
+        state.Read(id);
+        state.Read(d.time);
+        state.Read(d.period);
+        if(id >= sensors.size())
+            break;
+        d.sensor = sensors[id];
+        sensorQueue.push(d);
+    }
+    
+    for(size_t i=0; i<entities.size(); ++i)
+        entities[i]->RestoreState(state);
+    for(size_t i=0; i<actuators.size(); ++i)
+        actuators[i]->RestoreState(state);
+    for(size_t i=0; i<sensors.size(); ++i)
+        sensors[i]->RestoreState(state);
+    for(size_t i=0; i<comms.size(); ++i)
+        comms[i]->RestoreState(state);
+    
+    //Clear cached contact points, which refer to the previous configuration
+    btDispatcher* dispatcher = dynamicsWorld->getDispatcher();
+    for(int i=0; i<dispatcher->getNumManifolds(); ++i)
+        dispatcher->getManifoldByIndexInternal(i)->clearManifold();
+    for(size_t i=0; i<contacts.size(); ++i)
+        contacts[i]->ClearHistory();
+    
+    currentTime = 0; //Resynchronize with real time
+    SDL_UnlockMutex(simSettingsMutex);
+    
+    if(!state.isValid() || !state.isAtEnd())
+    {
+        cError("Simulation state corrupted!");
+        return false;
+    }
+    return true;
+}
+
+void SimulationManager::CheckSolverFallbacks()
+{
     //Inform about MLCP failures
     if(solver != SolverType::SOLVER_SI)
     {
@@ -986,8 +1393,66 @@ void SimulationManager::AdvanceSimulation()
         }
         ((ResearchConstraintSolver*)dwSolver)->resetNumFallbacks();
     }
+}
+
+void SimulationManager::UpdateSensors(Scalar dt)
+{
+    //Rebuild the schedule, keeping the deadlines of the sensors whose rate did not change
+    if(sensorScheduleChanged.exchange(false))
+    {
+        std::map<Sensor*, SensorDeadline> scheduled;
+        for(; !sensorQueue.empty(); sensorQueue.pop())
+            scheduled[sensorQueue.top().sensor] = sensorQueue.top();
+        
+        tickSensors.clear();
+        for(size_t i=0; i<sensors.size(); ++i)
+        {
+            Scalar f = sensors[i]->getUpdateFrequency();
+            if(f <= Scalar(0))
+            {
+                tickSensors.push_back(sensors[i]);
+                continue;
+            }
+            
+            SensorDeadline d;
+            d.sensor = sensors[i];
+            d.period = Scalar(1)/f;
+            d.time = simulationTime + d.period;
+            
+            std::map<Sensor*, SensorDeadline>::iterator it = scheduled.find(sensors[i]);
+            if(it != scheduled.end() && it->second.period == d.period)
+                d.time = it->second.time;
+            sensorQueue.push(d);
+        }
+    }
     
-    SDL_UnlockMutex(simInfoMutex);
+    //Collect sensors updated every tick and the ones that are due
+    Scalar now = simulationTime + dt + dt*Scalar(1e-3); //Tolerance for the accumulated time error
+    dueSensors.clear();
+    for(size_t i=0; i<tickSensors.size(); ++i)
+    {
+        SensorDeadline d;
+        d.sensor = tickSensors[i];
+        d.period = dt;
+        d.time = now;
+        dueSensors.push_back(d);
+    }
+    size_t numTick = dueSensors.size();
+    for(; !sensorQueue.empty() && sensorQueue.top().time <= now; sensorQueue.pop())
+        dueSensors.push_back(sensorQueue.top());
+    
+    //Update sensors (in parallel, sensors are independent and have own noise generators)
+    if(threadPool != NULL)
+        threadPool->ParallelFor((unsigned int)dueSensors.size(), [&](unsigned int i){ dueSensors[i].sensor->TriggerUpdate(dueSensors[i].period); });
+    else
+        for(size_t i=0; i<dueSensors.size(); ++i) dueSensors[i].sensor->TriggerUpdate(dueSensors[i].period);
+    
+    //Schedule next updates (at most one update per tick, like in the case of Sensor::Update)
+    for(size_t i=numTick; i<dueSensors.size(); ++i)
+    {
+        dueSensors[i].time += dueSensors[i].period;
+        sensorQueue.push(dueSensors[i]);
+    }
 }
 
 void SimulationManager::SimulationStepCompleted(Scalar timeStep)
@@ -1063,6 +1528,52 @@ Entity* SimulationManager::PickEntity(Vector3 eye, Vector3 ray)
         return nullptr;
 }
 
+void SimulationManager::RayTest(const Vector3& from, const Vector3& to, btCollisionWorld::RayResultCallback& result)
+{
+    //Equivalent of btCollisionWorld::rayTest, which uses a traversal stack shared by all calls
+    struct RayTester : public btDbvt::ICollide
+    {
+        Transform rayFrom;
+        Transform rayTo;
+        btCollisionWorld::RayResultCallback& callback;
+        
+        RayTester(const Vector3& f, const Vector3& t, btCollisionWorld::RayResultCallback& cb) 
+            : rayFrom(Quaternion::getIdentity(), f), rayTo(Quaternion::getIdentity(), t), callback(cb) {}
+        
+        void Process(const btDbvtNode* leaf)
+        {
+            if(callback.m_closestHitFraction == Scalar(0))
+                return;
+            
+            btCollisionObject* co = (btCollisionObject*)((btBroadphaseProxy*)leaf->data)->m_clientObject;
+            if(callback.needsCollision(co->getBroadphaseHandle()))
+                btCollisionWorld::rayTestSingle(rayFrom, rayTo, co, co->getCollisionShape(), co->getWorldTransform(), callback);
+        }
+    };
+    
+    static thread_local btAlignedObjectArray<const btDbvtNode*> stack;
+    
+    Vector3 dir = to - from;
+    Scalar length = dir.length();
+    if(length < SIMD_EPSILON)
+        return;
+    dir /= length;
+    
+    Vector3 invDir;
+    unsigned int signs[3];
+    for(int i=0; i<3; ++i)
+    {
+        invDir[i] = dir[i] == Scalar(0) ? Scalar(BT_LARGE_FLOAT) : Scalar(1)/dir[i];
+        signs[i] = invDir[i] < Scalar(0);
+    }
+    
+    RayTester tester(from, to, result);
+    btDbvtBroadphase* bp = (btDbvtBroadphase*)dwBroadphase;
+    for(int i=0; i<2; ++i) //Dynamic and static sets
+        if(bp->m_sets[i].m_root != NULL)
+            bp->m_sets[i].rayTestInternal(bp->m_sets[i].m_root, from, to, invDir, signs, length, V0(), V0(), stack, tester);
+}
+
 void SimulationManager::RenderBulletDebug()
 {
     dynamicsWorld->debugDrawWorld();
@@ -1091,8 +1602,9 @@ bool SimulationManager::CustomMaterialCombinerCallback(btManifoldPoint& cp,	cons
 {
     Entity* ent0 = (Entity*)colObj0Wrap->getCollisionObject()->getUserPointer();
     Entity* ent1 = (Entity*)colObj1Wrap->getCollisionObject()->getUserPointer();
+    SimulationManager* sm = FilteredCollisionDispatcher::getDispatchingManager(); //The callback does not receive the world
     
-    if(ent0 == NULL || ent1 == NULL)
+    if(ent0 == NULL || ent1 == NULL || sm == NULL)
     {
         cp.m_combinedFriction = Scalar(0.);
         cp.m_combinedRollingFriction = Scalar(0.);
@@ -1100,16 +1612,16 @@ bool SimulationManager::CustomMaterialCombinerCallback(btManifoldPoint& cp,	cons
         return true;
     }
     
-    MaterialManager* mm = SimulationApp::getApp()->getSimulationManager()->getMaterialManager();
+    MaterialManager* mm = sm->getMaterialManager();
     
-    Material mat0;
+    const Material* mat0;
     Vector3 contactVelocity0;
     Scalar contactAngularVelocity0;
     
     if(ent0->getType() == EntityType::STATIC)
     {
         StaticEntity* sent0 = (StaticEntity*)ent0;
-        mat0 = sent0->getMaterial();
+        mat0 = &sent0->getMaterial();
         contactVelocity0.setZero();
         contactAngularVelocity0 = Scalar(0);
     }
@@ -1117,9 +1629,9 @@ bool SimulationManager::CustomMaterialCombinerCallback(btManifoldPoint& cp,	cons
     {
         SolidEntity* sent0 = (SolidEntity*)ent0;
         if(sent0->getSolidType() == SolidType::COMPOUND)
-            mat0 = ((Compound*)sent0)->getMaterial(((Compound*)sent0)->getPartId(index0));
+            mat0 = &((Compound*)sent0)->getMaterial(((Compound*)sent0)->getPartId(index0));
         else
-            mat0 = sent0->getMaterial();
+            mat0 = &sent0->getMaterial();
         //Vector3 localPoint0 = sent0->getTransform().getBasis() * cp.m_localPointA;
         Vector3 localPoint0 = sent0->getCGTransform().inverse() * cp.getPositionWorldOnA();
         contactVelocity0 = sent0->getLinearVelocityInLocalPoint(localPoint0);
@@ -1133,14 +1645,14 @@ bool SimulationManager::CustomMaterialCombinerCallback(btManifoldPoint& cp,	cons
         return true;
     }
     
-    Material mat1;
+    const Material* mat1;
     Vector3 contactVelocity1;
     Scalar contactAngularVelocity1;
     
     if(ent1->getType() == EntityType::STATIC)
     {
         StaticEntity* sent1 = (StaticEntity*)ent1;
-        mat1 = sent1->getMaterial();
+        mat1 = &sent1->getMaterial();
         contactVelocity1.setZero();
         contactAngularVelocity1 = Scalar(0);
     }
@@ -1148,9 +1660,9 @@ bool SimulationManager::CustomMaterialCombinerCallback(btManifoldPoint& cp,	cons
     {
         SolidEntity* sent1 = (SolidEntity*)ent1;
         if(sent1->getSolidType() == SolidType::COMPOUND)
-            mat1 = ((Compound*)sent1)->getMaterial(((Compound*)sent1)->getPartId(index1));
+            mat1 = &((Compound*)sent1)->getMaterial(((Compound*)sent1)->getPartId(index1));
         else
-            mat1 = sent1->getMaterial();
+            mat1 = &sent1->getMaterial();
         //Vector3 localPoint1 = sent1->getTransform().getBasis() * cp.m_localPointB;
         Vector3 localPoint1 = sent1->getCGTransform().inverse() * cp.getPositionWorldOnB();
         contactVelocity1 = sent1->getLinearVelocityInLocalPoint(localPoint1);
@@ -1169,7 +1681,7 @@ bool SimulationManager::CustomMaterialCombinerCallback(btManifoldPoint& cp,	cons
     Vector3 slipVel = relLocalVel - normalVel;
     Scalar sigma = 1000;
     // f = (static - dynamic)/(sigma * v^2 + 1) + dynamic
-    Friction f = mm->GetMaterialsInteraction(mat0.name, mat1.name);
+    Friction f = mm->GetMaterialsInteraction(mat0->index, mat1->index);
     cp.m_combinedFriction = (f.fStatic - f.fDynamic)/(sigma * slipVel.length2() + Scalar(1)) + f.fDynamic;
     
     //Rolling friction not possible to generalize - needs special treatment
@@ -1177,8 +1689,7 @@ bool SimulationManager::CustomMaterialCombinerCallback(btManifoldPoint& cp,	cons
     cp.m_combinedSpinningFriction = Scalar(0.0);
     
     //Save user data
-    ContactInfo* cInfo = new ContactInfo();
-    cInfo->totalAppliedImpulse = Scalar(0);
+    ContactInfo* cInfo = sm->contactInfoPool->Allocate();
     cInfo->slip = slipVel;
     cp.m_userPersistentData = cInfo;
     
@@ -1188,7 +1699,7 @@ bool SimulationManager::CustomMaterialCombinerCallback(btManifoldPoint& cp,	cons
     Scalar relAngularVelocity10 = contactAngularVelocity1 - contactAngularVelocity0;
     
     //calculate contact normal force and friction torque
-    Scalar normalForce = cp.m_appliedImpulse * SimulationApp::getApp()->getSimulationManager()->getStepsPerSecond();
+    Scalar normalForce = cp.m_appliedImpulse * sm->getStepsPerSecond();
     Scalar T = cp.m_combinedFriction * normalForce * 0.002;
 
     //apply damping torque
@@ -1199,7 +1710,7 @@ bool SimulationManager::CustomMaterialCombinerCallback(btManifoldPoint& cp,	cons
         ((SolidEntity*)ent1)->ApplyTorque(cp.m_normalWorldOnB * relAngularVelocity10/btFabs(relAngularVelocity10) * T);
 
     //Restitution
-    cp.m_combinedRestitution = mat0.restitution * mat1.restitution;
+    cp.m_combinedRestitution = mat0->restitution * mat1->restitution;
     
     return true;
 }
@@ -1218,76 +1729,66 @@ void SimulationManager::SolveICTickCallback(btDynamicsWorld* world, Scalar timeS
     if(simManager->icUseGravity)
     {
         //Apply gravity to bodies
-        for(size_t i = 0; i < simManager->entities.size(); ++i)
-        {
-            if(simManager->entities[i]->getType() == EntityType::SOLID)
-            {
-                SolidEntity* solid = (SolidEntity*)simManager->entities[i];
-                solid->ApplyGravity(world->getGravity());
-            }
-            else if(simManager->entities[i]->getType() == EntityType::FEATHERSTONE)
-            {
-                FeatherstoneEntity* feather = (FeatherstoneEntity*)simManager->entities[i];
-                feather->ApplyGravity(world->getGravity());
-            }
-        }
+        for(size_t i = 0; i < simManager->solidEntities.size(); ++i)
+            simManager->solidEntities[i]->ApplyGravity(world->getGravity());
+        
+        for(size_t i = 0; i < simManager->featherstoneEntities.size(); ++i)
+            simManager->featherstoneEntities[i]->ApplyGravity(world->getGravity());
         
         if(simManager->simulationTime < Scalar(0.01)) //Wait for a few cycles to ensure bodies started moving
             objectsSettled = false;
         else
         {
             //Check if objects settled
-            for(size_t i = 0; i < simManager->entities.size(); ++i)
+            for(size_t i = 0; i < simManager->solidEntities.size(); ++i)
             {
-                if(simManager->entities[i]->getType() == EntityType::SOLID)
+                SolidEntity* solid = simManager->solidEntities[i];
+                if(solid->getLinearVelocity().length() > simManager->icLinTolerance * Scalar(100.) || solid->getAngularVelocity().length() > simManager->icAngTolerance * Scalar(100.))
                 {
-                    SolidEntity* solid = (SolidEntity*)simManager->entities[i];
-                    if(solid->getLinearVelocity().length() > simManager->icLinTolerance * Scalar(100.) || solid->getAngularVelocity().length() > simManager->icAngTolerance * Scalar(100.))
-                    {
-                        objectsSettled = false;
-                        break;
-                    }
+                    objectsSettled = false;
+                    break;
                 }
-                else if(simManager->entities[i]->getType() == EntityType::FEATHERSTONE)
+            }
+            
+            for(size_t i = 0; objectsSettled && i < simManager->featherstoneEntities.size(); ++i)
+            {
+                FeatherstoneEntity* multibody = simManager->featherstoneEntities[i];
+                
+                //Check base velocity
+                Vector3 baseLinVel = multibody->getLinkLinearVelocity(0);
+                Vector3 baseAngVel = multibody->getLinkAngularVelocity(0);
+                
+                if(baseLinVel.length() > simManager->icLinTolerance * Scalar(100.) || baseAngVel.length() > simManager->icAngTolerance * Scalar(100.0))
                 {
-                    FeatherstoneEntity* multibody = (FeatherstoneEntity*)simManager->entities[i];
-                    
-                    //Check base velocity
-                    Vector3 baseLinVel = multibody->getLinkLinearVelocity(0);
-                    Vector3 baseAngVel = multibody->getLinkAngularVelocity(0);
-                    
-                    if(baseLinVel.length() > simManager->icLinTolerance * Scalar(100.) || baseAngVel.length() > simManager->icAngTolerance * Scalar(100.0))
-                    {
-                        objectsSettled = false;
-                        break;
-                    }
+                    objectsSettled = false;
+                    break;
+                }
+                
+                //Loop through all joints
+                for(size_t h = 0; h < multibody->getNumOfJoints(); ++h)
+                {
+                    Scalar jVelocity;
+                    btMultibodyLink::eFeatherstoneJointType jType;
+                    multibody->getJointVelocity((unsigned int)h, jVelocity, jType);
                     
-                    //Loop through all joints
-                    for(size_t h = 0; h < multibody->getNumOfJoints(); ++h)
+                    switch(jType)
                     {
-                        Scalar jVelocity;
-                        btMultibodyLink::eFeatherstoneJointType jType;
-                        multibody->getJointVelocity((unsigned int)h, jVelocity, jType);
-                        
-                        switch(jType)
-                        {
-                            case btMultibodyLink::eRevolute:
-                                if(Vector3(jVelocity,0,0).length() > simManager->icAngTolerance * Scalar(100.))
-                                    objectsSettled = false;
-                                break;
-                                
-                            case btMultibodyLink::ePrismatic:
-                                if(Vector3(jVelocity,0,0).length() > simManager->icLinTolerance * Scalar(100.))
-                                    objectsSettled = false;
-                                break;
-                                
-                            default:
-                                break;
-                        }
-                        
-                        if(!objectsSettled)
+                        case btMultibodyLink::eRevolute:
+                            if(Vector3(jVelocity,0,0).length() > simManager->icAngTolerance * Scalar(100.))
+                                objectsSettled = false;
+                            break;
+                            
+                        case btMultibodyLink::ePrismatic:
+                            if(Vector3(jVelocity,0,0).length() > simManager->icLinTolerance * Scalar(100.))
+                                objectsSettled = false;
+                            break;
+                            
+                        default:
                             break;
                     }
+                    
+                    if(!objectsSettled)
+                        break;
                 }
             }
         }
@@ -1313,182 +1814,160 @@ void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar ti
 {
     SimulationManager* simManager = (SimulationManager*)world->getWorldUserInfo();
     btMultiBodyDynamicsWorld* mbDynamicsWorld = (btMultiBodyDynamicsWorld*)world;
+    SF_PROFILE_STEP_BEGIN(simManager->profiler);
         
     //Clear all forces to ensure that no summing occurs
     mbDynamicsWorld->clearForces(); //Includes clearing of multibody forces!
         
     //loop through all actuators -> apply forces to bodies (free and connected by joints)
+    SF_PROFILE_BEGIN(simManager->profiler, StepPhase::ACTUATORS);
     for(size_t i = 0; i < simManager->actuators.size(); ++i)
         simManager->actuators[i]->Update(timeStep);
     
     //loop through all joints -> apply damping forces to bodies connected by joints
     for(size_t i = 0; i < simManager->joints.size(); ++i)
         simManager->joints[i]->ApplyDamping();
+    SF_PROFILE_END(simManager->profiler, StepPhase::ACTUATORS);
+    
+    //loop through all entities that may need special actions (static entities are skipped)
+    SF_PROFILE_BEGIN(simManager->profiler, StepPhase::BODIES);
+    for(size_t i = 0; i < simManager->solidEntities.size(); ++i)
+        simManager->solidEntities[i]->ApplyGravity(mbDynamicsWorld->getGravity());
     
-    //loop through all entities that may need special actions
-    for(size_t i = 0; i < simManager->entities.size(); ++i)
+    for(size_t i = 0; i < simManager->featherstoneEntities.size(); ++i)
     {
-        Entity* ent = simManager->entities[i];
-        
-        if(ent->getType() == EntityType::SOLID)
-        {
-            SolidEntity* solid = (SolidEntity*)ent;
-            solid->ApplyGravity(mbDynamicsWorld->getGravity());
-        }
-        else if(ent->getType() == EntityType::FEATHERSTONE)
-        {
-            FeatherstoneEntity* multibody = (FeatherstoneEntity*)ent;
-            multibody->ApplyGravity(mbDynamicsWorld->getGravity());
-            multibody->ApplyDamping();
-        }
-        else if(ent->getType() == EntityType::FORCEFIELD)
+        FeatherstoneEntity* multibody = simManager->featherstoneEntities[i];
+        multibody->ApplyGravity(mbDynamicsWorld->getGravity());
+        multibody->ApplyDamping();
+    }
+    
+    for(size_t i = 0; i < simManager->triggers.size(); ++i)
+    {
+        Trigger* trigger = simManager->triggers[i];
+        trigger->Clear();
+        btBroadphasePairArray& pairArray = trigger->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
+        int numPairs = pairArray.size();
+            
+        for(int h = 0; h < numPairs; ++h)
         {
-            ForcefieldEntity* ff = (ForcefieldEntity*)ent;
-            if(ff->getForcefieldType() == ForcefieldType::TRIGGER)
-            {				
-                Trigger* trigger = (Trigger*)ff;
-                trigger->Clear();
-                btBroadphasePairArray& pairArray = trigger->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
-                int numPairs = pairArray.size();
-                    
-                for(int h = 0; h < numPairs; ++h)
-                {
-                    const btBroadphasePair& pair = pairArray[h];
-                    btBroadphasePair* colPair = world->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
-                    if(!colPair)
-                        continue;
-                    
-                    btCollisionObject* co1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
-                    btCollisionObject* co2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
-                
-                    if(co1 == trigger->getGhost())
-                        trigger->Activate(co2);
-                    else if(co2 == trigger->getGhost())
-                        trigger->Activate(co1);
-                }
-            }
+            const btBroadphasePair& pair = pairArray[h];
+            btBroadphasePair* colPair = world->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
+            if(!colPair)
+                continue;
+            
+            btCollisionObject* co1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
+            btCollisionObject* co2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
+        
+            if(co1 == trigger->getGhost())
+                trigger->Activate(co2);
+            else if(co2 == trigger->getGhost())
+                trigger->Activate(co1);
         }
     }
+    SF_PROFILE_END(simManager->profiler, StepPhase::BODIES);
     
     //Geometry-based forces
     bool recompute = simManager->fdCounter % simManager->fdPrescaler == 0;
     ++simManager->fdCounter;
         
-    //Aerodynamic forces
+    //Aerodynamic forces (computed in parallel, applied serially in a deterministic order)
+    std::vector<SolidEntity*>& solids = simManager->fluidSolids;
     if(simManager->atmosphere != NULL)
     {
-        btBroadphasePairArray& pairArray = simManager->atmosphere->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
-        int numPairs = pairArray.size();
+        SF_PROFILE_SCOPE(simManager->profiler, StepPhase::AERODYNAMICS);
+        Atmosphere* atm = simManager->atmosphere;
+        atm->getOverlappingSolids(world, solids);
         
-        if(numPairs > 0)
-        {    
-            for(int h=0; h<numPairs; ++h)
-            {
-                const btBroadphasePair& pair = pairArray[h];
-                btBroadphasePair* colPair = world->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
-                if (!colPair)
-                    continue;
-                    
-                btCollisionObject* co1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
-                btCollisionObject* co2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
-                
-                if(co1 == simManager->atmosphere->getGhost())
-                    simManager->atmosphere->ApplyFluidForces(world, co2, recompute);
-                else if(co2 == simManager->ocean->getGhost())
-                    simManager->atmosphere->ApplyFluidForces(world, co1, recompute);
-            }
+        if(recompute)
+        {
+            if(simManager->threadPool != NULL)
+                simManager->threadPool->ParallelFor((unsigned int)solids.size(), [&](unsigned int i){ atm->ComputeFluidForces(solids[i]); });
+            else
+                for(size_t i=0; i<solids.size(); ++i) atm->ComputeFluidForces(solids[i]);
         }
+        
+        for(size_t i=0; i<solids.size(); ++i)
+            solids[i]->ApplyAerodynamicForces();
     }
     
-    //Hydrodynamic forces
+    //Hydrodynamic forces (computed in parallel, applied serially in a deterministic order)
     if(simManager->ocean != NULL)
     {
-        if(recompute) SDL_LockMutex(simManager->simHydroMutex);
-        
-        btBroadphasePairArray& pairArray = simManager->ocean->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
-        int numPairs = pairArray.size();
+        SF_PROFILE_SCOPE(simManager->profiler, StepPhase::HYDRODYNAMICS);
+        Ocean* ocn = simManager->ocean;
+        ocn->getOverlappingSolids(world, solids);
+        ocn->UpdateCurrents(simManager->simulationTime);
         
-        if(numPairs > 0)
-        {   
-            //uint64_t s = GetTimeInMicroseconds();
-            for(int h=0; h<numPairs; ++h)
-            {
-                const btBroadphasePair& pair = pairArray[h];
-                btBroadphasePair* colPair = world->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
-                if (!colPair)
-                    continue;
-                    
-                btCollisionObject* co1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
-                btCollisionObject* co2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
-                
-                if(co1 == simManager->ocean->getGhost())
-                    simManager->ocean->ApplyFluidForces(world, co2, recompute);
-                else if(co2 == simManager->ocean->getGhost())
-                    simManager->ocean->ApplyFluidForces(world, co1, recompute);
-            }
-            //uint64_t e = GetTimeInMicroseconds();
-            //if(recompute)
-            //    printf("Hydro compute time: %ld us\n", e-s);
+        if(recompute)
+        {
+            ocn->SimulateWaves(simManager->simulationTime, simManager->threadPool);
+            if(simManager->threadPool != NULL)
+                simManager->threadPool->ParallelFor((unsigned int)solids.size(), [&](unsigned int i){ ocn->ComputeFluidForces(solids[i]); });
+            else
+                for(size_t i=0; i<solids.size(); ++i) ocn->ComputeFluidForces(solids[i]);
         }
         
-        if(recompute) SDL_UnlockMutex(simManager->simHydroMutex);
+        for(size_t i=0; i<solids.size(); ++i)
+            solids[i]->ApplyHydrodynamicForces();
     }
+    
+    //Collision detection starts after the pre-tick callback
+    SF_PROFILE_BEGIN(simManager->profiler, StepPhase::BROADPHASE);
 }
 
 //Used to measure body motions and calculate controls
 void SimulationManager::SimulationPostTickCallback(btDynamicsWorld *world, Scalar timeStep)
 {
     SimulationManager* simManager = (SimulationManager*)world->getWorldUserInfo();
+    SF_PROFILE_END(simManager->profiler, StepPhase::SOLVER);
     
     //Update acceleration data
-    for(size_t i = 0; i < simManager->entities.size(); ++i)
-    {
-        Entity* ent = simManager->entities[i];
-            
-        if(ent->getType() == EntityType::SOLID)
-        {
-            SolidEntity* solid = (SolidEntity*)ent;
-            solid->UpdateAcceleration(timeStep);
-        }
-        else if(ent->getType() == EntityType::FEATHERSTONE)
-        {
-            FeatherstoneEntity* fe = (FeatherstoneEntity*)ent;
-            fe->UpdateAcceleration(timeStep);
-        }
-        else if(ent->getType() == EntityType::ANIMATED)
-        {
-            AnimatedEntity* anim = (AnimatedEntity*)ent;
-            anim->Update(timeStep);
-        }
-    }
+    SF_PROFILE_BEGIN(simManager->profiler, StepPhase::BODIES);
+    for(size_t i = 0; i < simManager->solidEntities.size(); ++i)
+        simManager->solidEntities[i]->UpdateAcceleration(timeStep);
+    
+    for(size_t i = 0; i < simManager->featherstoneEntities.size(); ++i)
+        simManager->featherstoneEntities[i]->UpdateAcceleration(timeStep);
+    
+    for(size_t i = 0; i < simManager->animatedEntities.size(); ++i)
+        simManager->animatedEntities[i]->Update(timeStep);
+    SF_PROFILE_END(simManager->profiler, StepPhase::BODIES);
     
-    //Loop through all sensors -> update measurements
-    for(size_t i = 0; i < simManager->sensors.size(); ++i)
-        simManager->sensors[i]->Update(timeStep);
+    //Update measurements of the sensors that are due
+    SF_PROFILE_BEGIN(simManager->profiler, StepPhase::SENSORS);
+    simManager->UpdateSensors(timeStep);
+    SF_PROFILE_END(simManager->profiler, StepPhase::SENSORS);
         
     //Loop through all comms -> update state and measurements
+    SF_PROFILE_BEGIN(simManager->profiler, StepPhase::COMMS);
     for(size_t i = 0; i < simManager->comms.size(); ++i)
         simManager->comms[i]->Update(timeStep);
+    SF_PROFILE_END(simManager->profiler, StepPhase::COMMS);
     
     //Loop through contact manifolds -> update contacts
-    int numManifolds = world->getDispatcher()->getNumManifolds();
+    SF_PROFILE_BEGIN(simManager->profiler, StepPhase::CONTACTS);
+    int numManifolds = simManager->contacts.size() > 0 ? world->getDispatcher()->getNumManifolds() : 0;
     for(int i=0; i<numManifolds; ++i)
     {
         btPersistentManifold* contactManifold = world->getDispatcher()->getManifoldByIndexInternal(i);
+        if(contactManifold->getNumContacts() == 0)
+            continue;
         btCollisionObject* coA = (btCollisionObject*)contactManifold->getBody0();
         btCollisionObject* coB = (btCollisionObject*)contactManifold->getBody1();
         Entity* entA = (Entity*)coA->getUserPointer();
         Entity* entB = (Entity*)coB->getUserPointer();
         Contact* contact = simManager->getContact(entA, entB);
-        if(contact != NULL && contactManifold->getNumContacts() > 0)
+        if(contact != NULL)
             contact->AddContactPoint(contactManifold, contact->getEntityA() != entA, timeStep);        
     }
+    SF_PROFILE_END(simManager->profiler, StepPhase::CONTACTS);
 
     //Update simulation time
     simManager->simulationTime += timeStep;
     
     //Optional method to update some post simulation data (like ROS messages...)
     simManager->SimulationStepCompleted(timeStep);
+    SF_PROFILE_STEP_END(simManager->profiler);
 }
 
 //Used to save contact information, including contact forces
@@ -1499,10 +1978,10 @@ bool SimulationManager::ContactInfoUpdateCallback(btManifoldPoint& cp, void* bod
     return true;
 }
 
-//Used to deallocate memory reserved for contact information structure
+//Used to return the contact information structure to the pool of the simulation that created it
 bool SimulationManager::ContactInfoDestroyCallback(void* userPersistentData)
 {
-    delete ((ContactInfo*)userPersistentData);
+    ContactInfoPool::Release((ContactInfo*)userPersistentData);
     return true;
 }
 
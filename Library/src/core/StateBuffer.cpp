@@ -0,0 +1,207 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  StateBuffer.cpp
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/StateBuffer.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace sf
+{
+
+StateBuffer::StateBuffer() : pos(0), valid(true)
+{
+    data.reserve(4096);
+}
+
+StateBuffer::StateBuffer(const std::vector<uint8_t>& bytes) : data(bytes), pos(0), valid(true)
+{
+}
+
+void StateBuffer::WriteRaw(const void* src, size_t len)
+{
+    size_t offset = data.size();
+    data.resize(offset + len);
+    std::memcpy(&data[offset], src, len);
+}
+
+void StateBuffer::ReadRaw(void* dst, size_t len)
+{
+    if(!valid || pos + len > data.size())
+    {
+        valid = false;
+        std::memset(dst, 0, len);
+        return;
+    }
+    std::memcpy(dst, &data[pos], len);
+    pos += len;
+}
+
+void StateBuffer::Write(Scalar v)
+{
+    WriteRaw(&v, sizeof(Scalar));
+}
+
+void StateBuffer::Write(uint32_t v)
+{
+    WriteRaw(&v, sizeof(uint32_t));
+}
+
+void StateBuffer::Write(uint64_t v)
+{
+    WriteRaw(&v, sizeof(uint64_t));
+}
+
+void StateBuffer::Write(bool v)
+{
+    uint8_t b = v ? 1 : 0;
+    WriteRaw(&b, 1);
+}
+
+void StateBuffer::Write(const Vector3& v)
+{
+    Scalar xyz[3] = {v.x(), v.y(), v.z()};
+    WriteRaw(xyz, sizeof(xyz));
+}
+
+void StateBuffer::Write(const Transform& v)
+{
+    Write(v.getBasis().getRow(0));
+    Write(v.getBasis().getRow(1));
+    Write(v.getBasis().getRow(2));
+    Write(v.getOrigin());
+}
+
+void StateBuffer::Write(const std::string& v)
+{
+    Write((uint32_t)v.size());
+    WriteRaw(v.data(), v.size());
+}
+
+template<typename T> void StateBuffer::WriteObject(const T& v)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable objects can be stored in binary form!");
+    WriteRaw(&v, sizeof(T));
+}
+
+template<typename T> void StateBuffer::ReadObject(T& v)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable objects can be restored from binary form!");
+    T tmp;
+    ReadRaw(&tmp, sizeof(T));
+    if(valid)
+        v = tmp;
+}
+
+void StateBuffer::Write(const std::mt19937& v)
+{
+    WriteObject(v);
+}
+
+void StateBuffer::Write(const std::normal_distribution<Scalar>& v)
+{
+    WriteObject(v);
+}
+
+void StateBuffer::Read(Scalar& v)
+{
+    ReadRaw(&v, sizeof(Scalar));
+}
+
+void StateBuffer::Read(uint32_t& v)
+{
+    ReadRaw(&v, sizeof(uint32_t));
+}
+
+void StateBuffer::Read(uint64_t& v)
+{
+    ReadRaw(&v, sizeof(uint64_t));
+}
+
+void StateBuffer::Read(bool& v)
+{
+    uint8_t b;
+    ReadRaw(&b, 1);
+    v = b != 0;
+}
+
+void StateBuffer::Read(Vector3& v)
+{
+    Scalar xyz[3];
+    ReadRaw(xyz, sizeof(xyz));
+    v.setValue(xyz[0], xyz[1], xyz[2]);
+}
+
+void StateBuffer::Read(Transform& v)
+{
+    Vector3 r0, r1, r2, o;
+    Read(r0);
+    Read(r1);
+    Read(r2);
+    Read(o);
+    v.getBasis().setValue(r0.x(), r0.y(), r0.z(), r1.x(), r1.y(), r1.z(), r2.x(), r2.y(), r2.z());
+    v.setOrigin(o);
+}
+
+void StateBuffer::Read(std::string& v)
+{
+    uint32_t len;
+    Read(len);
+    if(!valid || pos + len > data.size())
+    {
+        valid = false;
+        v.clear();
+        return;
+    }
+    v.assign((const char*)&data[pos], len);
+    pos += len;
+}
+
+void StateBuffer::Read(std::mt19937& v)
+{
+    ReadObject(v);
+}
+
+void StateBuffer::Read(std::normal_distribution<Scalar>& v)
+{
+    ReadObject(v);
+}
+
+const std::vector<uint8_t>& StateBuffer::getBytes() const
+{
+    return data;
+}
+
+bool StateBuffer::isValid() const
+{
+    return valid;
+}
+
+bool StateBuffer::isAtEnd() const
+{
+    return pos == data.size();
+}
+
+}
@@ -0,0 +1,167 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  StepProfiler.cpp
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/StepProfiler.h"
+
+#include <algorithm>
+
+namespace sf
+{
+
+StepProfiler::StepProfiler(unsigned int windowLength)
+{
+    window = windowLength > 0 ? windowLength : 1;
+    for(unsigned int i = 0; i < STEP_PHASE_COUNT; ++i)
+        history[i] = std::vector<float>(window, 0.f);
+    historyMutex = SDL_CreateMutex();
+    Reset();
+}
+
+StepProfiler::~StepProfiler()
+{
+    SDL_DestroyMutex(historyMutex);
+}
+
+void StepProfiler::Reset()
+{
+    SDL_LockMutex(historyMutex);
+    inStep = false;
+    head = 0;
+    count = 0;
+    for(unsigned int i = 0; i < STEP_PHASE_COUNT; ++i)
+    {
+        phaseStart[i] = 0;
+        phaseAccum[i] = 0;
+    }
+    SDL_UnlockMutex(historyMutex);
+}
+
+void StepProfiler::BeginStep()
+{
+    for(unsigned int i = 0; i < STEP_PHASE_COUNT; ++i)
+    {
+        phaseStart[i] = 0;
+        phaseAccum[i] = 0;
+    }
+    inStep = true;
+    phaseStart[(unsigned int)StepPhase::STEP] = Now();
+}
+
+void StepProfiler::EndStep()
+{
+    if(!inStep)
+        return;
+
+    EndPhase(StepPhase::STEP);
+    inStep = false;
+
+    SDL_LockMutex(historyMutex);
+    for(unsigned int i = 0; i < STEP_PHASE_COUNT; ++i)
+        history[i][head] = (float)(phaseAccum[i]/1000.0); //[us]
+    head = (head + 1) % window;
+    count = std::min(count + 1, window);
+    SDL_UnlockMutex(historyMutex);
+}
+
+void StepProfiler::BeginPhase(StepPhase p)
+{
+    if(inStep)
+        phaseStart[(unsigned int)p] = Now();
+}
+
+void StepProfiler::EndPhase(StepPhase p)
+{
+    unsigned int id = (unsigned int)p;
+    if(!inStep || phaseStart[id] == 0)
+        return;
+
+    phaseAccum[id] += Now() - phaseStart[id];
+    phaseStart[id] = 0;
+}
+
+StepProfile StepProfiler::getProfile()
+{
+    StepProfile profile;
+#ifdef STONEFISH_PROFILING
+    profile.enabled = true;
+#endif
+
+    SDL_LockMutex(historyMutex);
+    profile.samples = count;
+    if(count > 0)
+    {
+        std::vector<float> sorted(count);
+        for(unsigned int i = 0; i < STEP_PHASE_COUNT; ++i)
+        {
+            std::copy(history[i].begin(), history[i].begin() + count, sorted.begin());
+            double sum = 0.0;
+            for(unsigned int h = 0; h < count; ++h)
+                sum += sorted[h];
+            size_t k95 = (size_t)((count - 1) * 0.95);
+            std::nth_element(sorted.begin(), sorted.begin() + k95, sorted.end());
+            profile.phases[i].mean = sum/count/1000.0;
+            profile.phases[i].p95 = sorted[k95]/1000.0;
+            profile.phases[i].max = *std::max_element(sorted.begin(), sorted.end())/1000.0;
+        }
+    }
+    SDL_UnlockMutex(historyMutex);
+
+    return profile;
+}
+
+std::string StepProfiler::getPhaseName(StepPhase p)
+{
+    switch(p)
+    {
+        case StepPhase::STEP:
+            return "Step";
+        case StepPhase::ACTUATORS:
+            return "Actuators";
+        case StepPhase::BODIES:
+            return "Bodies";
+        case StepPhase::AERODYNAMICS:
+            return "Aerodynamics";
+        case StepPhase::HYDRODYNAMICS:
+            return "Hydrodynamics";
+        case StepPhase::BROADPHASE:
+            return "Broadphase";
+        case StepPhase::NARROWPHASE:
+            return "Narrowphase";
+        case StepPhase::SOLVER:
+            return "Solver";
+        case StepPhase::MLCP:
+            return "MLCP";
+        case StepPhase::SENSORS:
+            return "Sensors";
+        case StepPhase::COMMS:
+            return "Comms";
+        case StepPhase::CONTACTS:
+            return "Contacts";
+        default:
+            return "Unknown";
+    }
+}
+
+}
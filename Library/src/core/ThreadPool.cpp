@@ -0,0 +1,144 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  ThreadPool.cpp
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/ThreadPool.h"
+
+#include "core/SimulationApp.h"
+
+namespace sf
+{
+
+ThreadPool::ThreadPool(unsigned int numThreads)
+{
+    poolMutex = SDL_CreateMutex();
+    startCond = SDL_CreateCond();
+    doneCond = SDL_CreateCond();
+    job = NULL;
+    jobApp = NULL;
+    jobSize = 0;
+    nextTask = 0;
+    busyWorkers = 0;
+    generation = 0;
+    quit = false;
+    
+    //The calling thread also computes tasks
+    for(unsigned int i = 1; i < numThreads; ++i)
+        workers.push_back(SDL_CreateThread(ThreadPool::WorkerLoop, "workerThread", this));
+}
+
+ThreadPool::~ThreadPool()
+{
+    SDL_LockMutex(poolMutex);
+    quit = true;
+    SDL_CondBroadcast(startCond);
+    SDL_UnlockMutex(poolMutex);
+    
+    for(size_t i = 0; i < workers.size(); ++i)
+    {
+        int status;
+        SDL_WaitThread(workers[i], &status);
+    }
+    workers.clear();
+    
+    SDL_DestroyCond(doneCond);
+    SDL_DestroyCond(startCond);
+    SDL_DestroyMutex(poolMutex);
+}
+
+unsigned int ThreadPool::getNumOfThreads() const
+{
+    return (unsigned int)workers.size() + 1;
+}
+
+void ThreadPool::ParallelFor(unsigned int n, const std::function<void(unsigned int)>& task)
+{
+    //Serial execution
+    if(workers.size() == 0 || n < 2)
+    {
+        for(unsigned int i = 0; i < n; ++i)
+            task(i);
+        return;
+    }
+    
+    //Wake up workers
+    SDL_LockMutex(poolMutex);
+    job = &task;
+    jobApp = SimulationApp::getApp();
+    jobSize = n;
+    nextTask = 0;
+    busyWorkers = (unsigned int)workers.size();
+    ++generation;
+    SDL_CondBroadcast(startCond);
+    SDL_UnlockMutex(poolMutex);
+    
+    //Participate in computation
+    RunTasks();
+    
+    //Wait for all workers to finish
+    SDL_LockMutex(poolMutex);
+    while(busyWorkers > 0)
+        SDL_CondWait(doneCond, poolMutex);
+    job = NULL;
+    SDL_UnlockMutex(poolMutex);
+}
+
+void ThreadPool::RunTasks()
+{
+    unsigned int i;
+    while((i = nextTask++) < jobSize)
+        (*job)(i);
+}
+
+int ThreadPool::WorkerLoop(void* data)
+{
+    ThreadPool* pool = (ThreadPool*)data;
+    uint64_t lastGeneration = 0;
+    
+    SDL_LockMutex(pool->poolMutex);
+    while(true)
+    {
+        while(!pool->quit && pool->generation == lastGeneration)
+            SDL_CondWait(pool->startCond, pool->poolMutex);
+        
+        if(pool->quit)
+            break;
+        
+        lastGeneration = pool->generation;
+        if(pool->jobApp != NULL)
+            pool->jobApp->BindToThread();
+        SDL_UnlockMutex(pool->poolMutex);
+        
+        pool->RunTasks();
+        
+        SDL_LockMutex(pool->poolMutex);
+        if(--pool->busyWorkers == 0)
+            SDL_CondSignal(pool->doneCond);
+    }
+    SDL_UnlockMutex(pool->poolMutex);
+    
+    return 0;
+}
+
+}
@@ -26,6 +26,7 @@
 #include "core/TrajectoryGenerator.h"
 
 #include<algorithm>
+#include "core/StateBuffer.h"
 
 namespace sf
 {
@@ -38,6 +39,16 @@ TrajectoryGenerator::TrajectoryGenerator()
     seg = 0;
 }
 
+TrajectoryGenerator::TrajectoryGenerator(const TrajectoryGenerator& other)
+{
+    t = other.t;
+    p = other.p;
+    v = other.v;
+    seg = other.seg;
+    for(size_t i=0; i<other.segments.size(); ++i)
+        segments.push_back(other.segments[i]->Copy());
+}
+
 TrajectoryGenerator::~TrajectoryGenerator()
 {
     for(size_t i=0; i<segments.size(); ++i)
@@ -84,6 +95,24 @@ void TrajectoryGenerator::Advance(Scalar dt)
     v = segments[seg]->VelocityAtTime(t);   
 }
 
+void TrajectoryGenerator::SaveState(StateBuffer& state)
+{
+    state.Write(p);
+    state.Write(v);
+    state.Write(t);
+    state.Write((uint32_t)seg);
+}
+
+void TrajectoryGenerator::RestoreState(StateBuffer& state)
+{
+    uint32_t s;
+    state.Read(p);
+    state.Read(v);
+    state.Read(t);
+    state.Read(s);
+    seg = s;
+}
+
 std::vector<Renderable> TrajectoryGenerator::Render()
 {
     std::vector<Renderable> items(0);
@@ -143,6 +172,11 @@ PWLSegment::PWLSegment(const TrajectoryPoint& start, const TrajectoryPoint& end)
     AddPoint(end);
 }
 
+TrajectorySegment* PWLSegment::Copy() const
+{
+    return new PWLSegment(*this);
+}
+
 Vector3 PWLSegment::PointAtTime(Scalar t) const
 {
     if(t <= getStartTime())
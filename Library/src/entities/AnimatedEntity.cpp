@@ -27,6 +27,8 @@
 
 #include "core/GraphicalSimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/StateBuffer.h"
+#include "core/CloneContext.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 
@@ -122,6 +124,24 @@ void AnimatedEntity::Update(Scalar dt)
     }
 }
 
+void AnimatedEntity::SaveState(StateBuffer& state)
+{
+    state.Write(T_O);
+    state.Write(vel);
+    state.Write(aVel);
+    if(tg != nullptr)
+        tg->SaveState(state);
+}
+
+void AnimatedEntity::RestoreState(StateBuffer& state)
+{
+    state.Read(T_O);
+    state.Read(vel);
+    state.Read(aVel);
+    if(tg != nullptr)
+        tg->RestoreState(state);
+}
+
 void AnimatedEntity::AddToSimulation(SimulationManager* sm)
 {
     AddToSimulation(sm, I4());
@@ -132,6 +152,17 @@ void AnimatedEntity::AddToSimulation(SimulationManager* sm, const Transform& ori
     setOTransform(origin);
 }
 
+Entity* AnimatedEntity::Clone(CloneContext& ctx)
+{
+    AnimatedEntity* copy = new AnimatedEntity(*this);
+    if(tg != nullptr)
+        copy->tg = new TrajectoryGenerator(*tg);
+    copy->graObjectId = -1;
+    copy->AddToSimulation(ctx.getSimulationManager(), getOTransform());
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 std::vector<Renderable> AnimatedEntity::Render()
 {
     std::vector<Renderable> items(0);
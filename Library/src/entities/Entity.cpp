@@ -27,6 +27,7 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/Console.h"
 #include "graphics/OpenGLContent.h"
 
 namespace sf
@@ -58,5 +59,19 @@ std::string Entity::getName() const
 {
     return name;
 }
+
+void Entity::SaveState(StateBuffer& state)
+{
+}
+
+void Entity::RestoreState(StateBuffer& state)
+{
+}
+
+Entity* Entity::Clone(CloneContext& ctx)
+{
+    cError("Entity '%s' cannot be cloned!", name.c_str());
+    return NULL;
+}
         
 }
@@ -28,6 +28,8 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "entities/StaticEntity.h"
+#include "core/StateBuffer.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -682,6 +684,160 @@ void FeatherstoneEntity::UpdateAcceleration(Scalar dt)
         links[i].solid->UpdateAcceleration(dt);
 }
 
+void FeatherstoneEntity::SaveState(StateBuffer& state)
+{
+    state.Write(multiBody->getBaseWorldTransform());
+    state.Write(multiBody->getBaseVel());
+    state.Write(multiBody->getBaseOmega());
+    state.Write(multiBody->isAwake());
+    
+    //Joint coordinates
+    for(int i=0; i<multiBody->getNumLinks(); ++i)
+    {
+        Scalar* q = multiBody->getJointPosMultiDof(i);
+        Scalar* dq = multiBody->getJointVelMultiDof(i);
+        for(int h=0; h<multiBody->getLink(i).m_posVarCount; ++h)
+            state.Write(q[h]);
+        for(int h=0; h<multiBody->getLink(i).m_dofCount; ++h)
+            state.Write(dq[h]);
+    }
+    
+    //Colliders (restored directly to avoid recomputing forward kinematics)
+    for(size_t i=0; i<links.size(); ++i)
+    {
+        state.Write(links[i].solid->multibodyCollider->getWorldTransform());
+        links[i].solid->SaveState(state);
+    }
+}
+
+void FeatherstoneEntity::RestoreState(StateBuffer& state)
+{
+    Transform trans;
+    Vector3 v;
+    bool awake;
+    state.Read(trans);
+    multiBody->setBaseWorldTransform(trans);
+    state.Read(v);
+    multiBody->setBaseVel(v);
+    state.Read(v);
+    multiBody->setBaseOmega(v);
+    state.Read(awake);
+    
+    Scalar coords[7]; //Maximum number of position variables of a link
+    for(int i=0; i<multiBody->getNumLinks(); ++i)
+    {
+        for(int h=0; h<multiBody->getLink(i).m_posVarCount; ++h)
+            state.Read(coords[h]);
+        multiBody->setJointPosMultiDof(i, coords);
+        for(int h=0; h<multiBody->getLink(i).m_dofCount; ++h)
+            state.Read(coords[h]);
+        multiBody->setJointVelMultiDof(i, coords);
+    }
+    
+    for(size_t i=0; i<links.size(); ++i)
+    {
+        state.Read(trans);
+        links[i].solid->multibodyCollider->setWorldTransform(trans);
+        links[i].solid->multibodyCollider->setInterpolationWorldTransform(trans);
+        links[i].solid->RestoreState(state);
+    }
+    
+    multiBody->clearForcesAndTorques();
+    if(awake)
+        multiBody->wakeUp();
+    else
+        multiBody->goToSleep();
+}
+
+Entity* FeatherstoneEntity::Clone(CloneContext& ctx)
+{
+    //Copy links first, to be able to give up without touching the world
+    std::vector<SolidEntity*> solids;
+    for(size_t i=0; i<links.size(); ++i)
+    {
+        SolidEntity* solid = links[i].solid->Copy(ctx);
+        if(solid == NULL)
+        {
+            for(size_t h=0; h<solids.size(); ++h)
+                delete solids[h];
+            return NULL;
+        }
+        solids.push_back(solid);
+    }
+    
+    //Rebuild the multibody with the same settings
+    btMultiBodyDynamicsWorld* world = ctx.getSimulationManager()->getDynamicsWorld();
+    FeatherstoneEntity* copy = new FeatherstoneEntity(*this);
+    btMultiBody* mb = new btMultiBody(multiBody->getNumLinks(), multiBody->getBaseMass(), multiBody->getBaseInertia(), multiBody->hasFixedBase(), multiBody->getCanSleep());
+    mb->setBaseWorldTransform(multiBody->getBaseWorldTransform());
+    mb->setAngularDamping(multiBody->getAngularDamping());
+    mb->setLinearDamping(multiBody->getLinearDamping());
+    mb->setMaxAppliedImpulse(multiBody->getMaxAppliedImpulse());
+    mb->setMaxCoordinateVelocity(multiBody->getMaxCoordinateVelocity());
+    mb->useRK4Integration(multiBody->isUsingRK4Integration());
+    mb->useGlobalVelocities(multiBody->isUsingGlobalVelocities());
+    mb->setHasSelfCollision(multiBody->hasSelfCollision());
+    mb->setUseGyroTerm(multiBody->getUseGyroTerm());
+    copy->multiBody = mb;
+    
+    for(size_t i=0; i<links.size(); ++i)
+    {
+        copy->links[i].solid = solids[i];
+        solids[i]->BuildMultibodyLinkCollider(mb, (unsigned int)i, world);
+        solids[i]->multibodyCollider->setWorldTransform(links[i].solid->multibodyCollider->getWorldTransform());
+    }
+    
+    //Replay joint setup using the data stored in the original multibody
+    for(size_t i=0; i<joints.size(); ++i)
+    {
+        FeatherstoneJoint& joint = copy->joints[i];
+        const btMultibodyLink& link = multiBody->getLink((int)joint.child - 1);
+        bool disableCollision = (link.m_flags & BT_MULTIBODYLINKFLAGS_DISABLE_PARENT_COLLISION) != 0;
+        
+        switch(joint.type)
+        {
+            case btMultibodyLink::eRevolute:
+                mb->setupRevolute((int)joint.child - 1, link.m_mass, link.m_inertiaLocal, link.m_parent, link.m_zeroRotParentToThis, 
+                                  joint.axisInChild, link.m_eVector, link.m_dVector, disableCollision);
+                break;
+                
+            case btMultibodyLink::ePrismatic:
+                mb->setupPrismatic((int)joint.child - 1, link.m_mass, link.m_inertiaLocal, link.m_parent, link.m_zeroRotParentToThis, 
+                                   joint.axisInChild, link.m_eVector, link.m_dVector, disableCollision);
+                break;
+                
+            case btMultibodyLink::eFixed:
+                mb->setupFixed((int)joint.child - 1, link.m_mass, link.m_inertiaLocal, link.m_parent, link.m_zeroRotParentToThis, 
+                               link.m_eVector, link.m_dVector);
+                break;
+                
+            default:
+                break;
+        }
+        
+        joint.feedback = new btMultiBodyJointFeedback(*joints[i].feedback);
+        mb->getLink((int)joint.child - 1).m_jointFeedback = joint.feedback;
+        
+        if(joints[i].limit != NULL)
+            joint.limit = new btMultiBodyJointLimitConstraint(mb, joints[i].limit->getLinkA(), joints[i].lowerLimit, joints[i].upperLimit);
+        if(joints[i].motor != NULL) //Setpoints are given by the actuators in every step
+            joint.motor = new btMultiBodyJointMotor(mb, joints[i].motor->getLinkA(), Scalar(0), joints[i].motor->getMaxAppliedImpulse());
+    }
+    
+    //Limits have to be added before motors (same as in AddToSimulation)
+    for(size_t i=0; i<copy->joints.size(); ++i)
+        if(copy->joints[i].limit != NULL)
+            world->addMultiBodyConstraint(copy->joints[i].limit);
+    for(size_t i=0; i<copy->joints.size(); ++i)
+        if(copy->joints[i].motor != NULL)
+            world->addMultiBodyConstraint(copy->joints[i].motor);
+    
+    mb->finalizeMultiDof();
+    world->addMultiBody(mb);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 std::vector<Renderable> FeatherstoneEntity::Render()
 {	
     std::vector<Renderable> items(0);
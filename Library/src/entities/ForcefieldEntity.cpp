@@ -26,6 +26,9 @@
 #include "entities/ForcefieldEntity.h"
 
 #include "core/SimulationManager.h"
+#include "core/AssetCache.h"
+#include "core/CloneContext.h"
+#include "entities/SolidEntity.h"
 #include "graphics/OpenGLContent.h"
 
 namespace sf
@@ -51,11 +54,72 @@ btPairCachingGhostObject* ForcefieldEntity::getGhost()
     return ghost;
 }
 
+void ForcefieldEntity::getOverlappingSolids(btDynamicsWorld* world, std::vector<SolidEntity*>& solids)
+{
+    solids.clear();
+    btBroadphasePairArray& pairArray = ghost->getOverlappingPairCache()->getOverlappingPairArray();
+    
+    for(int h=0; h<pairArray.size(); ++h)
+    {
+        const btBroadphasePair& pair = pairArray[h];
+        btBroadphasePair* colPair = world->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
+        if(!colPair)
+            continue;
+        
+        btCollisionObject* co1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
+        btCollisionObject* co2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
+        SolidEntity* solid = getDynamicSolid(co1 == ghost ? co2 : co1);
+        if(solid != NULL)
+            solids.push_back(solid);
+    }
+}
+
+SolidEntity* ForcefieldEntity::getDynamicSolid(btCollisionObject* co)
+{
+    Entity* ent;
+    btRigidBody* rb = btRigidBody::upcast(co);
+    btMultiBodyLinkCollider* mbl = btMultiBodyLinkCollider::upcast(co);
+    
+    if(rb != 0)
+    {
+        if(rb->isStaticOrKinematicObject())
+            return NULL;
+        else
+            ent = (Entity*)rb->getUserPointer();
+    }
+    else if(mbl != 0)
+    {
+        if(mbl->isStaticOrKinematicObject())
+            return NULL;
+        else
+            ent = (Entity*)mbl->getUserPointer();
+    }
+    else
+        return NULL;
+    
+    if(ent == NULL || ent->getType() != EntityType::SOLID)
+        return NULL;
+    
+    return (SolidEntity*)ent;
+}
+
 void ForcefieldEntity::AddToSimulation(SimulationManager* sm)
 {
     sm->getDynamicsWorld()->addCollisionObject(ghost, MASK_DEFAULT, MASK_DEFAULT);
 }
 
+void ForcefieldEntity::InitCopy(CloneContext& ctx)
+{
+    //Share the collision shape, create own ghost in the world of the context
+    btPairCachingGhostObject* source = ghost;
+    ghost = new btPairCachingGhostObject();
+    ghost->setCollisionFlags(source->getCollisionFlags());
+    ghost->setWorldTransform(source->getWorldTransform());
+    ghost->setCollisionShape(source->getCollisionShape());
+    AssetCache::AddReference(source->getCollisionShape());
+    AddToSimulation(ctx.getSimulationManager());
+}
+
 std::vector<Renderable> ForcefieldEntity::Render()
 {
     return std::vector<Renderable>(0);
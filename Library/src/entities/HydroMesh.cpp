@@ -0,0 +1,803 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  HydroMesh.cpp
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "entities/HydroMesh.h"
+
+#include <utility>
+#include <queue>
+#include <algorithm>
+#include <limits>
+#include "graphics/OpenGLDataStructs.h"
+
+#if defined(__AVX2__) && defined(BT_USE_DOUBLE_PRECISION)
+#define HYDROMESH_AVX2
+#include <immintrin.h>
+#endif
+
+namespace sf
+{
+
+//Clipping of a single face against the fluid surface (negative depth = above the surface).
+//Vertices above the surface are moved along the edges towards the submerged vertices. Returns the number of corners
+//of the submerged part (0, 3 or 4) and the index of the corner closing the first triangle (the quad is split into two).
+static inline unsigned int ClipFace(const HydroMesh& m, size_t faceID, Vector3 q[4], unsigned int& third)
+{
+    unsigned int id[3] = {m.indices[faceID*3], m.indices[faceID*3+1], m.indices[faceID*3+2]};
+    Scalar d[3] = {m.depth[id[0]], m.depth[id[1]], m.depth[id[2]]};
+    bool above[3] = {d[0] < Scalar(0), d[1] < Scalar(0), d[2] < Scalar(0)};
+    unsigned int nAbove = (above[0] ? 1 : 0) + (above[1] ? 1 : 0) + (above[2] ? 1 : 0);
+    
+    for(unsigned int k=0; k<3; ++k)
+        q[k] = m.getVertex(id[k]);
+    third = 2;
+    
+    switch(nAbove)
+    {
+        case 0: //All underwater
+            return 3;
+            
+        case 2: //Two vertices above water (triangle)
+        {
+            unsigned int k = !above[0] ? 0 : (!above[1] ? 1 : 2);
+            Vector3 pk = q[k];
+            for(unsigned int j=0; j<3; ++j)
+                if(above[j])
+                    q[j] = pk + (q[j]-pk) * (d[k]/(btFabs(d[j]) + d[k]));
+            return 3;
+        }
+            
+        case 1: //One vertex above water (quad = two triangles)
+        {
+            unsigned int k = above[0] ? 0 : (above[1] ? 1 : 2);
+            unsigned int b = k == 1 ? 0 : 1;
+            unsigned int c = k == 2 ? 0 : 2;
+            Vector3 pk = q[k];
+            q[k] = q[b] + (pk-q[b]) * (d[b]/(btFabs(d[k]) + d[b]));
+            q[3] = q[c] + (pk-q[c]) * (d[c]/(btFabs(d[k]) + d[c]));
+            third = k == 1 ? 2 : 3;
+            return 4;
+        }
+            
+        default: //All above water
+            return 0;
+    }
+}
+
+static void ClipFaceRange(HydroMesh& m, size_t first, size_t last)
+{
+    Vector3 q[4];
+    unsigned int third;
+    
+    for(size_t i=first; i<last; ++i)
+    {
+        unsigned int n = ClipFace(m, i, q, third);
+        if(n == 0)
+        {
+            m.area[i] = Scalar(0);
+            continue;
+        }
+        
+        Vector3 fn = (q[1]-q[0]).cross(q[third]-q[0]); //Normal of the (first) triangle (length != 1)
+        Scalar len = fn.length();
+        if(btFuzzyZero(len)) //Check for invalid triangle
+        {
+            m.area[i] = Scalar(0);
+            continue;
+        }
+        
+        Vector3 fc;
+        Scalar A;
+        if(n == 3)
+        {
+            fc = (q[0]+q[1]+q[2])/Scalar(3);
+            A = len/Scalar(2);
+        }
+        else
+        {
+            fc = (q[0]+q[1]+q[2]+q[3])/Scalar(4);
+            A = (len + (q[1]-q[2]).cross(q[3]-q[2]).length())/Scalar(2);
+        }
+        Vector3 fn1 = fn/len;
+        
+        m.cx[i] = fc.x();
+        m.cy[i] = fc.y();
+        m.cz[i] = fc.z();
+        m.nx[i] = fn1.x();
+        m.ny[i] = fn1.y();
+        m.nz[i] = fn1.z();
+        m.area[i] = A;
+    }
+}
+
+#ifdef HYDROMESH_AVX2
+//Four vectors, one per lane
+struct Vector3x4
+{
+    __m256d x, y, z;
+};
+
+//Masked form of the gather, to avoid reading an undefined source register
+static inline __m256d Gather(const Scalar* v, __m128i id)
+{
+    return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), v, id, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8);
+}
+
+static inline Vector3x4 Gather(const Scalar* x, const Scalar* y, const Scalar* z, __m128i id)
+{
+    return {Gather(x, id), Gather(y, id), Gather(z, id)};
+}
+
+static inline Vector3x4 Add(const Vector3x4& a, const Vector3x4& b)
+{
+    return {_mm256_add_pd(a.x, b.x), _mm256_add_pd(a.y, b.y), _mm256_add_pd(a.z, b.z)};
+}
+
+static inline Vector3x4 Sub(const Vector3x4& a, const Vector3x4& b)
+{
+    return {_mm256_sub_pd(a.x, b.x), _mm256_sub_pd(a.y, b.y), _mm256_sub_pd(a.z, b.z)};
+}
+
+static inline Vector3x4 Mul(const Vector3x4& a, __m256d s)
+{
+    return {_mm256_mul_pd(a.x, s), _mm256_mul_pd(a.y, s), _mm256_mul_pd(a.z, s)};
+}
+
+static inline Vector3x4 Cross(const Vector3x4& a, const Vector3x4& b)
+{
+    return {_mm256_sub_pd(_mm256_mul_pd(a.y, b.z), _mm256_mul_pd(a.z, b.y)),
+            _mm256_sub_pd(_mm256_mul_pd(a.z, b.x), _mm256_mul_pd(a.x, b.z)),
+            _mm256_sub_pd(_mm256_mul_pd(a.x, b.y), _mm256_mul_pd(a.y, b.x))};
+}
+
+static inline __m256d Length(const Vector3x4& a)
+{
+    return _mm256_sqrt_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(a.x, a.x), _mm256_mul_pd(a.y, a.y)), _mm256_mul_pd(a.z, a.z)));
+}
+
+//Returns b in lanes where mask is set and a elsewhere
+static inline Vector3x4 Select(const Vector3x4& a, const Vector3x4& b, __m256d mask)
+{
+    return {_mm256_blendv_pd(a.x, b.x, mask), _mm256_blendv_pd(a.y, b.y, mask), _mm256_blendv_pd(a.z, b.z, mask)};
+}
+
+//Point on the edge between a submerged vertex (base) and a vertex above the surface (moved)
+static inline Vector3x4 Intersect(const Vector3x4& base, const Vector3x4& moved, __m256d dBase, __m256d dMovedAbs)
+{
+    return Add(base, Mul(Sub(moved, base), _mm256_div_pd(dBase, _mm256_add_pd(dMovedAbs, dBase))));
+}
+
+static void ClipFaceRangeAVX2(HydroMesh& m, size_t count)
+{
+    const unsigned int* id = m.indices.data();
+    const Scalar* px = m.px.data();
+    const Scalar* py = m.py.data();
+    const Scalar* pz = m.pz.data();
+    const Scalar* depth = m.depth.data();
+    
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d ones = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d eps = _mm256_set1_pd(SIMD_EPSILON);
+    const __m256d half = _mm256_set1_pd(Scalar(1)/Scalar(2));
+    const __m256d third = _mm256_set1_pd(Scalar(1)/Scalar(3));
+    const __m256d quarter = _mm256_set1_pd(Scalar(1)/Scalar(4));
+    const __m256d one = _mm256_set1_pd(Scalar(1));
+    
+    for(size_t i=0; i<count; i+=4)
+    {
+        const unsigned int* f = id + i*3;
+        __m128i id1 = _mm_setr_epi32((int)f[0], (int)f[3], (int)f[6], (int)f[9]);
+        __m128i id2 = _mm_setr_epi32((int)f[1], (int)f[4], (int)f[7], (int)f[10]);
+        __m128i id3 = _mm_setr_epi32((int)f[2], (int)f[5], (int)f[8], (int)f[11]);
+        
+        Vector3x4 p1 = Gather(px, py, pz, id1);
+        Vector3x4 p2 = Gather(px, py, pz, id2);
+        Vector3x4 p3 = Gather(px, py, pz, id3);
+        __m256d d1 = Gather(depth, id1);
+        __m256d d2 = Gather(depth, id2);
+        __m256d d3 = Gather(depth, id3);
+        __m256d ad1 = _mm256_andnot_pd(signMask, d1);
+        __m256d ad2 = _mm256_andnot_pd(signMask, d2);
+        __m256d ad3 = _mm256_andnot_pd(signMask, d3);
+        
+        //Classification of faces
+        __m256d a1 = _mm256_cmp_pd(d1, zero, _CMP_LT_OQ); //Vertex above water
+        __m256d a2 = _mm256_cmp_pd(d2, zero, _CMP_LT_OQ);
+        __m256d a3 = _mm256_cmp_pd(d3, zero, _CMP_LT_OQ);
+        __m256d any = _mm256_or_pd(_mm256_or_pd(a1, a2), a3);
+        __m256d all = _mm256_and_pd(_mm256_and_pd(a1, a2), a3);
+        __m256d twoOrMore = _mm256_or_pd(_mm256_or_pd(_mm256_and_pd(a1, a2), _mm256_and_pd(a1, a3)), _mm256_and_pd(a2, a3));
+        __m256d quad = _mm256_andnot_pd(twoOrMore, any); //One vertex above water
+        if(_mm256_movemask_pd(all) == 0xF)
+        {
+            _mm256_storeu_pd(&m.area[i], zero);
+            continue;
+        }
+        
+        //Two vertices above water: move them towards the submerged one
+        __m256d u1 = _mm256_xor_pd(a1, ones);
+        __m256d u2 = _mm256_xor_pd(a2, ones);
+        Vector3x4 pu = Select(Select(p3, p2, u2), p1, u1);
+        __m256d du = _mm256_blendv_pd(_mm256_blendv_pd(d3, d2, u2), d1, u1);
+        
+        //One vertex above water: move it towards two submerged ones
+        Vector3x4 pa = Select(Select(p3, p2, a2), p1, a1);
+        __m256d ada = _mm256_blendv_pd(_mm256_blendv_pd(ad3, ad2, a2), ad1, a1);
+        Vector3x4 pb = Select(p2, p1, a2);
+        __m256d db = _mm256_blendv_pd(d2, d1, a2);
+        Vector3x4 pc = Select(p3, p1, a3);
+        __m256d dc = _mm256_blendv_pd(d3, d1, a3);
+        Vector3x4 q = Intersect(pb, pa, db, ada);
+        Vector3x4 p4 = Intersect(pc, pa, dc, ada);
+        
+        p1 = Select(p1, Select(Intersect(pu, p1, du, ad1), q, quad), a1);
+        p2 = Select(p2, Select(Intersect(pu, p2, du, ad2), q, quad), a2);
+        p3 = Select(p3, Select(Intersect(pu, p3, du, ad3), q, quad), a3);
+        
+        //Normal of the (first) triangle (length != 1)
+        Vector3x4 pt = Select(p3, p4, _mm256_andnot_pd(a2, quad));
+        Vector3x4 fn = Cross(Sub(p2, p1), Sub(pt, p1));
+        __m256d len = Length(fn);
+        __m256d len2 = Length(Cross(Sub(p2, p3), Sub(p4, p3)));
+        
+        Vector3x4 sum = Add(Add(p1, p2), p3);
+        Vector3x4 fc = Select(Mul(sum, third), Mul(Add(sum, p4), quarter), quad);
+        __m256d A = _mm256_blendv_pd(_mm256_mul_pd(len, half), _mm256_mul_pd(_mm256_add_pd(len, len2), half), quad);
+        Vector3x4 fn1 = Mul(fn, _mm256_div_pd(one, len));
+        
+        //Faces above water or invalid get zero area
+        __m256d valid = _mm256_andnot_pd(all, _mm256_cmp_pd(len, eps, _CMP_NLT_UQ));
+        
+        _mm256_storeu_pd(&m.cx[i], fc.x);
+        _mm256_storeu_pd(&m.cy[i], fc.y);
+        _mm256_storeu_pd(&m.cz[i], fc.z);
+        _mm256_storeu_pd(&m.nx[i], fn1.x);
+        _mm256_storeu_pd(&m.ny[i], fn1.y);
+        _mm256_storeu_pd(&m.nz[i], fn1.z);
+        _mm256_storeu_pd(&m.area[i], _mm256_and_pd(A, valid));
+    }
+}
+#endif
+
+HydroMesh::HydroMesh(const Mesh* mesh)
+{
+    size_t nv = mesh->getNumOfVertices();
+    x.resize(nv);
+    y.resize(nv);
+    z.resize(nv);
+    for(size_t i=0; i<nv; ++i)
+    {
+        glm::vec3 pos = mesh->getVertexPos(i);
+        x[i] = pos.x;
+        y[i] = pos.y;
+        z[i] = pos.z;
+    }
+    
+    size_t nf = mesh->faces.size();
+    indices.resize(nf * 3);
+    for(size_t i=0; i<nf; ++i)
+    {
+        indices[i*3] = mesh->faces[i].vertexID[0];
+        indices[i*3+1] = mesh->faces[i].vertexID[1];
+        indices[i*3+2] = mesh->faces[i].vertexID[2];
+    }
+    
+    ResizeScratch();
+}
+
+void HydroMesh::ResizeScratch()
+{
+    size_t nv = getNumOfVertices();
+    size_t nf = getNumOfFaces();
+    px.resize(nv);
+    py.resize(nv);
+    pz.resize(nv);
+    depth.resize(nv);
+    cx.resize(nf);
+    cy.resize(nf);
+    cz.resize(nf);
+    nx.resize(nf);
+    ny.resize(nf);
+    nz.resize(nf);
+    area.resize(nf);
+    faceIds.resize(nf);
+    pressure.resize(nf);
+    ux.resize(nf);
+    uy.resize(nf);
+    uz.resize(nf);
+}
+
+//Symmetric 4x4 matrix of the quadric error (a2 ab ac ad b2 bc bd c2 cd d2)
+struct Quadric
+{
+    Scalar q[10];
+    
+    Quadric() { std::fill(q, q+10, Scalar(0)); }
+    
+    void AddPlane(const Vector3& n, Scalar d)
+    {
+        q[0] += n.x()*n.x(); q[1] += n.x()*n.y(); q[2] += n.x()*n.z(); q[3] += n.x()*d;
+        q[4] += n.y()*n.y(); q[5] += n.y()*n.z(); q[6] += n.y()*d;
+        q[7] += n.z()*n.z(); q[8] += n.z()*d;
+        q[9] += d*d;
+    }
+    
+    void Add(const Quadric& o)
+    {
+        for(unsigned int i=0; i<10; ++i)
+            q[i] += o.q[i];
+    }
+    
+    Scalar Evaluate(const Vector3& v) const
+    {
+        Scalar x = v.x(), y = v.y(), z = v.z();
+        return q[0]*x*x + Scalar(2)*q[1]*x*y + Scalar(2)*q[2]*x*z + Scalar(2)*q[3]*x
+             + q[4]*y*y + Scalar(2)*q[5]*y*z + Scalar(2)*q[6]*y
+             + q[7]*z*z + Scalar(2)*q[8]*z + q[9];
+    }
+    
+    //Position minimising the error, if the system is well conditioned
+    bool Minimum(Vector3& v) const
+    {
+        Scalar det = q[0]*(q[4]*q[7] - q[5]*q[5]) - q[1]*(q[1]*q[7] - q[5]*q[2]) + q[2]*(q[1]*q[5] - q[4]*q[2]);
+        Scalar scale = q[0]*q[4]*q[7];
+        if(btFabs(det) <= Scalar(1e-9) * btFabs(scale) || btFuzzyZero(det))
+            return false;
+        
+        Scalar bx = -q[3], by = -q[6], bz = -q[8];
+        Scalar dx = bx*(q[4]*q[7] - q[5]*q[5]) - q[1]*(by*q[7] - q[5]*bz) + q[2]*(by*q[5] - q[4]*bz);
+        Scalar dy = q[0]*(by*q[7] - bz*q[5]) - bx*(q[1]*q[7] - q[5]*q[2]) + q[2]*(q[1]*bz - by*q[2]);
+        Scalar dz = q[0]*(q[4]*bz - q[5]*by) - q[1]*(q[1]*bz - by*q[2]) + bx*(q[1]*q[5] - q[4]*q[2]);
+        v = Vector3(dx/det, dy/det, dz/det);
+        return true;
+    }
+};
+
+struct EdgeCollapse
+{
+    Scalar cost;
+    unsigned int v1, v2;
+    unsigned int stamp1, stamp2;
+    Vector3 pos;
+    
+    bool operator>(const EdgeCollapse& o) const { return cost > o.cost; }
+};
+
+//Volume enclosed by the mesh and its centroid (meaningful for closed meshes)
+static void ComputeVolume(const HydroMesh& m, Scalar& V, Vector3& C)
+{
+    V = Scalar(0);
+    C.setZero();
+    
+    for(size_t i=0; i<m.getNumOfFaces(); ++i)
+    {
+        unsigned int i1 = m.indices[i*3], i2 = m.indices[i*3+1], i3 = m.indices[i*3+2];
+        Vector3 p1(m.x[i1], m.y[i1], m.z[i1]);
+        Vector3 p2(m.x[i2], m.y[i2], m.z[i2]);
+        Vector3 p3(m.x[i3], m.y[i3], m.z[i3]);
+        Scalar Vi = p1.dot(p2.cross(p3))/Scalar(6); //Signed volume of the tetrahedron with apex at origin
+        V += Vi;
+        C += (p1 + p2 + p3) * (Vi/Scalar(4));
+    }
+    
+    if(!btFuzzyZero(V))
+        C /= V;
+}
+
+void HydroMesh::Decimate(unsigned int maxFaces, Scalar maxError)
+{
+    size_t nv = getNumOfVertices();
+    size_t nf = getNumOfFaces();
+    if((maxFaces == 0 && maxError <= Scalar(0)) || (maxFaces > 0 && nf <= maxFaces))
+        return;
+    
+    Scalar V0;
+    Vector3 C0;
+    ComputeVolume(*this, V0, C0);
+    
+    //Vertex quadrics and face adjacency
+    std::vector<Vector3> pos(nv);
+    std::vector<Quadric> Q(nv);
+    std::vector<std::vector<unsigned int>> vFaces(nv);
+    std::vector<unsigned int> stamp(nv, 0);
+    std::vector<bool> vAlive(nv, true);
+    std::vector<bool> fAlive(nf, true);
+    std::vector<std::pair<unsigned int, unsigned int>> edges;
+    edges.reserve(nf*3);
+    
+    for(size_t i=0; i<nv; ++i)
+        pos[i] = Vector3(x[i], y[i], z[i]);
+    
+    for(size_t i=0; i<nf; ++i)
+    {
+        unsigned int* f = &indices[i*3];
+        Vector3 n = (pos[f[1]]-pos[f[0]]).cross(pos[f[2]]-pos[f[0]]);
+        Scalar len = n.length();
+        if(!btFuzzyZero(len))
+        {
+            n /= len;
+            Scalar d = -n.dot(pos[f[0]]);
+            for(unsigned int k=0; k<3; ++k)
+                Q[f[k]].AddPlane(n, d);
+        }
+        for(unsigned int k=0; k<3; ++k)
+        {
+            vFaces[f[k]].push_back((unsigned int)i);
+            edges.push_back(std::make_pair(std::min(f[k], f[(k+1)%3]), std::max(f[k], f[(k+1)%3])));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    
+    //Open edges are kept in place with planes perpendicular to the adjacent face
+    bool closed = true;
+    for(size_t i=0; i<edges.size(); ++i)
+    {
+        bool shared = (i > 0 && edges[i-1] == edges[i]) || (i+1 < edges.size() && edges[i+1] == edges[i]);
+        if(shared)
+            continue;
+        
+        closed = false;
+        unsigned int a = edges[i].first;
+        unsigned int b = edges[i].second;
+        for(size_t j=0; j<vFaces[a].size(); ++j)
+        {
+            unsigned int* f = &indices[vFaces[a][j]*3];
+            if(f[0] != b && f[1] != b && f[2] != b)
+                continue;
+            Vector3 fn = (pos[f[1]]-pos[f[0]]).cross(pos[f[2]]-pos[f[0]]);
+            Vector3 n = (pos[b]-pos[a]).cross(fn);
+            Scalar len = n.length();
+            if(btFuzzyZero(len))
+                break;
+            n /= len;
+            Scalar d = -n.dot(pos[a]);
+            for(unsigned int k=0; k<10; ++k) //Strong constraint
+            {
+                Q[a].AddPlane(n, d);
+                Q[b].AddPlane(n, d);
+            }
+            break;
+        }
+    }
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    
+    //Queue of collapses ordered by the error
+    std::priority_queue<EdgeCollapse, std::vector<EdgeCollapse>, std::greater<EdgeCollapse>> queue;
+    auto pushCollapse = [&](unsigned int a, unsigned int b)
+    {
+        Quadric q = Q[a];
+        q.Add(Q[b]);
+        EdgeCollapse c;
+        c.v1 = a;
+        c.v2 = b;
+        c.stamp1 = stamp[a];
+        c.stamp2 = stamp[b];
+        
+        if(!q.Minimum(c.pos)) //Best of the ends and the midpoint
+        {
+            Vector3 candidates[3] = {pos[a], pos[b], (pos[a] + pos[b]) * Scalar(0.5)};
+            c.pos = candidates[0];
+            for(unsigned int k=1; k<3; ++k)
+                if(q.Evaluate(candidates[k]) < q.Evaluate(c.pos))
+                    c.pos = candidates[k];
+        }
+        c.cost = btMax(q.Evaluate(c.pos), Scalar(0));
+        queue.push(c);
+    };
+    
+    for(size_t i=0; i<edges.size(); ++i)
+        pushCollapse(edges[i].first, edges[i].second);
+    edges.clear();
+    edges.shrink_to_fit();
+    
+    //Collapse edges
+    size_t faces = nf;
+    std::vector<unsigned int> neighbours;
+    
+    while(!queue.empty() && (maxFaces == 0 || faces > maxFaces))
+    {
+        EdgeCollapse c = queue.top();
+        queue.pop();
+        
+        if(maxError > Scalar(0) && btSqrt(c.cost) > maxError) //Quadric error is a sum of squared distances
+            break;
+        if(!vAlive[c.v1] || !vAlive[c.v2] || stamp[c.v1] != c.stamp1 || stamp[c.v2] != c.stamp2)
+            continue; //Outdated
+        
+        //Topology check: the ends of the edge can only share the vertices opposite to the edge
+        unsigned int common = 0;
+        neighbours.clear();
+        for(unsigned int e=0; e<2; ++e)
+        {
+            unsigned int v = e == 0 ? c.v1 : c.v2;
+            for(size_t j=0; j<vFaces[v].size(); ++j)
+            {
+                unsigned int fid = vFaces[v][j];
+                if(!fAlive[fid]) continue;
+                for(unsigned int k=0; k<3; ++k)
+                {
+                    unsigned int n = indices[fid*3+k];
+                    if(n != c.v1 && n != c.v2)
+                        neighbours.push_back(n + (e == 0 ? 0 : (unsigned int)nv)); //Tag the side
+                }
+            }
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        for(size_t j=0; j<neighbours.size() && neighbours[j] < nv; ++j)
+            if(std::binary_search(neighbours.begin(), neighbours.end(), neighbours[j] + (unsigned int)nv))
+                ++common;
+        if(common > 2)
+            continue;
+        
+        //Geometry check: the collapse can not flip any of the remaining faces
+        bool flip = false;
+        for(unsigned int e=0; e<2 && !flip; ++e)
+        {
+            unsigned int v = e == 0 ? c.v1 : c.v2;
+            for(size_t j=0; j<vFaces[v].size() && !flip; ++j)
+            {
+                unsigned int fid = vFaces[v][j];
+                if(!fAlive[fid]) continue;
+                const unsigned int* f = &indices[fid*3];
+                Vector3 p[3];
+                bool collapsed = false;
+                for(unsigned int k=0; k<3; ++k)
+                {
+                    if(f[k] == c.v1 || f[k] == c.v2)
+                    {
+                        p[k] = c.pos;
+                        collapsed = collapsed || f[k] != v;
+                    }
+                    else
+                        p[k] = pos[f[k]];
+                }
+                if(collapsed) //Face removed by the collapse
+                    continue;
+                Vector3 n0 = (pos[f[1]]-pos[f[0]]).cross(pos[f[2]]-pos[f[0]]);
+                Vector3 n1 = (p[1]-p[0]).cross(p[2]-p[0]);
+                flip = n0.dot(n1) <= Scalar(0);
+            }
+        }
+        if(flip)
+            continue;
+        
+        //Collapse v2 into v1
+        pos[c.v1] = c.pos;
+        Q[c.v1].Add(Q[c.v2]);
+        vAlive[c.v2] = false;
+        ++stamp[c.v1];
+        
+        for(size_t j=0; j<vFaces[c.v2].size(); ++j)
+        {
+            unsigned int fid = vFaces[c.v2][j];
+            if(!fAlive[fid]) continue;
+            unsigned int* f = &indices[fid*3];
+            if(f[0] == c.v1 || f[1] == c.v1 || f[2] == c.v1)
+            {
+                fAlive[fid] = false;
+                --faces;
+            }
+            else
+            {
+                for(unsigned int k=0; k<3; ++k)
+                    if(f[k] == c.v2) f[k] = c.v1;
+                vFaces[c.v1].push_back(fid);
+            }
+        }
+        vFaces[c.v2].clear();
+        
+        std::vector<unsigned int>& v1Faces = vFaces[c.v1];
+        v1Faces.erase(std::remove_if(v1Faces.begin(), v1Faces.end(), [&](unsigned int fid) { return !fAlive[fid]; }), v1Faces.end());
+        
+        //New collapses of the edges around the merged vertex
+        neighbours.clear();
+        for(size_t j=0; j<v1Faces.size(); ++j)
+            for(unsigned int k=0; k<3; ++k)
+                if(indices[v1Faces[j]*3+k] != c.v1)
+                    neighbours.push_back(indices[v1Faces[j]*3+k]);
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        for(size_t j=0; j<neighbours.size(); ++j)
+            pushCollapse(c.v1, neighbours[j]);
+    }
+    
+    //Rebuild the mesh from the remaining faces
+    const unsigned int unused = std::numeric_limits<unsigned int>::max();
+    std::vector<unsigned int> map(nv, unused);
+    std::vector<unsigned int> newIndices;
+    newIndices.reserve(faces*3);
+    x.clear();
+    y.clear();
+    z.clear();
+    for(size_t i=0; i<nf; ++i)
+    {
+        if(!fAlive[i]) continue;
+        for(unsigned int k=0; k<3; ++k)
+        {
+            unsigned int v = indices[i*3+k];
+            if(map[v] == unused)
+            {
+                map[v] = (unsigned int)x.size();
+                x.push_back(pos[v].x());
+                y.push_back(pos[v].y());
+                z.push_back(pos[v].z());
+            }
+            newIndices.push_back(map[v]);
+        }
+    }
+    indices.swap(newIndices);
+    
+    //Restore volume and centroid
+    Scalar V1;
+    Vector3 C1;
+    ComputeVolume(*this, V1, C1);
+    if(closed && !btFuzzyZero(V0) && V0/V1 > Scalar(0))
+    {
+        Scalar s = btPow(V0/V1, Scalar(1)/Scalar(3));
+        for(size_t i=0; i<x.size(); ++i)
+        {
+            x[i] = C0.x() + (x[i] - C1.x()) * s;
+            y[i] = C0.y() + (y[i] - C1.y()) * s;
+            z[i] = C0.z() + (z[i] - C1.z()) * s;
+        }
+    }
+    
+    ResizeScratch();
+}
+
+void HydroMesh::TransformVertices(const Transform& T)
+{
+    const Matrix3& R = T.getBasis();
+    const Vector3& o = T.getOrigin();
+    const Scalar r00 = R[0][0], r01 = R[0][1], r02 = R[0][2];
+    const Scalar r10 = R[1][0], r11 = R[1][1], r12 = R[1][2];
+    const Scalar r20 = R[2][0], r21 = R[2][1], r22 = R[2][2];
+    const Scalar ox = o.x(), oy = o.y(), oz = o.z();
+    
+    const Scalar* __restrict lx = x.data();
+    const Scalar* __restrict ly = y.data();
+    const Scalar* __restrict lz = z.data();
+    Scalar* __restrict wx = px.data();
+    Scalar* __restrict wy = py.data();
+    Scalar* __restrict wz = pz.data();
+    size_t nv = x.size();
+    
+    for(size_t i=0; i<nv; ++i)
+    {
+        wx[i] = r00 * lx[i] + r01 * ly[i] + r02 * lz[i] + ox;
+        wy[i] = r10 * lx[i] + r11 * ly[i] + r12 * lz[i] + oy;
+        wz[i] = r20 * lx[i] + r21 * ly[i] + r22 * lz[i] + oz;
+    }
+}
+
+void HydroMesh::ComputeFaces()
+{
+    const unsigned int* __restrict id = indices.data();
+    size_t nf = getNumOfFaces();
+    
+    for(size_t i=0; i<nf; ++i)
+    {
+        unsigned int i1 = id[i*3], i2 = id[i*3+1], i3 = id[i*3+2];
+        
+        //Sides of the face
+        Scalar v1x = px[i2] - px[i1], v1y = py[i2] - py[i1], v1z = pz[i2] - pz[i1];
+        Scalar v2x = px[i3] - px[i1], v2y = py[i3] - py[i1], v2z = pz[i3] - pz[i1];
+        
+        //Normal of the face (length != 1)
+        Scalar fnx = v1y * v2z - v1z * v2y;
+        Scalar fny = v1z * v2x - v1x * v2z;
+        Scalar fnz = v1x * v2y - v1y * v2x;
+        Scalar len2 = fnx * fnx + fny * fny + fnz * fnz;
+        Scalar len = btSqrt(len2);
+        bool valid = len2 >= SIMD_EPSILON * SIMD_EPSILON; //Check for invalid triangle (same as btFuzzyZero(len))
+        Scalar invLen = valid ? Scalar(1)/len : Scalar(0);
+        
+        //Same operation order as the Vector3 arithmetic, to obtain identical results
+        const Scalar third = Scalar(1)/Scalar(3);
+        cx[i] = (px[i1] + px[i2] + px[i3]) * third;
+        cy[i] = (py[i1] + py[i2] + py[i3]) * third;
+        cz[i] = (pz[i1] + pz[i2] + pz[i3]) * third;
+        nx[i] = fnx * invLen;
+        ny[i] = fny * invLen;
+        nz[i] = fnz * invLen;
+        area[i] = valid ? len/Scalar(2) : Scalar(0); //Removed by CompactFaces
+    }
+}
+
+void HydroMesh::ClipFaces()
+{
+    ClipFacesVectorised();
+}
+
+void HydroMesh::ClipFacesScalar()
+{
+    ClipFaceRange(*this, 0, getNumOfFaces());
+}
+
+void HydroMesh::ClipFacesVectorised()
+{
+    size_t nf = getNumOfFaces();
+#ifdef HYDROMESH_AVX2
+    size_t nv = nf & ~(size_t)3;
+    ClipFaceRangeAVX2(*this, nv);
+    ClipFaceRange(*this, nv, nf); //Remaining faces
+#else
+    ClipFaceRange(*this, 0, nf);
+#endif
+}
+
+size_t HydroMesh::CompactFaces()
+{
+    size_t nf = getNumOfFaces();
+    size_t m = 0;
+    
+    for(size_t i=0; i<nf; ++i)
+    {
+        if(area[i] == Scalar(0))
+            continue;
+        
+        if(m != i)
+        {
+            cx[m] = cx[i];
+            cy[m] = cy[i];
+            cz[m] = cz[i];
+            nx[m] = nx[i];
+            ny[m] = ny[i];
+            nz[m] = nz[i];
+            area[m] = area[i];
+        }
+        faceIds[m] = (unsigned int)i;
+        ++m;
+    }
+    return m;
+}
+
+unsigned int HydroMesh::getClippedPolygon(size_t faceID, Vector3 points[4]) const
+{
+    unsigned int third;
+    unsigned int n = ClipFace(*this, faceID, points, third);
+    
+    if(n == 4)
+    {
+        if(third == 2) //Clipped corner between the other two
+            std::swap(points[2], points[3]);
+    }
+    else if(n == 3 && depth[indices[faceID*3]] >= Scalar(0) && depth[indices[faceID*3+1]] >= Scalar(0) && depth[indices[faceID*3+2]] >= Scalar(0))
+        n = 0; //Not crossing the surface
+    
+    return n;
+}
+
+bool HydroMesh::isVectorised()
+{
+#ifdef HYDROMESH_AVX2
+    return true;
+#else
+    return false;
+#endif
+}
+
+}
@@ -48,7 +48,7 @@ MovingEntity::~MovingEntity()
 {
 }
 
-Material MovingEntity::getMaterial() const
+const Material& MovingEntity::getMaterial() const
 {
     return mat;
 }
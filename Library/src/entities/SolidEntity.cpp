@@ -28,11 +28,15 @@
 #include "core/GraphicalSimulationApp.h"
 #include "core/SimulationManager.h"
 #include "core/Console.h"
+#include "core/StateBuffer.h"
+#include "core/AssetCache.h"
+#include "core/CloneContext.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 #include "utils/SystemUtil.hpp"
 #include "entities/forcefields/Ocean.h"
 #include "entities/forcefields/Atmosphere.h"
+#include "entities/HydroMesh.h"
 #include <iostream>
 #include <algorithm>
 
@@ -93,7 +97,9 @@ SolidEntity::SolidEntity(std::string uniqueName, std::string material, BodyPhysi
     //Set pointers
     rigidBody = NULL;
     multibodyCollider = NULL;
+    colShape = NULL;
     phyMesh = nullptr;
+    hydroMesh = nullptr;
     graObjectId = -1;
     phyObjectId = -1;
     dm = DisplayMode::GRAPHICAL;
@@ -102,7 +108,8 @@ SolidEntity::SolidEntity(std::string uniqueName, std::string material, BodyPhysi
 
 SolidEntity::~SolidEntity()
 {
-    if(phyMesh != nullptr) delete phyMesh;
+    AssetCache::ReleaseMesh(phyMesh);
+    if(hydroMesh != nullptr) delete hydroMesh;
 }
 
 EntityType SolidEntity::getType() const
@@ -556,6 +563,25 @@ void SolidEntity::getGeometryApprox(GeometryApproxType& type, std::vector<Scalar
     params = fdApproxParams;
 }
 
+void SolidEntity::SimplifyHydroMesh(unsigned int maxFaces, Scalar maxError)
+{
+    HydroMesh* mesh = getHydroMesh();
+    if(mesh == nullptr)
+        return;
+    
+    size_t nf = mesh->getNumOfFaces();
+    mesh->Decimate(maxFaces, maxError);
+    if(mesh->getNumOfFaces() < nf)
+        cInfo("Simplified hydrodynamics mesh of %s (faces: %lu -> %lu).", getName().c_str(), (unsigned long)nf, (unsigned long)mesh->getNumOfFaces());
+}
+
+HydroMesh* SolidEntity::getHydroMesh()
+{
+    if(hydroMesh == nullptr && phyMesh != nullptr)
+        hydroMesh = new HydroMesh(phyMesh);
+    return hydroMesh;
+}
+
 const Mesh* SolidEntity::getPhysicsMesh()
 {
     return phyMesh;
@@ -945,6 +971,30 @@ void SolidEntity::BuildGraphicalObject()
     phyObjectId = graObjectId;
 }
 
+btCompoundShape* SolidEntity::BuildCGCollisionShape()
+{
+    btCollisionShape* colShape0 = BuildCollisionShape();
+    btCompoundShape* cgShape;
+    
+    if(colShape0->getShapeType() == COMPOUND_SHAPE_PROXYTYPE) //For a compound shape just move the children to avoid additional level
+    {
+        cgShape = (btCompoundShape*)colShape0;
+        for(int i=0; i < cgShape->getNumChildShapes(); ++i)
+        {
+            cgShape->getChildShape(i)->setMargin(Scalar(0));
+            cgShape->updateChildTransform(i, T_CG2C * cgShape->getChildTransform(i), true);
+        }
+    }
+    else //For other shapes, create compound shape which allow for the shift against gravity centre
+    {
+        cgShape = new btCompoundShape();
+        colShape0->setMargin(Scalar(0));
+        cgShape->addChildShape(T_CG2C, colShape0);
+    }
+    cgShape->setMargin(Scalar(0));
+    return cgShape;
+}
+
 void SolidEntity::BuildRigidBody()
 {
     if(rigidBody == NULL)
@@ -952,25 +1002,8 @@ void SolidEntity::BuildRigidBody()
         btDefaultMotionState* motionState = new btDefaultMotionState();
         
         //Generate collision shape
-        btCollisionShape* colShape0 = BuildCollisionShape();
-        btCompoundShape* colShape;
-        
-        if(colShape0->getShapeType() == COMPOUND_SHAPE_PROXYTYPE) //For a compound shape just move the children to avoid additional level
-        {
-            colShape = (btCompoundShape*)colShape0;
-            for(int i=0; i < colShape->getNumChildShapes(); ++i)
-            {
-                colShape->getChildShape(i)->setMargin(Scalar(0));
-                colShape->updateChildTransform(i, T_CG2C * colShape->getChildTransform(i), true);
-            }
-        }
-        else //For other shapes, create compound shape which allow for the shift against gravity centre
-        {
-            colShape = new btCompoundShape();
-            colShape0->setMargin(Scalar(0));
-            colShape->addChildShape(T_CG2C, colShape0);
-        }
-        colShape->setMargin(Scalar(0));
+        if(colShape == NULL)
+            colShape = BuildCGCollisionShape();
         
         //Construct Bullet rigid body
         Scalar M = getAugmentedMass();
@@ -1003,25 +1036,8 @@ void SolidEntity::BuildMultibodyLinkCollider(btMultiBody *mb, unsigned int child
     if(multibodyCollider == NULL)
     {
         //Generate collision shape
-        btCollisionShape* colShape0 = BuildCollisionShape();
-        btCompoundShape* colShape;
-        if(colShape0->getShapeType() == COMPOUND_SHAPE_PROXYTYPE) //For a compound shape just move the children to avoid additional level
-        {
-            colShape = (btCompoundShape*)colShape0;
-            for(int i=0; i < colShape->getNumChildShapes(); ++i)
-            {
-                colShape->getChildShape(i)->setMargin(Scalar(0));
-                colShape->updateChildTransform(i, T_CG2C * colShape->getChildTransform(i), true);
-            }
-        }
-        else //For other shapes, create compound shape which allow for the shift against gravity centre
-        {
-            colShape = new btCompoundShape();
-            colShape0->setMargin(Scalar(0));
-            colShape->addChildShape(T_CG2C, colShape0);
-            
-        }
-        colShape->setMargin(Scalar(0));
+        if(colShape == NULL)
+            colShape = BuildCGCollisionShape();
         
         //Construct Bullet multi-body link
         multibodyCollider = new btMultiBodyLinkCollider(mb, child - 1);
@@ -1069,6 +1085,105 @@ void SolidEntity::AddToSimulation(SimulationManager *sm, const Transform& origin
     }
 }
 
+Entity* SolidEntity::Clone(CloneContext& ctx)
+{
+    SolidEntity* copy = Copy(ctx);
+    if(copy != NULL)
+        copy->AddToSimulation(ctx.getSimulationManager(), getOTransform());
+    return copy;
+}
+
+SolidEntity* SolidEntity::Copy(CloneContext& ctx)
+{
+    cError("Solid '%s' cannot be cloned!", getName().c_str());
+    return NULL;
+}
+
+void SolidEntity::InitCopy(CloneContext& ctx)
+{
+    AssetCache::AddReference(phyMesh);
+    AssetCache::AddReference(colShape);
+    if(hydroMesh != nullptr)
+        hydroMesh = new HydroMesh(*hydroMesh);
+    rigidBody = NULL;
+    multibodyCollider = NULL;
+    graObjectId = -1;
+    phyObjectId = -1;
+    submerged.points.clear();
+}
+
+void SolidEntity::SaveState(StateBuffer& state)
+{
+    if(rigidBody != NULL)
+    {
+        Transform trans;
+        rigidBody->getMotionState()->getWorldTransform(trans);
+        state.Write(trans);
+        state.Write(rigidBody->getCenterOfMassTransform());
+        state.Write(rigidBody->getLinearVelocity());
+        state.Write(rigidBody->getAngularVelocity());
+        state.Write((uint32_t)rigidBody->getActivationState());
+        state.Write(rigidBody->getDeactivationTime());
+    }
+    state.Write(filteredLinearVel);
+    state.Write(filteredAngularVel);
+    state.Write(linearAcc);
+    state.Write(angularAcc);
+    
+    //Fluid forces are recomputed at a lower rate, so the cached terms are applied in the steps in between
+    state.Write(Fb);
+    state.Write(Tb);
+    state.Write(Fdl);
+    state.Write(Tdl);
+    state.Write(Fdq);
+    state.Write(Tdq);
+    state.Write(Fds);
+    state.Write(Tds);
+    state.Write(Fda);
+    state.Write(Tda);
+}
+
+void SolidEntity::RestoreState(StateBuffer& state)
+{
+    if(rigidBody != NULL)
+    {
+        Transform trans;
+        Vector3 v, w;
+        uint32_t activation;
+        Scalar deactivationTime;
+        state.Read(trans);
+        rigidBody->getMotionState()->setWorldTransform(trans);
+        state.Read(trans);
+        rigidBody->setCenterOfMassTransform(trans);
+        state.Read(v);
+        state.Read(w);
+        rigidBody->setLinearVelocity(v);
+        rigidBody->setAngularVelocity(w);
+        rigidBody->setInterpolationLinearVelocity(v);
+        rigidBody->setInterpolationAngularVelocity(w);
+        rigidBody->clearForces();
+        state.Read(activation);
+        state.Read(deactivationTime);
+        rigidBody->forceActivationState((int)activation);
+        rigidBody->setDeactivationTime(deactivationTime);
+    }
+    state.Read(filteredLinearVel);
+    state.Read(filteredAngularVel);
+    state.Read(linearAcc);
+    state.Read(angularAcc);
+    
+    state.Read(Fb);
+    state.Read(Tb);
+    state.Read(Fdl);
+    state.Read(Tdl);
+    state.Read(Fdq);
+    state.Read(Tdq);
+    state.Read(Fds);
+    state.Read(Tds);
+    state.Read(Fda);
+    state.Read(Tda);
+}
+
 void SolidEntity::UpdateAcceleration(Scalar dt)
 {
     //Filter velocity
@@ -1131,15 +1246,20 @@ BodyFluidPosition SolidEntity::CheckBodyFluidPosition(Ocean* ocn)
     getAABB(aabbMin, aabbMax);
     Vector3 d = aabbMax-aabbMin;
     
+    //Corners of the bounding box
+    Scalar x[8], y[8], z[8], depth[8];
+    for(unsigned int i=0; i<8; ++i)
+    {
+        Vector3 corner = aabbMin + Vector3(i & 1 ? d.x() : Scalar(0), i & 2 ? d.y() : Scalar(0), i & 4 ? d.z() : Scalar(0));
+        x[i] = corner.x();
+        y[i] = corner.y();
+        z[i] = corner.z();
+    }
+    ocn->GetDepth(x, y, z, 8, depth);
+    
     unsigned int submerged = 0;
-    if(ocn->GetDepth(aabbMin) > Scalar(0)) ++submerged;
-    if(ocn->GetDepth(aabbMax) > Scalar(0)) ++submerged;
-    if(ocn->GetDepth(aabbMin + Vector3(d.x(), 0, 0)) > Scalar(0)) ++submerged;
-    if(ocn->GetDepth(aabbMin + Vector3(0, d.y(), 0)) > Scalar(0)) ++submerged;
-    if(ocn->GetDepth(aabbMin + Vector3(d.x(), d.y(), 0)) > Scalar(0)) ++submerged;
-    if(ocn->GetDepth(aabbMin + Vector3(0, 0, d.z())) > Scalar(0)) ++submerged;
-    if(ocn->GetDepth(aabbMin + Vector3(d.x(), 0, d.z())) > Scalar(0)) ++submerged;
-    if(ocn->GetDepth(aabbMin + Vector3(0, d.y(), d.z())) > Scalar(0)) ++submerged;
+    for(unsigned int i=0; i<8; ++i)
+        if(depth[i] > Scalar(0)) ++submerged;
     
     if(submerged == 0)
         return BodyFluidPosition::OUTSIDE;
@@ -1209,7 +1329,7 @@ void SolidEntity::CorrectHydrodynamicForces(Ocean* ocn, Vector3& _Fdl, Vector3&
     _Tds *= 0.1 * 0.5 * ocn->getLiquid().density;
 }
 
-void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings& settings, const Mesh* mesh, Ocean* ocn, const Transform& T_CG, const Transform& T_C,
+void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings& settings, HydroMesh* mesh, Ocean* ocn, const Transform& T_CG, const Transform& T_C,
                                             const Vector3& v, const Vector3& omega, Vector3& _Fb, Vector3& _Tb, Vector3& _Fdl, Vector3& _Tdl, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fds, Vector3& _Tds, Renderable& debug)
 {
     //Buoyancy
@@ -1235,261 +1355,49 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
       
     //Calculate fluid dynamics forces and torques
     Vector3 p = T_CG.getOrigin();
+    
+    //Transform vertices and find their depth once (vertices are shared by many faces)
+    mesh->TransformVertices(T_C);
+    const WaveHeightTile* tile = nullptr;
+    if(ocn->hasWaves()) //Resample the waves around the mesh once, so that each query is a single bilinear fetch
+    {
+        auto xr = std::minmax_element(mesh->px.begin(), mesh->px.end());
+        auto yr = std::minmax_element(mesh->py.begin(), mesh->py.end());
+        ocn->UpdateWaveTile(mesh->waveTile, *xr.first, *yr.first, *xr.second, *yr.second, mesh->getNumOfVertices()/2);
+        tile = &mesh->waveTile;
+    }
+    ocn->GetDepth(mesh->px.data(), mesh->py.data(), mesh->pz.data(), mesh->getNumOfVertices(), mesh->depth.data(), tile);
  
-    //Loop through all faces...
-    for(size_t i=0; i<mesh->faces.size(); ++i)
+    //Clip faces against the surface and keep the submerged ones
+    mesh->ClipFaces();
+    size_t nSubmerged = mesh->CompactFaces();
+    
+    //Query the fluid at face centroids in batches
+    if(settings.reallisticBuoyancy)
+        ocn->GetPressure(mesh->cx.data(), mesh->cy.data(), mesh->cz.data(), nSubmerged, mesh->pressure.data(), tile);
+    if(settings.dampingForces)
+        ocn->GetFluidVelocity(mesh->cx.data(), mesh->cy.data(), mesh->cz.data(), nSubmerged, mesh->ux.data(), mesh->uy.data(), mesh->uz.data());
+    
+    //Loop through all submerged faces...
+    for(size_t i=0; i<nSubmerged; ++i)
     {
-        //Global coordinates
-        glm::vec3 p1gl = mesh->getVertexPos(i, 0);
-        glm::vec3 p2gl = mesh->getVertexPos(i, 1);
-        glm::vec3 p3gl = mesh->getVertexPos(i, 2);
-        Vector3 p1 = T_C * Vector3(p1gl.x,p1gl.y,p1gl.z);
-        Vector3 p2 = T_C * Vector3(p2gl.x,p2gl.y,p2gl.z);
-        Vector3 p3 = T_C * Vector3(p3gl.x,p3gl.y,p3gl.z);
-        
-        //Check if face underwater
-        Scalar depth[3];
-        depth[0] = ocn->GetDepth(p1);
-        depth[1] = ocn->GetDepth(p2);
-        depth[2] = ocn->GetDepth(p3);
-        
-        if(depth[0] < Scalar(0) && depth[1] < Scalar(0) && depth[2] < Scalar(0))
-            continue;
-        
-        //Calculate face properties
-        Vector3 fc;
-        Vector3 fn;
-        Vector3 fn1;
-        Scalar A;
-        
-        if(depth[0] < Scalar(0)) //Vertex 1 above water
-        {
-            if(depth[1] < Scalar(0)) //Two vertices above water (triangle)
-            {
-                p1 = p3 + (p1-p3) * (depth[2]/(btFabs(depth[0]) + depth[2]));
-                p2 = p3 + (p2-p3) * (depth[2]/(btFabs(depth[1]) + depth[2]));
-                //p3 without change
-                
-                //Calculate
-                Vector3 fv1 = p2-p1; //One side of the face (triangle)
-                Vector3 fv2 = p3-p1; //Another side of the face (triangle)
-                fc = (p1+p2+p3)/Scalar(3); //Face centroid
-        
-                fn = fv1.cross(fv2); //Normal of the face (length != 1)
-                Scalar len = fn.length();
-                
-                if(btFuzzyZero(len)) //Check for invalid triangle
-                    continue;
-                
-                fn1 = fn/len; //Normalised normal (length = 1)
-                A = len/Scalar(2); //Area of the face (triangle)                
-#ifdef DEBUG
-                debug.points.push_back(glm::vec3((GLfloat)p1.x(), (GLfloat)p1.y(), (GLfloat)p1.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p2.x(), (GLfloat)p2.y(), (GLfloat)p2.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p2.x(), (GLfloat)p2.y(), (GLfloat)p2.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p3.x(), (GLfloat)p3.y(), (GLfloat)p3.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p3.x(), (GLfloat)p3.y(), (GLfloat)p3.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p1.x(), (GLfloat)p1.y(), (GLfloat)p1.z()));
-#endif
-            }
-            else if(depth[2] < Scalar(0)) //Two vertices above water (triangle)
-            {
-                p1 = p2 + (p1-p2) * (depth[1]/(btFabs(depth[0]) + depth[1]));
-                //p2 without change
-                p3 = p2 + (p3-p2) * (depth[1]/(btFabs(depth[2]) + depth[1]));
-                
-                //Calculate
-                Vector3 fv1 = p2-p1; //One side of the face (triangle)
-                Vector3 fv2 = p3-p1; //Another side of the face (triangle)
-                fc = (p1+p2+p3)/Scalar(3); //Face centroid
-        
-                fn = fv1.cross(fv2); //Normal of the face (length != 1)
-                Scalar len = fn.length();
-                
-                if(btFuzzyZero(len)) //Check for invalid triangle
-                    continue;
-                
-                fn1 = fn/len; //Normalised normal (length = 1)
-                A = len/Scalar(2); //Area of the face (triangle)         
-#ifdef DEBUG
-                debug.points.push_back(glm::vec3((GLfloat)p1.x(), (GLfloat)p1.y(), (GLfloat)p1.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p2.x(), (GLfloat)p2.y(), (GLfloat)p2.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p2.x(), (GLfloat)p2.y(), (GLfloat)p2.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p3.x(), (GLfloat)p3.y(), (GLfloat)p3.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p3.x(), (GLfloat)p3.y(), (GLfloat)p3.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p1.x(), (GLfloat)p1.y(), (GLfloat)p1.z()));
-#endif
-            }
-            else //depth[1] >= 0 && depth[2] >= 0 --> Two vertices under water (quad = two triangles)
-            {
-                //Quad!!!!
-                Vector3 p1temp = p2 + (p1-p2) * (depth[1]/(btFabs(depth[0]) + depth[1]));
-                //p2 without change
-                //p3 without change
-                Vector3 p4 = p3 + (p1-p3) * (depth[2]/(btFabs(depth[0]) + depth[2]));
-                p1 = p1temp;
-                
-                //Calculate
-                Vector3 fv1 = p2-p1;
-                Vector3 fv2 = p4-p1;
-                Vector3 fv3 = p2-p3;
-                Vector3 fv4 = p4-p3;
-                
-                fc = (p1 + p2 + p3 + p4)/Scalar(4);
-                fn = fv1.cross(fv2);
-                Scalar len = fn.length();
-                
-                if(btFuzzyZero(len)) //Check validity
-                    continue;
-                
-                fn1 = fn/len;
-                A = (len + fv3.cross(fv4).length())/Scalar(2); //Quad
-                fn = fn1 * A;
-#ifdef DEBUG
-                debug.points.push_back(glm::vec3((GLfloat)p1.x(), (GLfloat)p1.y(), (GLfloat)p1.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p2.x(), (GLfloat)p2.y(), (GLfloat)p2.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p2.x(), (GLfloat)p2.y(), (GLfloat)p2.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p3.x(), (GLfloat)p3.y(), (GLfloat)p3.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p3.x(), (GLfloat)p3.y(), (GLfloat)p3.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p4.x(), (GLfloat)p4.y(), (GLfloat)p4.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p4.x(), (GLfloat)p4.y(), (GLfloat)p4.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p1.x(), (GLfloat)p1.y(), (GLfloat)p1.z()));
-#endif  
-            }
-        }
-        else if(depth[1] < Scalar(0))
-        {
-            if(depth[2] < Scalar(0))
-            {
-                //p1 without change
-                p2 = p1 + (p2-p1) * (depth[0]/(btFabs(depth[1]) + depth[0]));
-                p3 = p1 + (p3-p1) * (depth[0]/(btFabs(depth[2]) + depth[0]));
-                
-                //Calculate
-                Vector3 fv1 = p2-p1; //One side of the face (triangle)
-                Vector3 fv2 = p3-p1; //Another side of the face (triangle)
-                fc = (p1+p2+p3)/Scalar(3); //Face centroid
-        
-                fn = fv1.cross(fv2); //Normal of the face (length != 1)
-                Scalar len = fn.length();
-                
-                if(btFuzzyZero(len))
-                    continue;
-                
-                fn1 = fn/len; //Normalised normal (length = 1)
-                A = len/Scalar(2); //Area of the face (triangle)
-#ifdef DEBUG
-                debug.points.push_back(glm::vec3((GLfloat)p1.x(), (GLfloat)p1.y(), (GLfloat)p1.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p2.x(), (GLfloat)p2.y(), (GLfloat)p2.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p2.x(), (GLfloat)p2.y(), (GLfloat)p2.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p3.x(), (GLfloat)p3.y(), (GLfloat)p3.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p3.x(), (GLfloat)p3.y(), (GLfloat)p3.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p1.x(), (GLfloat)p1.y(), (GLfloat)p1.z()));
-#endif                
-            }
-            else
-            {
-                //Quad!!!!
-                //p1 without change
-                Vector3 p2temp = p1 + (p2-p1) * (depth[0]/(btFabs(depth[1]) + depth[0]));
-                //p3 without change
-                Vector3 p4 = p3 + (p2-p3) * (depth[2]/(btFabs(depth[1]) + depth[2]));
-                p2 = p2temp;
-                
-                //Calculate
-                Vector3 fv1 = p2-p1;
-                Vector3 fv2 = p3-p1;
-                Vector3 fv3 = p2-p3;
-                Vector3 fv4 = p4-p3;
-                
-                fc = (p1 + p2 + p3 + p4)/Scalar(4);
-                fn = fv1.cross(fv2); //Triangle 1
-                Scalar len = fn.length();
-                
-                if(btFuzzyZero(len)) //Check validity
-                    continue;
-                
-                fn1 = fn/len;
-                A = (len + fv3.cross(fv4).length())/Scalar(2); //Quad
-                fn = fn1 * A;
-#ifdef DEBUG
-                debug.points.push_back(glm::vec3((GLfloat)p1.x(), (GLfloat)p1.y(), (GLfloat)p1.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p2.x(), (GLfloat)p2.y(), (GLfloat)p2.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p2.x(), (GLfloat)p2.y(), (GLfloat)p2.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p4.x(), (GLfloat)p4.y(), (GLfloat)p4.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p4.x(), (GLfloat)p4.y(), (GLfloat)p4.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p3.x(), (GLfloat)p3.y(), (GLfloat)p3.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p3.x(), (GLfloat)p3.y(), (GLfloat)p3.z()));
-                debug.points.push_back(glm::vec3((GLfloat)p1.x(), (GLfloat)p1.y(), (GLfloat)p1.z()));
-#endif                 
-            }
-        }
-        else if(depth[2] < Scalar(0))
-        {
-            //Quad!!!!
-            //p1 without change
-            //p2 without change
-            Vector3 p3temp = p2 + (p3-p2) * (depth[1]/(btFabs(depth[2]) + depth[1]));
-            Vector3 p4 = p1 + (p3-p1) * (depth[0]/(btFabs(depth[2]) + depth[0]));
-            p3 = p3temp;
-                
-            //Calculate
-            Vector3 fv1 = p2-p1;
-            Vector3 fv2 = p4-p1;
-            Vector3 fv3 = p2-p3;
-            Vector3 fv4 = p4-p3;
-                
-            fc = (p1 + p2 + p3 + p4)/Scalar(4);
-            fn = fv1.cross(fv2);
-            Scalar len = fn.length();
-            
-            if(btFuzzyZero(len)) //Check validity
-                continue;
-            
-            fn1 = fn/len;
-            A = (len + fv3.cross(fv4).length())/Scalar(2); //Quad
-            fn = fn1 * A;
+        Scalar A = mesh->area[i]; //Area of the submerged part of the face
+        Vector3 fc(mesh->cx[i], mesh->cy[i], mesh->cz[i]); //Face centroid
+        Vector3 fn1(mesh->nx[i], mesh->ny[i], mesh->nz[i]); //Normalised normal (length = 1)
 #ifdef DEBUG
-            debug.points.push_back(glm::vec3((GLfloat)p1.x(), (GLfloat)p1.y(), (GLfloat)p1.z()));
-            debug.points.push_back(glm::vec3((GLfloat)p2.x(), (GLfloat)p2.y(), (GLfloat)p2.z()));
-            debug.points.push_back(glm::vec3((GLfloat)p2.x(), (GLfloat)p2.y(), (GLfloat)p2.z()));
-            debug.points.push_back(glm::vec3((GLfloat)p3.x(), (GLfloat)p3.y(), (GLfloat)p3.z()));
-            debug.points.push_back(glm::vec3((GLfloat)p3.x(), (GLfloat)p3.y(), (GLfloat)p3.z()));
-            debug.points.push_back(glm::vec3((GLfloat)p4.x(), (GLfloat)p4.y(), (GLfloat)p4.z()));
-            debug.points.push_back(glm::vec3((GLfloat)p4.x(), (GLfloat)p4.y(), (GLfloat)p4.z()));
-            debug.points.push_back(glm::vec3((GLfloat)p1.x(), (GLfloat)p1.y(), (GLfloat)p1.z()));
-#endif             
-        }
-        else //All underwater
+        Vector3 q[4];
+        unsigned int n = mesh->getClippedPolygon(mesh->faceIds[i], q);
+        for(unsigned int k=0; k<n; ++k)
         {
-            Vector3 fv1 = p2-p1; //One side of the face (triangle)
-            Vector3 fv2 = p3-p1; //Another side of the face (triangle)
-            fc = (p1+p2+p3)/Scalar(3); //Face centroid
-        
-            fn = fv1.cross(fv2); //Normal of the face (length != 1)
-            Scalar len = fn.length();
-            
-            if(btFuzzyZero(len))
-                continue;
-            
-            fn1 = fn/len; //Normalised normal (length = 1)
-            A = len/Scalar(2); //Area of the face (triangle)
-#ifdef DEBUGG
-            debug.points.push_back(glm::vec3((GLfloat)p1.x(), (GLfloat)p1.y(), (GLfloat)p1.z()));
-            debug.points.push_back(glm::vec3((GLfloat)p2.x(), (GLfloat)p2.y(), (GLfloat)p2.z()));
-            debug.points.push_back(glm::vec3((GLfloat)p2.x(), (GLfloat)p2.y(), (GLfloat)p2.z()));
-            debug.points.push_back(glm::vec3((GLfloat)p3.x(), (GLfloat)p3.y(), (GLfloat)p3.z()));
-            debug.points.push_back(glm::vec3((GLfloat)p3.x(), (GLfloat)p3.y(), (GLfloat)p3.z()));
-            debug.points.push_back(glm::vec3((GLfloat)p1.x(), (GLfloat)p1.y(), (GLfloat)p1.z()));
-#endif             
+            debug.points.push_back(glm::vec3((GLfloat)q[k].x(), (GLfloat)q[k].y(), (GLfloat)q[k].z()));
+            debug.points.push_back(glm::vec3((GLfloat)q[(k+1)%n].x(), (GLfloat)q[(k+1)%n].y(), (GLfloat)q[(k+1)%n].z()));
         }
-        
-        Scalar pressure = ocn->GetPressure(fc);
+#endif
         
         //Buoyancy force
         if(settings.reallisticBuoyancy)
         {
-            Vector3 Fbi = -fn1 * A * pressure; //Buoyancy force per face (based on pressure)
+            Vector3 Fbi = -fn1 * A * mesh->pressure[i]; //Buoyancy force per face (based on pressure)
             
             //Accumulate
             _Fb += Fbi;
@@ -1499,7 +1407,7 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
         //Damping force
         if(settings.dampingForces)
         {
-            Vector3 vc = ocn->GetFluidVelocity(fc) - (v + omega.cross(fc - p)); //Water velocity at face center
+            Vector3 vc = Vector3(mesh->ux[i], mesh->uy[i], mesh->uz[i]) - (v + omega.cross(fc - p)); //Water velocity at face center
             Vector3 Fdlf;
             Vector3 Fdqf;
             Vector3 Fdsf;
@@ -1516,7 +1424,7 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
     }
 }
 
-void SolidEntity::ComputeHydrodynamicForcesSubmerged(const Mesh* mesh, Ocean* ocn, const Transform& T_CG, const Transform& T_C,
+void SolidEntity::ComputeHydrodynamicForcesSubmerged(HydroMesh* mesh, Ocean* ocn, const Transform& T_CG, const Transform& T_C,
                                               const Vector3& v, const Vector3& omega, Vector3& _Fdl, Vector3& _Tdl, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fds, Vector3& _Tds)
 {
     if(mesh == nullptr) return;
@@ -1532,31 +1440,23 @@ void SolidEntity::ComputeHydrodynamicForcesSubmerged(const Mesh* mesh, Ocean* oc
     //Calculate fluid dynamics forces and torques
     Vector3 p = T_CG.getOrigin();
     
+    //Transform vertices once and compute face properties in a single pass (skipping faces with two sides parallel)
+    mesh->TransformVertices(T_C);
+    mesh->ComputeFaces();
+    size_t nValid = mesh->CompactFaces();
+    
+    //Query the fluid at face centroids in a batch
+    ocn->GetFluidVelocity(mesh->cx.data(), mesh->cy.data(), mesh->cz.data(), nValid, mesh->ux.data(), mesh->uy.data(), mesh->uz.data());
+    
     //Loop through all faces...
-    for(unsigned int i=0; i<mesh->faces.size(); ++i)
+    for(size_t i=0; i<nValid; ++i)
     {
-        //Global coordinates
-        glm::vec3 p1gl = mesh->getVertexPos(i, 0);
-        glm::vec3 p2gl = mesh->getVertexPos(i, 1);
-        glm::vec3 p3gl = mesh->getVertexPos(i, 2);
-        Vector3 p1 = T_C * Vector3(p1gl.x,p1gl.y,p1gl.z);
-        Vector3 p2 = T_C * Vector3(p2gl.x,p2gl.y,p2gl.z);
-        Vector3 p3 = T_C * Vector3(p3gl.x,p3gl.y,p3gl.z);
-        
-        //Calculate face properties
-        Vector3 fv1 = p2-p1; //One side of the face (triangle)
-        Vector3 fv2 = p3-p1; //Another side of the face (triangle)
-        Vector3 fn = fv1.cross(fv2); //Normal of the face (length != 1)
-        Scalar len = fn.safeNorm();
-        
-        if(len == Scalar(0)) continue; //If triangle is incorrect (two sides parallel)
-        
-        Vector3 fc = (p1+p2+p3)/Scalar(3); //Face centroid
-        Vector3 fn1 = fn/len; //Normalised normal (length = 1)
-        Scalar A = len/Scalar(2); //Area of the face (triangle)
+        Scalar A = mesh->area[i]; //Area of the face (triangle)
+        Vector3 fc(mesh->cx[i], mesh->cy[i], mesh->cz[i]); //Face centroid
+        Vector3 fn1(mesh->nx[i], mesh->ny[i], mesh->nz[i]); //Normalised normal (length = 1)
         
         //Damping forces
-        Vector3 vc = ocn->GetFluidVelocity(fc) - (v + omega.cross(fc - p)); //Water velocity at face center
+        Vector3 vc = Vector3(mesh->ux[i], mesh->uy[i], mesh->uz[i]) - (v + omega.cross(fc - p)); //Water velocity at face center
         Vector3 Fdlf;
         Vector3 Fdqf;
         Vector3 Fdsf;
@@ -1612,12 +1512,12 @@ void SolidEntity::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocea
         }
         
         if(settings.dampingForces)
-            ComputeHydrodynamicForcesSubmerged(getPhysicsMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fdl, Tdl, Fdq, Tdq, Fds, Tds);
+            ComputeHydrodynamicForcesSubmerged(getHydroMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fdl, Tdl, Fdq, Tdq, Fds, Tds);
     }
     else //CROSSING_FLUID_SURFACE
     {
         if(!isBuoyant()) settings.reallisticBuoyancy = false;
-        ComputeHydrodynamicForcesSurface(settings, getPhysicsMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fb, Tb, Fdl, Tdl, Fdq, Tdq, Fds, Tds, submerged);
+        ComputeHydrodynamicForcesSurface(settings, getHydroMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fb, Tb, Fdl, Tdl, Fdq, Tdq, Fds, Tds, submerged);
     }
     
     if(settings.dampingForces)
@@ -27,6 +27,8 @@
 
 #include "core/GraphicalSimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/AssetCache.h"
+#include "core/CloneContext.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 
@@ -48,7 +50,7 @@ StaticEntity::StaticEntity(std::string uniqueName, std::string material, std::st
 
 StaticEntity::~StaticEntity()
 {
-    if(phyMesh != NULL) delete phyMesh;
+    AssetCache::ReleaseMesh(phyMesh);
 }
 
 EntityType StaticEntity::getType() const
@@ -56,7 +58,7 @@ EntityType StaticEntity::getType() const
     return EntityType::STATIC;
 }
 
-Material StaticEntity::getMaterial() const
+const Material& StaticEntity::getMaterial() const
 {
     return mat;
 }
@@ -146,6 +148,20 @@ void StaticEntity::BuildRigidBody(btCollisionShape* shape)
     BuildGraphicalObject();
 }
 
+void StaticEntity::InitCopy(CloneContext& ctx)
+{
+    //Share the collision shape and the mesh, create own rigid body in the world of the context
+    btCollisionShape* shape = rigidBody->getCollisionShape();
+    Transform trans;
+    rigidBody->getMotionState()->getWorldTransform(trans);
+    AssetCache::AddReference(shape);
+    AssetCache::AddReference(phyMesh);
+    phyObjectId = -1;
+    BuildRigidBody(shape);
+    rigidBody->setMotionState(new btDefaultMotionState(trans));
+    ctx.getSimulationManager()->getDynamicsWorld()->addRigidBody(rigidBody, MASK_STATIC, MASK_STATIC | MASK_DEFAULT);
+}
+
 void StaticEntity::AddToSimulation(SimulationManager* sm)
 {
     AddToSimulation(sm, Transform::getIdentity());
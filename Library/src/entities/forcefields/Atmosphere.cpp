@@ -27,6 +27,8 @@
 #include "graphics/OpenGLAtmosphere.h"
 #include "entities/forcefields/VelocityField.h"
 #include "entities/SolidEntity.h"
+#include "core/CloneContext.h"
+#include "core/Console.h"
 
 namespace sf
 {
@@ -162,14 +164,17 @@ void Atmosphere::ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co,
     if(ent->getType() == EntityType::SOLID)
     {
         if(recompute)
-        {
-            ((SolidEntity*)ent)->ComputeAerodynamicForces(this);
-        }
+            ComputeFluidForces((SolidEntity*)ent);
         
         ((SolidEntity*)ent)->ApplyAerodynamicForces();
     }
 }
 
+void Atmosphere::ComputeFluidForces(SolidEntity* solid)
+{
+    solid->ComputeAerodynamicForces(this);
+}
+
 int Atmosphere::JulianDay(std::tm& tm)
 {
     int m = tm.tm_mon + 1;
@@ -186,4 +191,28 @@ int Atmosphere::JulianDay(std::tm& tm)
     return B + 38 - (int)trunc(W);
 }
 
+Entity* Atmosphere::Clone(CloneContext& ctx)
+{
+    std::vector<VelocityField*> fields;
+    for(size_t i=0; i<wind.size(); ++i)
+    {
+        VelocityField* field = wind[i]->Copy();
+        if(field == NULL)
+        {
+            cError("Atmosphere: Velocity field %lu cannot be cloned!", (unsigned long)i);
+            for(size_t h=0; h<fields.size(); ++h)
+                delete fields[h];
+            return NULL;
+        }
+        fields.push_back(field);
+    }
+    
+    Atmosphere* copy = new Atmosphere(*this);
+    copy->InitCopy(ctx);
+    copy->wind = fields;
+    copy->glAtmosphere = NULL;
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
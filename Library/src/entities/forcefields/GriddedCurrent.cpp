@@ -0,0 +1,309 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  GriddedCurrent.cpp
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+
+#include "entities/forcefields/GriddedCurrent.h"
+
+#include <algorithm>
+#include <cstring>
+#ifdef _MSC_VER
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "core/Console.h"
+#include "core/AssetCache.h"
+
+#define GRIDDED_CURRENT_HEADER_SIZE 88
+#define GRIDDED_CURRENT_BRICK_SHIFT 3
+#define GRIDDED_CURRENT_BRICK_MASK 7
+
+namespace sf
+{
+
+GriddedCurrent::GriddedCurrent(const std::string& filename)
+{
+    mapping = NULL;
+    mappingSize = 0;
+    data = NULL;
+    nx = ny = nz = nt = 0;
+    bricksX = bricksY = 0;
+    stepSize = 0;
+    t0 = dt = Scalar(0);
+    tPosition = Scalar(0);
+    origin = Vector3(0,0,0);
+    spacing = Vector3(0,0,0);
+    invSpacing = Vector3(0,0,0);
+    
+    //Map file to memory
+#ifdef _MSC_VER
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+    if(file != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER size;
+        if(GetFileSizeEx(file, &size) && size.QuadPart > 0)
+        {
+            HANDLE view = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if(view != NULL)
+            {
+                mapping = MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0);
+                mappingSize = (size_t)size.QuadPart;
+                CloseHandle(view);
+            }
+        }
+        CloseHandle(file);
+    }
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if(fd >= 0)
+    {
+        struct stat st;
+        if(fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if(ptr != MAP_FAILED)
+            {
+                posix_madvise(ptr, (size_t)st.st_size, POSIX_MADV_RANDOM); //Queries touch scattered bricks
+                mapping = ptr;
+                mappingSize = (size_t)st.st_size;
+            }
+        }
+        close(fd);
+    }
+#endif
+    if(mapping == NULL)
+    {
+        cError("Failed to map current data from file '%s'!", filename.c_str());
+        return;
+    }
+    
+    //Read header
+    const char* bytes = (const char*)mapping;
+    uint32_t version = 0;
+    uint32_t dims[4] = {0, 0, 0, 0};
+    double geom[8];
+    if(mappingSize >= GRIDDED_CURRENT_HEADER_SIZE)
+    {
+        memcpy(&version, bytes + 4, sizeof(uint32_t));
+        memcpy(dims, bytes + 8, sizeof(dims));
+        memcpy(geom, bytes + 24, sizeof(geom));
+    }
+    
+    if(mappingSize < GRIDDED_CURRENT_HEADER_SIZE || memcmp(bytes, "SFCG", 4) != 0 || version != 1
+       || dims[0] < 2 || dims[1] < 2 || dims[2] < 1 || dims[3] < 1
+       || !(geom[4] > 0.0) || !(geom[5] > 0.0) || !(geom[6] > 0.0) || (dims[3] > 1 && !(geom[7] > 0.0)))
+    {
+        cError("Current data file '%s' has an invalid header!", filename.c_str());
+        return;
+    }
+    
+    nx = dims[0];
+    ny = dims[1];
+    nz = dims[2];
+    nt = dims[3];
+    bricksX = (nx + GRIDDED_CURRENT_BRICK_MASK) >> GRIDDED_CURRENT_BRICK_SHIFT;
+    bricksY = (ny + GRIDDED_CURRENT_BRICK_MASK) >> GRIDDED_CURRENT_BRICK_SHIFT;
+    unsigned int bricksZ = (nz + GRIDDED_CURRENT_BRICK_MASK) >> GRIDDED_CURRENT_BRICK_SHIFT;
+    stepSize = (size_t)bricksX * bricksY * bricksZ * (1 << (3 * GRIDDED_CURRENT_BRICK_SHIFT)) * 3;
+    
+    if(mappingSize < GRIDDED_CURRENT_HEADER_SIZE + stepSize * nt * sizeof(float))
+    {
+        cError("Current data file '%s' is truncated!", filename.c_str());
+        nx = ny = nz = nt = 0;
+        return;
+    }
+    
+    data = (const float*)(bytes + GRIDDED_CURRENT_HEADER_SIZE);
+    origin = Vector3(geom[0], geom[1], geom[2]);
+    spacing = Vector3(geom[4], geom[5], geom[6]);
+    invSpacing = Vector3(Scalar(1)/spacing.x(), Scalar(1)/spacing.y(), Scalar(1)/spacing.z());
+    t0 = geom[3];
+    dt = geom[7];
+    Update(Scalar(0));
+}
+
+GriddedCurrent::GriddedCurrent(const GriddedCurrent& other) : VelocityField(other)
+{
+    mapping = other.mapping;
+    mappingSize = other.mappingSize;
+    data = other.data;
+    nx = other.nx;
+    ny = other.ny;
+    nz = other.nz;
+    nt = other.nt;
+    bricksX = other.bricksX;
+    bricksY = other.bricksY;
+    stepSize = other.stepSize;
+    origin = other.origin;
+    spacing = other.spacing;
+    invSpacing = other.invSpacing;
+    t0 = other.t0;
+    dt = other.dt;
+    tPosition = other.tPosition.load();
+    AssetCache::AddReference(mapping); //The mapped file is shared between copies
+}
+
+GriddedCurrent::~GriddedCurrent()
+{
+    if(mapping != NULL && AssetCache::RemoveReference(mapping))
+    {
+#ifdef _MSC_VER
+        UnmapViewOfFile(mapping);
+#else
+        munmap(mapping, mappingSize);
+#endif
+    }
+}
+
+bool GriddedCurrent::isValid() const
+{
+    return data != NULL;
+}
+
+const float* GriddedCurrent::getSample(const float* step, unsigned int i, unsigned int j, unsigned int k) const
+{
+    size_t brick = ((size_t)(k >> GRIDDED_CURRENT_BRICK_SHIFT) * bricksY + (j >> GRIDDED_CURRENT_BRICK_SHIFT)) * bricksX + (i >> GRIDDED_CURRENT_BRICK_SHIFT);
+    size_t cell = (((k & GRIDDED_CURRENT_BRICK_MASK) << GRIDDED_CURRENT_BRICK_SHIFT) + (j & GRIDDED_CURRENT_BRICK_MASK)) << GRIDDED_CURRENT_BRICK_SHIFT | (i & GRIDDED_CURRENT_BRICK_MASK);
+    return step + ((brick << (3 * GRIDDED_CURRENT_BRICK_SHIFT)) + cell) * 3;
+}
+
+void GriddedCurrent::Update(Scalar t)
+{
+    if(nt < 2)
+        return;
+    
+    tPosition.store(btClamped((t - t0)/dt, Scalar(0), Scalar(nt - 1)), std::memory_order_relaxed);
+}
+
+Vector3 GriddedCurrent::GetVelocityAtPoint(const Vector3& p)
+{
+    Scalar x = p.x(), y = p.y(), z = p.z();
+    Scalar vx(0), vy(0), vz(0);
+    AddVelocityAtPoints(&x, &y, &z, 1, &vx, &vy, &vz);
+    return Vector3(vx, vy, vz);
+}
+
+void GriddedCurrent::AddVelocityAtPoints(const Scalar* x, const Scalar* y, const Scalar* z, size_t n, Scalar* vx, Scalar* vy, Scalar* vz)
+{
+    if(data == NULL)
+        return;
+    
+    //The time step and the weight are derived from a single value, because Update is called from another thread than Render
+    const Scalar ft = tPosition.load(std::memory_order_relaxed);
+    const unsigned int tIndex = nt > 1 ? std::min((unsigned int)ft, nt - 2) : 0;
+    const float* step0 = data + stepSize * tIndex;
+    const float* step1 = nt > 1 ? step0 + stepSize : step0;
+    const Scalar w1 = ft - Scalar(tIndex);
+    const Scalar w0 = Scalar(1) - w1;
+    const Scalar xMax = Scalar(nx - 1);
+    const Scalar yMax = Scalar(ny - 1);
+    const Scalar zMax = Scalar(nz - 1);
+    
+    for(size_t h=0; h<n; ++h)
+    {
+        Scalar fx = (x[h] - origin.x()) * invSpacing.x();
+        Scalar fy = (y[h] - origin.y()) * invSpacing.y();
+        if(!(fx >= Scalar(0) && fx <= xMax && fy >= Scalar(0) && fy <= yMax)) //Outside of the grid (or NaN)
+            continue;
+        Scalar fz = btClamped((z[h] - origin.z()) * invSpacing.z(), Scalar(0), zMax);
+        
+        //Cell and weights (the last cell is used for points on the far boundary)
+        unsigned int i = std::min((unsigned int)fx, nx - 2);
+        unsigned int j = std::min((unsigned int)fy, ny - 2);
+        unsigned int k = nz > 1 ? std::min((unsigned int)fz, nz - 2) : 0;
+        unsigned int dk = nz > 1 ? 1 : 0;
+        Scalar a = fx - Scalar(i);
+        Scalar b = fy - Scalar(j);
+        Scalar c = fz - Scalar(k);
+        Scalar w[8] = {(1-a)*(1-b)*(1-c), a*(1-b)*(1-c), (1-a)*b*(1-c), a*b*(1-c),
+                       (1-a)*(1-b)*c,     a*(1-b)*c,     (1-a)*b*c,     a*b*c};
+        
+        Scalar u[3] = {0, 0, 0};
+        for(unsigned int m=0; m<8; ++m)
+        {
+            unsigned int ci = i + (m & 1);
+            unsigned int cj = j + ((m >> 1) & 1);
+            unsigned int ck = k + ((m >> 2) & 1) * dk;
+            const float* s0 = getSample(step0, ci, cj, ck);
+            const float* s1 = getSample(step1, ci, cj, ck);
+            for(unsigned int d=0; d<3; ++d)
+                u[d] += w[m] * (w0 * Scalar(s0[d]) + w1 * Scalar(s1[d]));
+        }
+        
+        vx[h] += u[0];
+        vy[h] += u[1];
+        vz[h] += u[2];
+    }
+}
+
+std::vector<Renderable> GriddedCurrent::Render(VelocityFieldUBO& ubo)
+{
+    std::vector<Renderable> items(0);
+    ubo.posR = glm::vec4(0.f);
+    ubo.dirV = glm::vec4(0.f);
+    ubo.params = glm::vec3(0.f);
+    ubo.type = 0;
+    
+    if(data == NULL)
+        return items;
+    
+    //Particles are driven by the velocity at the top of the grid centre
+    Vector3 size((nx - 1) * spacing.x(), (ny - 1) * spacing.y(), (nz - 1) * spacing.z());
+    Vector3 v = GetVelocityAtPoint(origin + Vector3(size.x()/Scalar(2), size.y()/Scalar(2), Scalar(0)));
+    Scalar vel = v.length();
+    Vector3 dir = vel > Scalar(0) ? (v/vel) : Vector3(0,0,0);
+    ubo.dirV = glm::vec4((GLfloat)dir.getX(), (GLfloat)dir.getY(), (GLfloat)dir.getZ(), (GLfloat)vel);
+    
+    //Extent of the grid
+    Renderable box;
+    box.type = RenderableType::HYDRO_LINES;
+    box.model = glm::mat4(1.f);
+    for(unsigned int e=0; e<12; ++e)
+    {
+        unsigned int axis = e / 4;
+        unsigned int c1 = e % 4;
+        for(unsigned int end=0; end<2; ++end)
+        {
+            Scalar f[3];
+            f[axis] = Scalar(end);
+            f[(axis + 1) % 3] = Scalar(c1 & 1);
+            f[(axis + 2) % 3] = Scalar((c1 >> 1) & 1);
+            Vector3 corner = origin + Vector3(f[0] * size.x(), f[1] * size.y(), f[2] * size.z());
+            box.points.push_back(glm::vec3((GLfloat)corner.x(), (GLfloat)corner.y(), (GLfloat)corner.z()));
+        }
+    }
+    items.push_back(box);
+    return items;
+}
+
+VelocityField* GriddedCurrent::Copy() const
+{
+    return new GriddedCurrent(*this);
+}
+
+}
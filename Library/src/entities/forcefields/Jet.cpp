@@ -59,6 +59,38 @@ Vector3 Jet::GetVelocityAtPoint(const Vector3& p)
     return f*vmax;
 }
 
+void Jet::AddVelocityAtPoints(const Scalar* x, const Scalar* y, const Scalar* z, size_t count, Scalar* vx, Scalar* vy, Scalar* vz)
+{
+    //Same operations as in GetVelocityAtPoint, on separate components
+    const Scalar cx = c.x(), cy = c.y(), cz = c.z();
+    const Scalar nx = n.x(), ny = n.y(), nz = n.z();
+    
+    for(size_t i=0; i<count; ++i)
+    {
+        //Calculate distance to axis
+        Scalar cpx = x[i] - cx, cpy = y[i] - cy, cpz = z[i] - cz;
+        Scalar ax = cpy * nz - cpz * ny;
+        Scalar ay = cpz * nx - cpx * nz;
+        Scalar az = cpx * ny - cpy * nx;
+        Scalar d = btSqrt(ax * ax + ay * ay + az * az);
+        
+        //Calculate distance from outlet
+        Scalar t = cpx * nx + cpy * ny + cpz * nz;
+        if(t < 0.0) continue;
+        
+        //Calculate radius at point
+        Scalar r_ = Scalar(1)/Scalar(5)*(t + Scalar(5)*r);
+        if(d >= r_) continue;
+        
+        //Central velocity and its fraction
+        Scalar vmax = Scalar(10)*r/(t + Scalar(5)*r) * vout;
+        Scalar f = btExp(-Scalar(50)*d*d/(t*t));
+        vx[i] += nx * vmax * f;
+        vy[i] += ny * vmax * f;
+        vz[i] += nz * vmax * f;
+    }
+}
+
 std::vector<Renderable> Jet::Render(VelocityFieldUBO& ubo)
 {
     std::vector<Renderable> items(0);
@@ -110,4 +142,9 @@ std::vector<Renderable> Jet::Render(VelocityFieldUBO& ubo)
     return items;
 }
 
+VelocityField* Jet::Copy() const
+{
+    return new Jet(*this);
+}
+
 }
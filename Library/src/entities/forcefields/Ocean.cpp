@@ -27,7 +27,10 @@
 
 #include <algorithm>
 #include "utils/SystemUtil.hpp"
+#include "core/CloneContext.h"
+#include "core/Console.h"
 #include "entities/forcefields/VelocityField.h"
+#include "entities/forcefields/WaveSimulator.h"
 #include "entities/SolidEntity.h"
 #include "graphics/OpenGLFlatOcean.h"
 #include "graphics/OpenGLRealOcean.h"
@@ -53,8 +56,12 @@ Ocean::Ocean(std::string uniqueName, Scalar waves, Fluid l) : ForcefieldEntity(u
     liquid = l;
     wavesDebug.type = RenderableType::HYDRO_POINTS;
     wavesDebug.model = glm::mat4(1.f);
+    wavesDebugMutex = SDL_CreateMutex();
+    wavesDebugEnabled = false;
+    wavesDebugMaxPoints = 0;
     waterType = Scalar(0.0);
     glOcean = NULL;
+    waveSim = NULL;
 }
 
 Ocean::~Ocean()
@@ -68,6 +75,28 @@ Ocean::~Ocean()
     
     if(glOcean != NULL)
         delete glOcean;
+    
+    if(waveSim != NULL)
+        delete waveSim;
+    
+    SDL_DestroyMutex(wavesDebugMutex);
+}
+
+Ocean::Ocean(const Ocean& other) : ForcefieldEntity(other)
+{
+    liquid = other.liquid;
+    currents = other.currents;
+    glOcean = other.glOcean;
+    waveSim = other.waveSim;
+    glOceanCurrentsUBOData = other.glOceanCurrentsUBOData;
+    depth = other.depth;
+    waterType = other.waterType;
+    oceanState = other.oceanState;
+    currentsEnabled = other.currentsEnabled;
+    wavesDebug = other.wavesDebug;
+    wavesDebugMutex = other.wavesDebugMutex;
+    wavesDebugEnabled = other.wavesDebugEnabled.load();
+    wavesDebugMaxPoints = other.wavesDebugMaxPoints;
 }
 
 bool Ocean::hasWaves() const
@@ -116,40 +145,152 @@ bool Ocean::IsInsideFluid(const Vector3& point)
 
 Scalar Ocean::GetDepth(const Vector3& point)
 {
-    if(hasWaves()) //Geometric waves
+    Scalar x = point.x(), y = point.y(), z = point.z();
+    Scalar d;
+    GetDepth(&x, &y, &z, 1, &d);
+    return d;
+}
+
+void Ocean::GetDepth(const Scalar* x, const Scalar* y, const Scalar* z, size_t n, Scalar* d, const WaveHeightTile* tile)
+{
+    if(!hasWaves() || (waveSim == NULL && glOcean == NULL)) //Flat surface
     {
-        GLfloat waveHeight = glOcean->ComputeWaveHeight((GLfloat)point.x(), (GLfloat)point.y());
-        glm::vec3 wavePoint((GLfloat)point.x(), (GLfloat)point.y(), waveHeight);
-        wavesDebug.points.push_back(wavePoint);
-        return point.z() - Scalar(waveHeight);
+        for(size_t i=0; i<n; ++i)
+            d[i] = z[i];
+        return;
     }
-    else //Flat surface
+    
+    //Geometric waves
+    if(tile != NULL && tile->nx > 0)
     {
-        glm::vec3 wavePoint((GLfloat)point.x(), (GLfloat)point.y(), 0.f);
-        wavesDebug.points.push_back(wavePoint);
-        return point.z();
+        Scalar xLimit = Scalar(tile->nx - 1);
+        Scalar yLimit = Scalar(tile->ny - 1);
+        
+        for(size_t i=0; i<n; ++i)
+        {
+            Scalar fx = (x[i] - tile->x0) * tile->invSpacing;
+            Scalar fy = (y[i] - tile->y0) * tile->invSpacing;
+            
+            if(fx >= Scalar(0) && fy >= Scalar(0) && fx < xLimit && fy < yLimit) //Single bilinear fetch
+            {
+                unsigned int ix = (unsigned int)fx;
+                unsigned int iy = (unsigned int)fy;
+                Scalar a = fx - Scalar(ix);
+                Scalar b = fy - Scalar(iy);
+                const Scalar* h = &tile->height[iy * tile->nx + ix];
+                Scalar h0 = h[0] + a * (h[1] - h[0]);
+                Scalar h1 = h[tile->nx] + a * (h[tile->nx + 1] - h[tile->nx]);
+                d[i] = z[i] - (h0 + b * (h1 - h0));
+            }
+            else
+                d[i] = z[i] - ComputeWaveHeight(x[i], y[i]);
+        }
+    }
+    else
+    {
+        for(size_t i=0; i<n; ++i)
+            d[i] = z[i] - ComputeWaveHeight(x[i], y[i]);
+    }
+    
+    //Debug points are only rendered when graphics is available (called from multiple threads)
+    if(wavesDebugEnabled && glOcean != NULL)
+    {
+        SDL_LockMutex(wavesDebugMutex);
+        size_t nCapture = std::min(n, wavesDebugMaxPoints - std::min(wavesDebugMaxPoints, wavesDebug.points.size()));
+        for(size_t i=0; i<nCapture; ++i)
+            wavesDebug.points.push_back(glm::vec3((GLfloat)x[i], (GLfloat)y[i], (GLfloat)(z[i] - d[i])));
+        SDL_UnlockMutex(wavesDebugMutex);
+    }
+}
+
+Scalar Ocean::ComputeWaveHeight(Scalar x, Scalar y)
+{
+    if(waveSim != NULL)
+        return waveSim->ComputeWaveHeight(x, y);
+    else
+        return Scalar(glOcean->ComputeWaveHeight((GLfloat)x, (GLfloat)y));
+}
+
+void Ocean::UpdateWaveTile(WaveHeightTile& tile, Scalar xMin, Scalar yMin, Scalar xMax, Scalar yMax, size_t maxSamples)
+{
+    //Spacing between a quarter and one texel of the finer of the two wave grids used in the computation
+    Scalar minSpacing(0.1);
+    Scalar maxSpacing(0.4);
+    
+    tile.nx = 0;
+    tile.ny = 0;
+    if(!hasWaves() || (waveSim == NULL && glOcean == NULL) || maxSamples == 0)
+        return;
+    
+    Scalar spacing = btMax(minSpacing, btSqrt((xMax - xMin) * (yMax - yMin) / Scalar(maxSamples)));
+    if(spacing > maxSpacing)
+        return;
+    
+    //One extra sample in each direction, so that the whole region is strictly inside the tile
+    tile.x0 = xMin;
+    tile.y0 = yMin;
+    tile.invSpacing = Scalar(1) / spacing;
+    tile.nx = (unsigned int)ceil((xMax - xMin) * tile.invSpacing) + 2;
+    tile.ny = (unsigned int)ceil((yMax - yMin) * tile.invSpacing) + 2;
+    tile.height.resize(tile.nx * tile.ny);
+    
+    for(unsigned int j=0; j<tile.ny; ++j)
+    {
+        Scalar y = tile.y0 + Scalar(j) * spacing;
+        Scalar* h = &tile.height[j * tile.nx];
+        for(unsigned int i=0; i<tile.nx; ++i)
+            h[i] = ComputeWaveHeight(tile.x0 + Scalar(i) * spacing, y);
     }
 }
 
 Scalar Ocean::GetPressure(const Vector3& point)
+{
+    Scalar x = point.x(), y = point.y(), z = point.z();
+    Scalar p;
+    GetPressure(&x, &y, &z, 1, &p);
+    return p;
+}
+
+void Ocean::GetPressure(const Scalar* x, const Scalar* y, const Scalar* z, size_t n, Scalar* p, const WaveHeightTile* tile)
 {
     Scalar g = 9.81;
-    Scalar d = GetDepth(point);
-    Scalar pressure = d > Scalar(0) ? d*liquid.density*g : Scalar(0);
-    return pressure;
+    GetDepth(x, y, z, n, p, tile);
+    for(size_t i=0; i<n; ++i)
+        p[i] = p[i] > Scalar(0) ? p[i]*liquid.density*g : Scalar(0);
 }
 
 Vector3 Ocean::GetFluidVelocity(const Vector3& point) const
 {
+    Scalar x = point.x(), y = point.y(), z = point.z();
+    Scalar vx, vy, vz;
+    GetFluidVelocity(&x, &y, &z, 1, &vx, &vy, &vz);
+    return Vector3(vx, vy, vz);
+}
+
+void Ocean::GetFluidVelocity(const Scalar* x, const Scalar* y, const Scalar* z, size_t n, Scalar* vx, Scalar* vy, Scalar* vz) const
+{
+    std::fill(vx, vx + n, Scalar(0));
+    std::fill(vy, vy + n, Scalar(0));
+    std::fill(vz, vz + n, Scalar(0));
+    
     if(currentsEnabled)
-    {
-        Vector3 fv = V0();
         for(size_t i=0; i<currents.size(); ++i)
-            fv += currents[i]->GetVelocityAtPoint(point);
-        return fv;
-    }
-    else
-        return V0();
+            currents[i]->AddVelocityAtPoints(x, y, z, n, vx, vy, vz);
+}
+
+void Ocean::setWavesDebug(bool enabled, size_t maxPoints)
+{
+    SDL_LockMutex(wavesDebugMutex);
+    wavesDebugEnabled = enabled;
+    wavesDebugMaxPoints = maxPoints;
+    if(!enabled)
+        wavesDebug.points.clear();
+    SDL_UnlockMutex(wavesDebugMutex);
+}
+
+bool Ocean::isWavesDebugEnabled() const
+{
+    return wavesDebugEnabled;
 }
 
 void Ocean::EnableCurrents()
@@ -162,6 +303,13 @@ void Ocean::DisableCurrents()
     currentsEnabled = false;
 }
 
+void Ocean::UpdateCurrents(Scalar t)
+{
+    if(currentsEnabled)
+        for(size_t i=0; i<currents.size(); ++i)
+            currents[i]->Update(t);
+}
+
 void Ocean::UpdateCurrentsData()
 {
     if(glOcean != NULL)
@@ -191,30 +339,54 @@ void Ocean::ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool
     else
         return;
     
-    HydrodynamicsSettings settings;
-    
     if(ent->getType() == EntityType::SOLID)
     {
         if(recompute)
-        {
-            settings.dampingForces = true;
-            settings.reallisticBuoyancy = true;
-            ((SolidEntity*)ent)->ComputeHydrodynamicForces(settings, this);
-        }
+            ComputeFluidForces((SolidEntity*)ent);
         
         ((SolidEntity*)ent)->ApplyHydrodynamicForces();
     }
 }
 
-void Ocean::InitGraphics(SDL_mutex* hydrodynamics)
+void Ocean::ComputeFluidForces(SolidEntity* solid)
+{
+    HydrodynamicsSettings settings;
+    settings.dampingForces = true;
+    settings.reallisticBuoyancy = true;
+    solid->ComputeHydrodynamicForces(settings, this);
+}
+
+void Ocean::InitGraphics()
 {
     if(oceanState > 0.0)
-        glOcean = new OpenGLRealOcean(depth, oceanState, hydrodynamics);
+        glOcean = new OpenGLRealOcean(depth, oceanState);
     else
         glOcean = new OpenGLFlatOcean(depth);
     SetupWaterProperties(0.2);
 }
 
+void Ocean::InitWaveSimulation()
+{
+    if(oceanState > 0.0 && waveSim == NULL)
+        waveSim = new WaveSimulator(oceanState);
+}
+
+void Ocean::SimulateWaves(Scalar t, ThreadPool* pool)
+{
+    if(waveSim != NULL)
+        waveSim->Update(t, pool);
+    else if(glOcean != NULL)
+        glOcean->AcquireWaveData();
+}
+
+Scalar Ocean::getWaveDataAge()
+{
+    if(waveSim == NULL && glOcean != NULL)
+        return Scalar(glOcean->getWaveDataAge());
+    else
+        return Scalar(0); //Computed for the current step
+}
+
 std::vector<Renderable> Ocean::Render()
 {
     std::vector<Actuator*> act;
@@ -262,13 +434,44 @@ std::vector<Renderable> Ocean::Render(const std::vector<Actuator*>& act)
         }
     }
 
+    SDL_LockMutex(wavesDebugMutex);
     if(wavesDebug.points.size() > 0)
     {
         items.push_back(wavesDebug);
         wavesDebug.points.clear();
     }
+    SDL_UnlockMutex(wavesDebugMutex);
 
     return items;
 }
 
+Entity* Ocean::Clone(CloneContext& ctx)
+{
+    std::vector<VelocityField*> fields;
+    for(size_t i=0; i<currents.size(); ++i)
+    {
+        VelocityField* field = currents[i]->Copy();
+        if(field == NULL)
+        {
+            cError("Ocean: Velocity field %lu cannot be cloned!", (unsigned long)i);
+            for(size_t h=0; h<fields.size(); ++h)
+                delete fields[h];
+            return NULL;
+        }
+        fields.push_back(field);
+    }
+    
+    Ocean* copy = new Ocean(*this);
+    copy->InitCopy(ctx);
+    copy->currents = fields;
+    copy->glOcean = NULL;
+    copy->waveSim = waveSim != NULL ? new WaveSimulator(*waveSim) : NULL;
+    copy->InitWaveSimulation();
+    copy->wavesDebugMutex = SDL_CreateMutex();
+    copy->wavesDebugEnabled = false;
+    copy->wavesDebug.points.clear();
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
@@ -62,6 +62,38 @@ Vector3 Pipe::GetVelocityAtPoint(const Vector3& p)
     return f*v;
 }
 
+void Pipe::AddVelocityAtPoints(const Scalar* x, const Scalar* y, const Scalar* z, size_t count, Scalar* vx, Scalar* vy, Scalar* vz)
+{
+    //Same operations as in GetVelocityAtPoint, on separate components
+    const Scalar px = p1.x(), py = p1.y(), pz = p1.z();
+    const Scalar nx = n.x(), ny = n.y(), nz = n.z();
+    
+    for(size_t i=0; i<count; ++i)
+    {
+        //Calculate distance to line
+        Scalar ppx = x[i] - px, ppy = y[i] - py, ppz = z[i] - pz;
+        Scalar ax = ppy * nz - ppz * ny;
+        Scalar ay = ppz * nx - ppx * nz;
+        Scalar az = ppx * ny - ppy * nx;
+        Scalar d = btSqrt(ax * ax + ay * ay + az * az);
+        
+        //Calculate closest point on line section between P1 and P2
+        Scalar t = ppx * nx + ppy * ny + ppz * nz;
+        if(t < 0.0 || t > l) continue;
+        
+        //Calculate radius at point
+        Scalar r = r1 + (r2-r1) * t/l;
+        if(d >= r) continue;
+        
+        //Central velocity and its fraction
+        Scalar vc = r1/r * vin;
+        Scalar f = btPow(Scalar(1)-d/r, gamma);
+        vx[i] += nx * vc * f;
+        vy[i] += ny * vc * f;
+        vz[i] += nz * vc * f;
+    }
+}
+
 std::vector<Renderable> Pipe::Render(VelocityFieldUBO& ubo)
 {
     std::vector<Renderable> items(0);
@@ -112,4 +144,9 @@ std::vector<Renderable> Pipe::Render(VelocityFieldUBO& ubo)
     return items;
 }
 
+VelocityField* Pipe::Copy() const
+{
+    return new Pipe(*this);
+}
+
 }
@@ -25,29 +25,247 @@
 
 #include "entities/forcefields/Stream.h"
 
+#include "core/Console.h"
+
+#define STREAM_LEAF_SIZE 4
+#define STREAM_MAX_DEPTH 64
+
 namespace sf
 {
 
 Stream::Stream(const std::vector<Vector3>& streamline, const std::vector<Scalar>& radius, Scalar inputVelocity, Scalar exponent)
 {
-    c = streamline;
-    r = radius;
     vin = inputVelocity;
     gamma = exponent;
+    
+    if(streamline.size() < 2 || radius.size() != streamline.size())
+    {
+        cError("Stream has to be defined with at least two points, each with a radius!");
+        return;
+    }
+    
+    //Build segments (skipping repeated points)
+    for(size_t i=0; i<streamline.size()-1; ++i)
+    {
+        Segment s;
+        s.a = streamline[i];
+        s.n = streamline[i+1] - streamline[i];
+        s.l = s.n.length();
+        if(s.l < SIMD_EPSILON)
+            continue;
+        s.n /= s.l;
+        s.ra = radius[i];
+        s.rb = radius[i+1];
+        segments.push_back(s);
+    }
+    
+    if(segments.size() == 0)
+    {
+        cError("Stream has zero length!");
+        return;
+    }
+    
+    //Consecutive segments are close to each other, so splitting the polyline in halves gives a good hierarchy
+    nodes.reserve(2 * segments.size() / STREAM_LEAF_SIZE + 1);
+    BuildHierarchy(0, (unsigned int)segments.size());
+}
+
+void Stream::BuildHierarchy(unsigned int first, unsigned int count)
+{
+    unsigned int id = (unsigned int)nodes.size();
+    nodes.push_back(Node());
+    
+    //Bounding box of the segments inflated with their radii
+    Vector3 aabbMin(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+    Vector3 aabbMax(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+    for(unsigned int i=first; i<first+count; ++i)
+    {
+        const Segment& s = segments[i];
+        Vector3 b = s.a + s.n * s.l;
+        Vector3 ra(s.ra, s.ra, s.ra);
+        Vector3 rb(s.rb, s.rb, s.rb);
+        aabbMin.setMin(s.a - ra);
+        aabbMin.setMin(b - rb);
+        aabbMax.setMax(s.a + ra);
+        aabbMax.setMax(b + rb);
+    }
+    nodes[id].aabbMin = aabbMin;
+    nodes[id].aabbMax = aabbMax;
+    
+    if(count <= STREAM_LEAF_SIZE)
+    {
+        nodes[id].first = first;
+        nodes[id].count = count;
+        return;
+    }
+    
+    //First child follows its parent, the index of the second one is stored in the parent
+    unsigned int half = count/2;
+    BuildHierarchy(first, half);
+    nodes[id].first = (unsigned int)nodes.size();
+    nodes[id].count = 0;
+    BuildHierarchy(first + half, count - half);
+}
+
+bool Stream::ComputeVelocity(const Vector3& p, Vector3& v) const
+{
+    if(nodes.size() == 0)
+        return false;
+    
+    //Find the segment with the point closest to its axis, relative to the local radius
+    const Segment* best = NULL;
+    Scalar bestRatio(1);
+    Scalar bestR(0);
+    unsigned int last = (unsigned int)segments.size() - 1;
+    
+    unsigned int stack[STREAM_MAX_DEPTH];
+    unsigned int top = 0;
+    stack[top++] = 0;
+    
+    while(top > 0)
+    {
+        unsigned int id = stack[--top];
+        const Node& node = nodes[id];
+        if(p.x() < node.aabbMin.x() || p.x() > node.aabbMax.x()
+           || p.y() < node.aabbMin.y() || p.y() > node.aabbMax.y()
+           || p.z() < node.aabbMin.z() || p.z() > node.aabbMax.z())
+            continue;
+        
+        if(node.count == 0)
+        {
+            stack[top++] = node.first;
+            stack[top++] = id + 1;
+            continue;
+        }
+        
+        for(unsigned int i=node.first; i<node.first+node.count; ++i)
+        {
+            const Segment& s = segments[i];
+            Vector3 ap = p - s.a;
+            Scalar t = ap.dot(s.n);
+            
+            //The stream is open at both ends, inner joints are rounded
+            if(t < Scalar(0))
+            {
+                if(i == 0) continue;
+                t = Scalar(0);
+            }
+            else if(t > s.l)
+            {
+                if(i == last) continue;
+                t = s.l;
+            }
+            
+            Scalar d = (ap - s.n * t).length();
+            Scalar r = s.ra + (s.rb - s.ra) * t/s.l;
+            if(d >= r) continue;
+            
+            Scalar ratio = d/r;
+            if(ratio < bestRatio)
+            {
+                best = &s;
+                bestRatio = ratio;
+                bestR = r;
+            }
+        }
+    }
+    
+    if(best == NULL)
+        return false;
+    
+    //Same profile as in the pipe
+    Scalar vc = segments[0].ra/bestR * vin;
+    Scalar f = btPow(Scalar(1) - bestRatio, gamma);
+    v = best->n * (vc * f);
+    return true;
 }
     
 Vector3 Stream::GetVelocityAtPoint(const Vector3& p)
 {
-    return Vector3(0,0,0);
+    Vector3 v(0,0,0);
+    ComputeVelocity(p, v);
+    return v;
+}
+
+void Stream::AddVelocityAtPoints(const Scalar* x, const Scalar* y, const Scalar* z, size_t n, Scalar* vx, Scalar* vy, Scalar* vz)
+{
+    Vector3 v;
+    for(size_t i=0; i<n; ++i)
+    {
+        if(!ComputeVelocity(Vector3(x[i], y[i], z[i]), v))
+            continue;
+        vx[i] += v.x();
+        vy[i] += v.y();
+        vz[i] += v.z();
+    }
 }
 
 std::vector<Renderable> Stream::Render(VelocityFieldUBO& ubo)
 {
+    std::vector<Renderable> items(0);
+    
+    //Particles are not supported along a polyline
     ubo.posR = glm::vec4(0.f);
     ubo.dirV = glm::vec4(0.f);
     ubo.params = glm::vec3(0.f);
     ubo.type = 0;
-    return std::vector<Renderable>(0);
+    
+    if(segments.size() == 0)
+        return items;
+    
+    //Stream line
+    Renderable line;
+    line.type = RenderableType::HYDRO_LINE_STRIP;
+    line.model = glm::mat4(1.f);
+    
+    //Cross-sections at the points of the stream line
+    Renderable rings;
+    rings.type = RenderableType::HYDRO_LINES;
+    rings.model = glm::mat4(1.f);
+    
+    for(size_t i=0; i<=segments.size(); ++i)
+    {
+        Vector3 pt;
+        Vector3 dir;
+        Scalar r;
+        if(i < segments.size())
+        {
+            pt = segments[i].a;
+            r = segments[i].ra;
+            dir = i > 0 ? (segments[i-1].n + segments[i].n) : segments[i].n;
+            if(dir.length2() < SIMD_EPSILON) //Stream turning back
+                dir = segments[i].n;
+            dir.normalize();
+        }
+        else
+        {
+            pt = segments[i-1].a + segments[i-1].n * segments[i-1].l;
+            r = segments[i-1].rb;
+            dir = segments[i-1].n;
+        }
+        line.points.push_back(glm::vec3(pt.x(), pt.y(), pt.z()));
+        
+        Vector3 u, w;
+        btPlaneSpace1(dir, u, w);
+        for(unsigned int h=0; h<12; ++h)
+        {
+            Scalar alpha1 = Scalar(h)/Scalar(12) * M_PI * Scalar(2);
+            Scalar alpha2 = Scalar(h+1)/Scalar(12) * M_PI * Scalar(2);
+            Vector3 v1 = pt + (u * btCos(alpha1) + w * btSin(alpha1)) * r;
+            Vector3 v2 = pt + (u * btCos(alpha2) + w * btSin(alpha2)) * r;
+            rings.points.push_back(glm::vec3(v1.x(), v1.y(), v1.z()));
+            rings.points.push_back(glm::vec3(v2.x(), v2.y(), v2.z()));
+        }
+    }
+    
+    items.push_back(line);
+    items.push_back(rings);
+    return items;
 }
     
+VelocityField* Stream::Copy() const
+{
+    return new Stream(*this);
+}
+
 }
@@ -26,6 +26,7 @@
 #include "entities/forcefields/Trigger.h"
 
 #include "core/GraphicalSimulationApp.h"
+#include "core/CloneContext.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 
@@ -96,6 +97,18 @@ Trigger::Trigger(std::string uniqueName, const Vector3& dimensions, const Transf
     }
 }
 
+Entity* Trigger::Clone(CloneContext& ctx)
+{
+    Trigger* copy = new Trigger(*this);
+    copy->InitCopy(ctx);
+    copy->objectId = 0;
+    copy->lookId = -1;
+    for(size_t i=0; i<copy->solids.size(); ++i)
+        ctx.Remap(copy->solids[i]); //Solids may be copied after the trigger
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 ForcefieldType Trigger::getForcefieldType()
 {
     return ForcefieldType::TRIGGER;
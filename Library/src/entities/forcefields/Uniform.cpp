@@ -38,6 +38,17 @@ Vector3 Uniform::GetVelocityAtPoint(const Vector3& p)
     return v;
 }
 
+void Uniform::AddVelocityAtPoints(const Scalar* x, const Scalar* y, const Scalar* z, size_t n, Scalar* vx, Scalar* vy, Scalar* vz)
+{
+    const Scalar ux = v.x(), uy = v.y(), uz = v.z();
+    for(size_t i=0; i<n; ++i)
+    {
+        vx[i] += ux;
+        vy[i] += uy;
+        vz[i] += uz;
+    }
+}
+
 std::vector<Renderable> Uniform::Render(VelocityFieldUBO& ubo)
 {
     std::vector<Renderable> items(0);
@@ -50,5 +61,10 @@ std::vector<Renderable> Uniform::Render(VelocityFieldUBO& ubo)
     return items;
 }
 
+VelocityField* Uniform::Copy() const
+{
+    return new Uniform(*this);
+}
+
 }
 
@@ -36,4 +36,24 @@ VelocityField::~VelocityField()
 {
 }
 
+void VelocityField::AddVelocityAtPoints(const Scalar* x, const Scalar* y, const Scalar* z, size_t n, Scalar* vx, Scalar* vy, Scalar* vz)
+{
+    for(size_t i=0; i<n; ++i)
+    {
+        Vector3 v = GetVelocityAtPoint(Vector3(x[i], y[i], z[i]));
+        vx[i] += v.x();
+        vy[i] += v.y();
+        vz[i] += v.z();
+    }
+}
+
+void VelocityField::Update(Scalar t)
+{
+}
+
+VelocityField* VelocityField::Copy() const
+{
+    return NULL;
+}
+
 }
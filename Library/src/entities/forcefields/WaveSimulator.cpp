@@ -0,0 +1,456 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  WaveSimulator.cpp
+//  Stonefish
+//
+//  Created by agent on 17/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+
+#include "entities/forcefields/WaveSimulator.h"
+
+#include "core/ThreadPool.h"
+#include "utils/SystemUtil.hpp"
+
+namespace sf
+{
+
+WaveSimulator::WaveSimulator(Scalar state, long seed)
+{
+    //Same parameters as in the OpenGL ocean
+    params.passes = 8;
+    params.slopeVarianceSize = 4;
+    params.fftSize = 1 << params.passes;
+    params.propagate = true;
+    params.km = 370.f;
+    params.cm = 0.23f;
+    params.t = 0.f;
+    params.gridSizes = glm::vec4(893.f, 101.f, 21.f, 11.f);
+    params.spectrum12 = NULL;
+    params.spectrum34 = NULL;
+    params.wind = (float)state*5.f + 2.f;
+    params.A = 1.f;
+    params.omega = 5.f*expf(-(float)state) + 0.2f;
+    phaseTime = Scalar(0);
+    phaseDt = Scalar(0);
+    phaseSteps = 0;
+    
+    InitializeSpectrum(seed);
+    Update(Scalar(0));
+}
+
+WaveSimulator::~WaveSimulator()
+{
+    if(params.spectrum12 != NULL)
+    {
+        delete[] params.spectrum12;
+        delete[] params.spectrum34;
+    }
+}
+
+const OceanParams& WaveSimulator::getParams() const
+{
+    return params;
+}
+
+void WaveSimulator::InitializeSpectrum(long seed)
+{
+    GenerateSpectrum(params, seed);
+    
+    unsigned int N = (unsigned int)params.fftSize;
+    
+    //Bit reversal used to reorder the input of the FFT
+    bitReversed.resize(N);
+    for(unsigned int i=0; i<N; ++i)
+    {
+        unsigned int r = 0;
+        for(unsigned int p=0; p<params.passes; ++p)
+            r |= ((i >> p) & 1) << (params.passes - 1 - p);
+        bitReversed[i] = r;
+    }
+    
+    //Twiddle factors of the inverse FFT, for the pass combining blocks of size h stored at [h, 2h)
+    twiddleRe.resize(N);
+    twiddleIm.resize(N);
+    for(unsigned int h=1; h<N; h *= 2)
+        for(unsigned int k=0; k<h; ++k)
+        {
+            twiddleRe[h + k] = (float)cos(M_PI * k / (double)h);
+            twiddleIm[h + k] = (float)sin(M_PI * k / (double)h);
+        }
+    
+    //Time independent part of h(k,t), stored in the input order of the FFT
+    for(unsigned int g=0; g<2; ++g)
+    {
+        frequency[g].resize(N*N);
+        ampP[g].resize(N*N);
+        ampQ[g].resize(N*N);
+        ampR[g].resize(N*N);
+        ampS[g].resize(N*N);
+        phaseRe[g].resize(N*N);
+        phaseIm[g].resize(N*N);
+        stepRe[g].resize(N*N);
+        stepIm[g].resize(N*N);
+        float invGridSize = (float)(2.f*M_PI*(float)N/params.gridSizes[g]);
+        
+        for(unsigned int y=0; y<N; ++y)
+            for(unsigned int x=0; x<N; ++x)
+            {
+                float sx = (float)x/(float)N;
+                float sy = (float)y/(float)N;
+                float kx = (x >= N/2 ? sx - 1.f : sx) * invGridSize;
+                float ky = (y >= N/2 ? sy - 1.f : sy) * invGridSize;
+                float k = sqrtf(kx*kx + ky*ky);
+                
+                const float* s0 = params.spectrum12 + 4*(y*N + x) + 2*g; //h0(k)
+                const float* s0c = params.spectrum12 + 4*(((N-y)%N)*N + (N-x)%N) + 2*g; //h0(-k)
+                
+                size_t id = bitReversed[y]*N + bitReversed[x];
+                frequency[g][id] = sqrtf(9.81f * k * (1.f + k * k / (370.f * 370.f)));
+                ampP[g][id] = (s0[0] + s0c[0]) * 1.414213562f;
+                ampQ[g][id] = (s0[1] + s0c[1]) * 1.414213562f;
+                ampR[g][id] = (s0[0] - s0c[0]) * 1.414213562f;
+                ampS[g][id] = (s0[1] - s0c[1]) * 1.414213562f;
+            }
+    }
+    
+    heightRe.resize(N*N);
+    heightIm.resize(N*N);
+    
+    //The spectrum is not needed anymore (also makes the simulator safe to copy)
+    delete[] params.spectrum12;
+    delete[] params.spectrum34;
+    params.spectrum12 = NULL;
+    params.spectrum34 = NULL;
+}
+
+void WaveSimulator::Update(Scalar t, ThreadPool* pool)
+{
+    //Phases are rotated when the time step is repeated and evaluated directly otherwise,
+    //as well as periodically, to bound the rounding error accumulated by the rotations
+    Scalar dt = t - phaseTime;
+    bool advance = phaseSteps > 0 && phaseSteps < 256 && dt > Scalar(0) && btFabs(dt - phaseDt) <= Scalar(1e-6) * phaseDt;
+    bool newStep = !advance && dt != phaseDt;
+    if(advance)
+        ++phaseSteps;
+    else
+    {
+        phaseSteps = 1;
+        phaseDt = dt;
+    }
+    phaseTime = t;
+    params.t = (float)t;
+    
+    unsigned int N = (unsigned int)params.fftSize;
+    unsigned int chunk = 16;
+    
+    if(pool != NULL)
+    {
+        //Rows are independent in the first pass, columns in the second one
+        pool->ParallelFor(N/chunk, [&](unsigned int i){ ComputeRows(i*chunk, (i+1)*chunk, advance, newStep); });
+        pool->ParallelFor(N/chunk, [&](unsigned int i){ ComputeColumns(i*chunk, (i+1)*chunk); });
+    }
+    else
+    {
+        ComputeRows(0, N, advance, newStep);
+        ComputeColumns(0, N);
+    }
+}
+
+void WaveSimulator::ComputeRows(unsigned int r0, unsigned int r1, bool advance, bool newStep)
+{
+    unsigned int N = (unsigned int)params.fftSize;
+    float t = params.t;
+    float dt = (float)phaseDt;
+    
+    for(unsigned int r=r0; r<r1; ++r)
+    {
+        float* re = &heightRe[r*N];
+        float* im = &heightIm[r*N];
+        
+        //Phases of the two grids: exp(i*w*t)
+        for(unsigned int g=0; g<2; ++g)
+        {
+            const float* w = &frequency[g][r*N];
+            float* cr = &phaseRe[g][r*N];
+            float* ci = &phaseIm[g][r*N];
+            float* sr = &stepRe[g][r*N];
+            float* si = &stepIm[g][r*N];
+            
+            if(advance)
+            {
+                for(unsigned int i=0; i<N; ++i)
+                {
+                    float c = cr[i] * sr[i] - ci[i] * si[i];
+                    float s = cr[i] * si[i] + ci[i] * sr[i];
+                    cr[i] = c;
+                    ci[i] = s;
+                }
+            }
+            else
+            {
+                for(unsigned int i=0; i<N; ++i)
+                {
+                    cr[i] = cosf(w[i] * t);
+                    ci[i] = sinf(w[i] * t);
+                }
+                
+                if(newStep)
+                    for(unsigned int i=0; i<N; ++i)
+                    {
+                        sr[i] = cosf(w[i] * dt);
+                        si[i] = sinf(w[i] * dt);
+                    }
+            }
+        }
+        
+        const float* c1 = &phaseRe[0][r*N];
+        const float* s1 = &phaseIm[0][r*N];
+        const float* c2 = &phaseRe[1][r*N];
+        const float* s2 = &phaseIm[1][r*N];
+        const float* pa = &ampP[0][r*N];
+        const float* qa = &ampQ[0][r*N];
+        const float* ra = &ampR[0][r*N];
+        const float* sa = &ampS[0][r*N];
+        const float* pb = &ampP[1][r*N];
+        const float* qb = &ampQ[1][r*N];
+        const float* rb = &ampR[1][r*N];
+        const float* sb = &ampS[1][r*N];
+        
+        //h(k,t) of the two grids packed in one complex number: h1 + i*h2
+        for(unsigned int i=0; i<N; ++i)
+        {
+            float h1x = pa[i] * c1[i] - qa[i] * s1[i];
+            float h1y = ra[i] * s1[i] + sa[i] * c1[i];
+            float h2x = pb[i] * c2[i] - qb[i] * s2[i];
+            float h2y = rb[i] * s2[i] + sb[i] * c2[i];
+            re[i] = h1x - h2y;
+            im[i] = h1y + h2x;
+        }
+        
+        //Inverse FFT along the row
+        for(unsigned int h=1; h<N; h *= 2)
+            for(unsigned int j=0; j<N; j += 2*h)
+                for(unsigned int k=0; k<h; ++k)
+                {
+                    unsigned int a = j + k;
+                    unsigned int b = j + h + k;
+                    float tr = twiddleRe[h + k] * re[b] - twiddleIm[h + k] * im[b];
+                    float ti = twiddleIm[h + k] * re[b] + twiddleRe[h + k] * im[b];
+                    re[b] = re[a] - tr;
+                    im[b] = im[a] - ti;
+                    re[a] += tr;
+                    im[a] += ti;
+                }
+    }
+}
+
+void WaveSimulator::ComputeColumns(unsigned int c0, unsigned int c1)
+{
+    unsigned int N = (unsigned int)params.fftSize;
+    
+    //Inverse FFT along the columns, processing whole rows of the range at once
+    for(unsigned int h=1; h<N; h *= 2)
+        for(unsigned int j=0; j<N; j += 2*h)
+            for(unsigned int k=0; k<h; ++k)
+            {
+                float wr = twiddleRe[h + k];
+                float wi = twiddleIm[h + k];
+                float* reA = &heightRe[(j + k)*N];
+                float* imA = &heightIm[(j + k)*N];
+                float* reB = &heightRe[(j + h + k)*N];
+                float* imB = &heightIm[(j + h + k)*N];
+                
+                for(unsigned int i=c0; i<c1; ++i)
+                {
+                    float tr = wr * reB[i] - wi * imB[i];
+                    float ti = wi * reB[i] + wr * imB[i];
+                    reB[i] = reA[i] - tr;
+                    imB[i] = imA[i] - ti;
+                    reA[i] += tr;
+                    imA[i] += ti;
+                }
+            }
+}
+
+float WaveSimulator::ComputeInterpolatedWaveData(float x, float y, const std::vector<float>& data) const
+{
+    //Bilinear interpolation with wrapping, the same as in the OpenGL ocean
+    float tmp;
+    
+    //First coordinate pair
+    float i0f = modff(x - 0.5f/(float)params.fftSize, &tmp);
+    float j0f = modff(y - 0.5f/(float)params.fftSize, &tmp);
+    if(i0f < 0.f) i0f = 1.f - fabsf(i0f);
+    if(j0f < 0.f) j0f = 1.f - fabsf(j0f);
+    int i0 = (int)truncf(i0f * (float)params.fftSize);
+    int j0 = (int)truncf(j0f * (float)params.fftSize);
+    
+    //Second coordinate pair
+    float i1f = modff(x + 0.5f/(float)params.fftSize, &tmp);
+    float j1f = modff(y + 0.5f/(float)params.fftSize, &tmp);
+    if(i1f < 0.f) i1f = 1.f - fabsf(i1f);
+    if(j1f < 0.f) j1f = 1.f - fabsf(j1f);
+    int i1 = (int)truncf(i1f * (float)params.fftSize);
+    int j1 = (int)truncf(j1f * (float)params.fftSize);
+    
+    //Calculate weigths
+    float alpha = modff(i0f * (float)params.fftSize, &tmp);
+    float beta = modff(j0f * (float)params.fftSize, &tmp);
+    
+    //Get texel values
+    float t[4];
+    t[0] = data[j0 * params.fftSize + i0];
+    t[1] = data[j0 * params.fftSize + i1];
+    t[2] = data[j1 * params.fftSize + i0];
+    t[3] = data[j1 * params.fftSize + i1];
+    
+    //Interpolate
+    return (1.f - alpha)*(1.f - beta)*t[0] + alpha*(1.f - beta)*t[1] + (1.f - alpha)*beta*t[2] + alpha*beta*t[3];
+}
+
+Scalar WaveSimulator::ComputeWaveHeight(Scalar x, Scalar y) const
+{
+    float xf = (float)x;
+    float yf = (float)y;
+    float z = 0.f;
+    z -= ComputeInterpolatedWaveData(xf/params.gridSizes.x, yf/params.gridSizes.x, heightRe);
+    z -= ComputeInterpolatedWaveData(xf/params.gridSizes.y, yf/params.gridSizes.y, heightIm);
+    return Scalar(z);
+}
+
+//Wave generation
+static float sqr(float x)
+{
+    return x * x;
+}
+
+float WaveSimulator::omega(const OceanParams& params, float k)
+{
+    return sqrt(9.81 * k * (1.0 + sqr(k / params.km))); // Eq 24
+}
+
+// 1/kx and 1/ky in meters
+float WaveSimulator::Spectrum(const OceanParams& params, float kx, float ky, bool omnispectrum)
+{
+    float U10 = params.wind;
+    float Omega = params.omega;
+
+    // phase speed
+    float k = sqrt(kx * kx + ky * ky);
+    float c = omega(params, k) / k;
+
+    // spectral peak
+    float kp = 9.81 * sqr(Omega / U10); // after Eq 3
+    float cp = omega(params, kp) / kp;
+
+    // friction velocity
+    float z0 = 3.7e-5 * sqr(U10) / 9.81 * pow(U10 / cp, 0.9f); // Eq 66
+    float u_star = 0.41 * U10 / log(10.0 / z0); // Eq 60
+
+    float Lpm = exp(- 5.0 / 4.0 * sqr(kp / k)); // after Eq 3
+    float gamma = Omega < 1.0 ? 1.7 : 1.7 + 6.0 * log(Omega); // after Eq 3 // log10 or log??
+    float sigma = 0.08 * (1.0 + 4.0 / pow(Omega, 3.0f)); // after Eq 3
+    float Gamma = exp(-1.0 / (2.0 * sqr(sigma)) * sqr(sqrt(k / kp) - 1.0));
+    float Jp = pow(gamma, Gamma); // Eq 3
+    float Fp = Lpm * Jp * exp(- Omega / sqrt(10.0) * (sqrt(k / kp) - 1.0)); // Eq 32
+    float alphap = 0.006 * sqrt(Omega); // Eq 34
+    float Bl = 0.5 * alphap * cp / c * Fp; // Eq 31
+
+    float alpham = 0.01 * (u_star < params.cm ? 1.0 + log(u_star / params.cm) : 1.0 + 3.0 * log(u_star / params.cm)); // Eq 44
+    float Fm = exp(-0.25 * sqr(k / params.km - 1.0)); // Eq 41
+    float Bh = 0.5 * alpham * params.cm / c * Fm; // Eq 40
+
+    Bh *= Lpm; 
+
+    if (omnispectrum)
+    {
+        return params.A * (Bl + Bh) / (k * sqr(k)); // Eq 30
+    }
+
+    float a0 = log(2.0) / 4.0;
+    float ap = 4.0;
+    float am = 0.13 * u_star / params.cm; // Eq 59
+    float Delta = tanh(a0 + ap * pow(c / cp, 2.5f) + am * pow(params.cm / c, 2.5f)); // Eq 57
+
+    float phi = atan2(ky, kx);
+
+    if(params.propagate)
+    {
+        if (kx < 0.0)
+        {
+            return 0.0;
+        }
+        else
+        {
+            Bl *= 2.0;
+            Bh *= 2.0;
+        }
+    }
+
+    return params.A * (Bl + Bh) * (1.0 + Delta * cos(2.0 * phi)) / (2.0 * M_PI * sqr(sqr(k))); // Eq 67
+}
+
+void WaveSimulator::GetSpectrumSample(const OceanParams& params, int i, int j, float lengthScale, float kMin, long* seed, float* result)
+{
+    float dk = 2.0 * M_PI / lengthScale;
+    float kx = i * dk;
+    float ky = j * dk;
+    if(fabsf(kx) < kMin && fabsf(ky) < kMin)
+    {
+        result[0] = 0.0;
+        result[1] = 0.0;
+    }
+    else
+    {
+        float S = Spectrum(params, kx, ky);
+        float h = sqrtf(S / 2.0) * dk;
+        float phi = frandom(seed) * 2.0 * M_PI;
+        result[0] = h * cos(phi);
+        result[1] = h * sin(phi);
+    }
+}
+
+void WaveSimulator::GenerateSpectrum(OceanParams& params, long seed)
+{
+    if(params.spectrum12 != NULL)
+    {
+        delete[] params.spectrum12;
+        delete[] params.spectrum34;
+    }
+    params.spectrum12 = new float[params.fftSize * params.fftSize * 4];
+    params.spectrum34 = new float[params.fftSize * params.fftSize * 4];
+
+    for (int y = 0; y < params.fftSize; ++y)
+    {
+        for (int x = 0; x < params.fftSize; ++x)
+        {
+            int offset = 4 * (x + y * params.fftSize);
+            int i = x >= params.fftSize / 2 ? x - params.fftSize : x;
+            int j = y >= params.fftSize / 2 ? y - params.fftSize : y;
+            GetSpectrumSample(params, i, j, params.gridSizes[0], M_PI / params.gridSizes[0], &seed, params.spectrum12 + offset);
+            GetSpectrumSample(params, i, j, params.gridSizes[1], M_PI * params.fftSize / params.gridSizes[0], &seed, params.spectrum12 + offset + 2);
+            GetSpectrumSample(params, i, j, params.gridSizes[2], M_PI * params.fftSize / params.gridSizes[1], &seed, params.spectrum34 + offset);
+            GetSpectrumSample(params, i, j, params.gridSizes[3], M_PI * params.fftSize / params.gridSizes[2], &seed, params.spectrum34 + offset + 2);
+        }
+    }
+}
+
+}
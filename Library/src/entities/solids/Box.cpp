@@ -25,6 +25,7 @@
 
 #include "entities/solids/Box.h"
 
+#include "core/CloneContext.h"
 #include "graphics/OpenGLContent.h"
 
 namespace sf
@@ -84,4 +85,12 @@ btCollisionShape* Box::BuildCollisionShape()
     return new btBoxShape(halfExtents);
 }
 
+SolidEntity* Box::Copy(CloneContext& ctx)
+{
+    Box* copy = new Box(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
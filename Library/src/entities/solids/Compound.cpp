@@ -27,6 +27,7 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/CloneContext.h"
 #include "utils/GeometryFileUtil.h"
 
 namespace sf
@@ -72,12 +73,14 @@ Vector3 Compound::getAugmentedInertia() const
     return Ipri;
 }
     
-Material Compound::getMaterial(size_t partId) const
+const Material& Compound::getMaterial(size_t partId) const
 {
+    static const Material noMaterial;
+    
     if(partId < parts.size())
         return parts[partId].solid->getMaterial();
     else
-        return Material();
+        return noMaterial;
 }
 
 size_t Compound::getPartId(size_t collisionShapeId) const
@@ -324,7 +327,7 @@ void Compound::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean*
                 if(parts[i].isExternal) //Compute drag only for external parts
                 {
                     Transform T_C_part = getOTransform() * parts[i].origin * parts[i].solid->getO2CTransform();
-                    ComputeHydrodynamicForcesSubmerged(parts[i].solid->getPhysicsMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fdlp, Tdlp, Fdqp, Tdqp, Fdsp, Tdsp);
+                    ComputeHydrodynamicForcesSubmerged(parts[i].solid->getHydroMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fdlp, Tdlp, Fdqp, Tdqp, Fdsp, Tdsp);
                     parts[i].solid->CorrectHydrodynamicForces(ocn, Fdlp, Tdlp, Fdqp, Tdqp, Fdsp, Tdsp);
                     Fdl += Fdlp;
                     Tdl += Tdlp;
@@ -379,7 +382,7 @@ void Compound::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean*
                 
                 if(parts[i].isExternal) //Compute buoyancy and drag
                 {
-                    ComputeHydrodynamicForcesSurface(pSettings, parts[i].solid->getPhysicsMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fbp, Tbp, Fdlp, Tdlp, Fdqp, Tdqp, Fdsp, Tdsp, submerged);
+                    ComputeHydrodynamicForcesSurface(pSettings, parts[i].solid->getHydroMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fbp, Tbp, Fdlp, Tdlp, Fdqp, Tdqp, Fdsp, Tdsp, submerged);
                     parts[i].solid->CorrectHydrodynamicForces(ocn, Fdlp, Tdlp, Fdqp, Tdqp, Fdsp, Tdsp);
                     Fb += Fbp;
                     Tb += Tbp;
@@ -393,7 +396,7 @@ void Compound::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean*
                 else if(pSettings.reallisticBuoyancy) //Compute only buoyancy
                 {
                     pSettings.dampingForces = false;
-                    ComputeHydrodynamicForcesSurface(pSettings, parts[i].solid->getPhysicsMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fbp, Tbp, Fdlp, Tdlp, Fdqp, Tdqp, Fdsp, Tdsp, submerged);
+                    ComputeHydrodynamicForcesSurface(pSettings, parts[i].solid->getHydroMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fbp, Tbp, Fdlp, Tdlp, Fdqp, Tdqp, Fdsp, Tdsp, submerged);
                     Fb += Fbp;
                     Tb += Tbp;
                 }
@@ -537,4 +540,19 @@ std::vector<Renderable> Compound::Render()
     return items;
 }
 
+SolidEntity* Compound::Copy(CloneContext& ctx)
+{
+    Compound* copy = new Compound(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
+void Compound::InitCopy(CloneContext& ctx)
+{
+    SolidEntity::InitCopy(ctx);
+    for(size_t i=0; i<parts.size(); ++i)
+        parts[i].solid = parts[i].solid->Copy(ctx);
+}
+
 }
@@ -25,6 +25,7 @@
 
 #include "entities/solids/Cylinder.h"
 
+#include "core/CloneContext.h"
 #include "graphics/OpenGLContent.h"
 
 namespace sf
@@ -82,4 +83,12 @@ btCollisionShape* Cylinder::BuildCollisionShape()
     return new btCylinderShapeZ(Vector3(r, r, halfHeight));
 }
 
+SolidEntity* Cylinder::Copy(CloneContext& ctx)
+{
+    Cylinder* copy = new Cylinder(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
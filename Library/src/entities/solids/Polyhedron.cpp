@@ -25,6 +25,8 @@
 
 #include "entities/solids/Polyhedron.h"
 
+#include "core/AssetCache.h"
+#include "core/CloneContext.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 #include "utils/SystemUtil.hpp"
@@ -40,23 +42,32 @@ Polyhedron::Polyhedron(std::string uniqueName,
                        bool isBuoyant, GeometryApproxType approx)
                         : SolidEntity(uniqueName, material, bpt, look, thickness, isBuoyant)
 {
-    //1.Load geometry from file
-    graMesh = OpenGLContent::LoadMesh(graphicsFilename, graphicsScale, false);
-    T_O2G = graphicsOrigin;
+    //1.Load geometry from file (meshes are shared with other worlds when the asset cache is active)
+    auto loadRefined = [](const std::string& filename, Scalar scale)
+    {
+        return [filename, scale]()
+        {
+            Mesh* mesh = OpenGLContent::LoadMesh(filename, scale, false);
+            OpenGLContent::Refine(mesh, 3.f);
+            return mesh;
+        };
+    };
     
     if(physicsFilename != "")
     {
-        phyMesh = OpenGLContent::LoadMesh(physicsFilename, physicsScale, false);
+        graMesh = AssetCache::getMesh(AssetCache::MeshKey(graphicsFilename, graphicsScale, I4(), ""), 
+                                      [graphicsFilename, graphicsScale]() { return OpenGLContent::LoadMesh(graphicsFilename, graphicsScale, false); });
+        phyMesh = AssetCache::getMesh(AssetCache::MeshKey(physicsFilename, physicsScale, I4(), "refined"), loadRefined(physicsFilename, physicsScale));
+        T_O2G = graphicsOrigin;
         T_O2C = physicsOrigin;
     }
     else
     {
+        graMesh = AssetCache::getMesh(AssetCache::MeshKey(graphicsFilename, graphicsScale, I4(), "refined"), loadRefined(graphicsFilename, graphicsScale));
         phyMesh = graMesh;
-        T_O2C = T_O2G;
+        T_O2G = T_O2C = graphicsOrigin;
     }
     
-    OpenGLContent::Refine(phyMesh, 3.f);
-    
     //2. Compute physical properties
     Vector3 CG;
     Matrix3 Irot;
@@ -83,11 +94,8 @@ Polyhedron::Polyhedron(std::string uniqueName,
 
 Polyhedron::~Polyhedron()
 {
-    if(graMesh != NULL)
-    {
-        if(graMesh == phyMesh) phyMesh = NULL;
-        delete graMesh;
-    }
+    if(graMesh != phyMesh)
+        AssetCache::ReleaseMesh(graMesh);
 }
     
 SolidType Polyhedron::getSolidType()
@@ -117,4 +125,19 @@ void Polyhedron::BuildGraphicalObject()
     phyObjectId = ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->BuildObject(phyMesh);
 }
 
+SolidEntity* Polyhedron::Copy(CloneContext& ctx)
+{
+    Polyhedron* copy = new Polyhedron(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
+void Polyhedron::InitCopy(CloneContext& ctx)
+{
+    SolidEntity::InitCopy(ctx);
+    if(graMesh != phyMesh)
+        AssetCache::AddReference(graMesh);
+}
+
 }
@@ -25,6 +25,7 @@
 
 #include "entities/solids/Sphere.h"
 
+#include "core/CloneContext.h"
 #include "graphics/OpenGLContent.h"
 
 namespace sf
@@ -75,4 +76,12 @@ btCollisionShape* Sphere::BuildCollisionShape()
     return new btSphereShape(r);
 }
 
+SolidEntity* Sphere::Copy(CloneContext& ctx)
+{
+    Sphere* copy = new Sphere(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
@@ -26,6 +26,7 @@
 #include "entities/solids/Torus.h"
 
 #include "core/TorusShape.h"
+#include "core/CloneContext.h"
 #include "graphics/OpenGLContent.h"
 
 namespace sf
@@ -81,4 +82,12 @@ btCollisionShape* Torus::BuildCollisionShape()
     return new TorusShape(MR, mR);
 }
 
+SolidEntity* Torus::Copy(CloneContext& ctx)
+{
+    Torus* copy = new Torus(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
@@ -25,6 +25,7 @@
 
 #include "entities/solids/Wing.h"
 
+#include "core/CloneContext.h"
 #include "graphics/OpenGLContent.h"
 #include "utils/GeometryFileUtil.h"
 
@@ -139,4 +140,12 @@ btCollisionShape* Wing::BuildCollisionShape()
     return convex;
 }
 
+SolidEntity* Wing::Copy(CloneContext& ctx)
+{
+    Wing* copy = new Wing(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
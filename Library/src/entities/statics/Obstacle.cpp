@@ -26,6 +26,8 @@
 #include "entities/statics/Obstacle.h"
 
 #include "core/GraphicalSimulationApp.h"
+#include "core/AssetCache.h"
+#include "core/CloneContext.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 
@@ -37,14 +39,23 @@ Obstacle::Obstacle(std::string uniqueName,
          std::string physicsFilename, Scalar physicsScale, const Transform& physicsOrigin,
          std::string material, std::string look) : StaticEntity(uniqueName, material, look)
 {
-    graMesh = OpenGLContent::LoadMesh(graphicsFilename, graphicsScale, false);
-    OpenGLContent::TransformMesh(graMesh, graphicsOrigin);
+    //Meshes are shared with other worlds when the asset cache is active
+    auto loadTransformed = [](const std::string& filename, Scalar scale, const Transform& origin)
+    {
+        return [filename, scale, origin]()
+        {
+            Mesh* mesh = OpenGLContent::LoadMesh(filename, scale, false);
+            OpenGLContent::TransformMesh(mesh, origin);
+            return mesh;
+        };
+    };
+    
+    graMesh = AssetCache::getMesh(AssetCache::MeshKey(graphicsFilename, graphicsScale, graphicsOrigin, "transformed"),
+                                  loadTransformed(graphicsFilename, graphicsScale, graphicsOrigin));
     
     if(physicsFilename != "")
-    {
-        phyMesh = OpenGLContent::LoadMesh(physicsFilename, physicsScale, false);
-        OpenGLContent::TransformMesh(phyMesh, physicsOrigin);
-    }
+        phyMesh = AssetCache::getMesh(AssetCache::MeshKey(physicsFilename, physicsScale, physicsOrigin, "transformed"),
+                                      loadTransformed(physicsFilename, physicsScale, physicsOrigin));
     else
         phyMesh = graMesh;
         
@@ -118,11 +129,8 @@ Obstacle::Obstacle(std::string uniqueName, Scalar cylinderRadius, Scalar cylinde
     
 Obstacle::~Obstacle()
 {
-    if(graMesh != NULL)
-    {
-        if(graMesh == phyMesh) phyMesh = NULL;
-        delete graMesh;
-    }
+    if(graMesh != phyMesh)
+        AssetCache::ReleaseMesh(graMesh);
 }
 
 StaticEntityType Obstacle::getStaticType()
@@ -168,4 +176,20 @@ std::vector<Renderable> Obstacle::Render()
 	return items;
 }
 
+Entity* Obstacle::Clone(CloneContext& ctx)
+{
+    Obstacle* copy = new Obstacle(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
+void Obstacle::InitCopy(CloneContext& ctx)
+{
+    if(graMesh != phyMesh)
+        AssetCache::AddReference(graMesh);
+    graObjectId = -1;
+    StaticEntity::InitCopy(ctx);
+}
+
 }
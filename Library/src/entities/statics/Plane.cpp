@@ -26,6 +26,7 @@
 #include "entities/statics/Plane.h"
 
 #include "core/SimulationApp.h"
+#include "core/CloneContext.h"
 #include "graphics/OpenGLContent.h"
 
 namespace sf
@@ -50,4 +51,12 @@ StaticEntityType Plane::getStaticType()
     return StaticEntityType::PLANE;
 }
 
+Entity* Plane::Clone(CloneContext& ctx)
+{
+    Plane* copy = new Plane(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
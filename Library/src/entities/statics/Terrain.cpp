@@ -27,6 +27,8 @@
 
 #include "core/Console.h"
 #include "core/SimulationManager.h"
+#include "core/AssetCache.h"
+#include "core/CloneContext.h"
 #include "graphics/OpenGLContent.h"
 #include "utils/stb_image.h"
 
@@ -69,7 +71,8 @@ Terrain::Terrain(std::string uniqueName, std::string pathToHeightmap, Scalar sca
 
 Terrain::~Terrain()
 {
-    delete [] terrainHeight;
+    if(AssetCache::RemoveReference(terrainHeight))
+        delete [] terrainHeight;
 }
 
 StaticEntityType Terrain::getStaticType()
@@ -94,4 +97,18 @@ void Terrain::AddToSimulation(SimulationManager* sm, const Transform& origin)
     }
 }
 
+Entity* Terrain::Clone(CloneContext& ctx)
+{
+    Terrain* copy = new Terrain(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
+void Terrain::InitCopy(CloneContext& ctx)
+{
+    AssetCache::AddReference(terrainHeight);
+    StaticEntity::InitCopy(ctx);
+}
+
 }
@@ -1006,7 +1006,7 @@ void OpenGLContent::UseStandardLook(const glm::mat4& M)
     }
 }
 
-unsigned int OpenGLContent::BuildObject(Mesh* mesh)
+unsigned int OpenGLContent::BuildObject(const Mesh* mesh)
 {
     Object obj;
     
@@ -34,12 +34,14 @@
 #include "graphics/OpenGLConsole.h"
 #include "utils/SystemUtil.hpp"
 
+#define WAVE_SNAPSHOT_INDEX 3u
+#define WAVE_SNAPSHOT_NEW 4u
+
 namespace sf
 {
 
-OpenGLRealOcean::OpenGLRealOcean(GLfloat size, GLfloat state, SDL_mutex* hydrodynamics) : OpenGLOcean(size)
+OpenGLRealOcean::OpenGLRealOcean(GLfloat size, GLfloat state) : OpenGLOcean(size)
 {
-    hydroMutex = hydrodynamics;
     params.wind = state*5.f + 2.f;
     params.A = 1.f;
     params.omega = 5.f*expf(-state) + 0.2f;
@@ -144,14 +146,25 @@ OpenGLRealOcean::OpenGLRealOcean(GLfloat size, GLfloat state, SDL_mutex* hydrody
     oceanShaders["mask"]->AddUniform("u_gpu_tess_factor", ParameterType::FLOAT);
     oceanShaders["mask"]->BindShaderStorageBlock("QTreeCull", SSBO_QTREE_CULL);
 
-    //FFT data transfer
-    size_t fftDataSize = params.fftSize * params.fftSize * 4 * layers;
-    fftData = new GLfloat[fftDataSize];
-    memset(fftData, 0, sizeof(GLfloat) * fftDataSize);
+    //FFT data transfer (triple buffered, only the first layer is used in the hydrodynamics)
+    size_t fftDataSize = params.fftSize * params.fftSize * 4;
+    for(unsigned int i=0; i<3; ++i)
+    {
+        waveSnapshots[i].data = new GLfloat[fftDataSize];
+        memset(waveSnapshots[i].data, 0, sizeof(GLfloat) * fftDataSize);
+        waveSnapshots[i].t = 0.f;
+        waveSnapshots[i].timestamp = -1;
+    }
+    waveRead = 0;
+    waveWrite = 1;
+    waveReady = 2;
+    waveDataAge = -1.f;
+    pboTime = 0.f;
+    pboTimestamp = -1;
     
     glGenBuffers(1, &fftPBO);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, fftPBO);
-    glBufferData(GL_PIXEL_PACK_BUFFER, params.fftSize * params.fftSize * 4 * layers * sizeof(GLfloat), fftData, GL_STREAM_READ);
+    glBufferData(GL_PIXEL_PACK_BUFFER, fftDataSize * layers * sizeof(GLfloat), NULL, GL_STREAM_READ);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
     //Quad tree buffers
@@ -226,7 +239,8 @@ OpenGLRealOcean::~OpenGLRealOcean()
     delete oceanShaders["surface"];
     delete oceanShaders["backsurface"];
     delete oceanShaders["mask"];
-    delete fftData;
+    for(unsigned int i=0; i<3; ++i)
+        delete [] waveSnapshots[i].data;
 }
 
 void OpenGLRealOcean::setWireframe(bool enabled)
@@ -268,11 +282,12 @@ GLfloat OpenGLRealOcean::ComputeInterpolatedWaveData(GLfloat x, GLfloat y, GLuin
     float beta = modff(j0f * (float)params.fftSize, &tmp);
     
     //Get texel values
+    const GLfloat* data = waveSnapshots[waveRead].data;
     float t[4];
-    t[0] = fftData[(j0 * params.fftSize + i0) * 4 + channel];
-    t[1] = fftData[(j0 * params.fftSize + i1) * 4 + channel];
-    t[2] = fftData[(j1 * params.fftSize + i0) * 4 + channel];
-    t[3] = fftData[(j1 * params.fftSize + i1) * 4 + channel];
+    t[0] = data[(j0 * params.fftSize + i0) * 4 + channel];
+    t[1] = data[(j0 * params.fftSize + i1) * 4 + channel];
+    t[2] = data[(j1 * params.fftSize + i0) * 4 + channel];
+    t[3] = data[(j1 * params.fftSize + i1) * 4 + channel];
     
     //Interpolate
     float h = (1.f - alpha)*(1.f - beta)*t[0] + alpha*(1.f - beta)*t[1] + (1.f - alpha)*beta*t[2] + alpha*beta*t[3];
@@ -294,20 +309,26 @@ GLfloat OpenGLRealOcean::ComputeWaveHeight(GLfloat x, GLfloat y)
 
 void OpenGLRealOcean::Simulate(GLfloat dt)
 {
-    if(SDL_TryLockMutex(hydroMutex) == 0)
+    //Publish the wave data read back in the previous frame (the hydrodynamics never waits for the rendering)
+    if(pboTimestamp >= 0)
     {
         glBindBuffer(GL_PIXEL_PACK_BUFFER, fftPBO);
         GLfloat* src = (GLfloat*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
         if(src)
         {
-            memcpy(fftData, src, params.fftSize * params.fftSize * 4 * 4 * sizeof(GLfloat));
+            WaveSnapshot& snapshot = waveSnapshots[waveWrite];
+            memcpy(snapshot.data, src, params.fftSize * params.fftSize * 4 * sizeof(GLfloat));
             glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            snapshot.t = pboTime;
+            snapshot.timestamp = pboTimestamp;
+            waveWrite = waveReady.exchange(waveWrite | WAVE_SNAPSHOT_NEW) & WAVE_SNAPSHOT_INDEX;
         }
         glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        SDL_UnlockMutex(hydroMutex);
     }
 
+    pboTime = params.t;
     OpenGLOcean::Simulate(dt);
+    pboTimestamp = GetTimeInMicroseconds();
 
     //Copy wave data to RAM for hydrodynamic computations
     OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D_ARRAY, oceanTextures[3]);
@@ -317,6 +338,20 @@ void OpenGLRealOcean::Simulate(GLfloat dt)
     OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
 }
 
+void OpenGLRealOcean::AcquireWaveData()
+{
+    if(waveReady.load() & WAVE_SNAPSHOT_NEW)
+        waveRead = waveReady.exchange(waveRead) & WAVE_SNAPSHOT_INDEX;
+    
+    int64_t timestamp = waveSnapshots[waveRead].timestamp;
+    waveDataAge = timestamp < 0 ? -1.f : (GLfloat)(GetTimeInMicroseconds() - timestamp)/1e6f;
+}
+
+GLfloat OpenGLRealOcean::getWaveDataAge()
+{
+    return waveDataAge;
+}
+
 void OpenGLRealOcean::UpdateSurface(OpenGLCamera* cam)
 {
     //Check if quad tree was created for this camera
@@ -26,6 +26,7 @@
 #include "joints/CylindricalJoint.h"
 
 #include "entities/SolidEntity.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -177,4 +178,16 @@ std::vector<Renderable> CylindricalJoint::Render()
     return items;
 }
 
+Joint* CylindricalJoint::Clone(CloneContext& ctx)
+{
+    CylindricalJoint* copy = new CylindricalJoint(*this);
+    if(!copy->InitCopy(ctx))
+    {
+        delete copy;
+        return NULL;
+    }
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
@@ -29,6 +29,7 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "entities/SolidEntity.h"
+#include "core/CloneContext.h"
 #include "entities/FeatherstoneEntity.h"
 
 namespace sf
@@ -100,4 +101,16 @@ std::vector<Renderable> FixedJoint::Render()
     return items;
 }
 
+Joint* FixedJoint::Clone(CloneContext& ctx)
+{
+    FixedJoint* copy = new FixedJoint(*this);
+    if(!copy->InitCopy(ctx))
+    {
+        delete copy;
+        return NULL;
+    }
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
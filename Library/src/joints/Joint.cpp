@@ -27,6 +27,8 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/CloneContext.h"
+#include "core/Console.h"
 #include "entities/SolidEntity.h"
 
 namespace sf
@@ -119,6 +121,83 @@ void Joint::AddToSimulation(SimulationManager* sm)
     }
 }
     
+Joint* Joint::Clone(CloneContext& ctx)
+{
+    cError("Joint '%s' cannot be cloned!", name.c_str());
+    return NULL;
+}
+
+bool Joint::InitCopy(CloneContext& ctx)
+{
+    if(constraint == NULL)
+    {
+        cError("Joint '%s' cannot be cloned (multibody joints are not supported)!", name.c_str());
+        return false;
+    }
+    
+    //Find the copies of the joined bodies (the fixed body is shared)
+    btRigidBody* bodies[2] = {&constraint->getRigidBodyA(), &constraint->getRigidBodyB()};
+    for(unsigned int i=0; i<2; ++i)
+    {
+        if(bodies[i] == &btTypedConstraint::getFixedBody())
+            continue;
+        SolidEntity* solid = ctx.getCopy((SolidEntity*)bodies[i]->getUserPointer());
+        bodies[i] = solid != NULL ? solid->rigidBody : NULL;
+        if(bodies[i] == NULL)
+        {
+            cError("Joint '%s' cannot be cloned (joined body was not copied)!", name.c_str());
+            return false;
+        }
+    }
+    btRigidBody& bodyA = *bodies[0];
+    btRigidBody& bodyB = *bodies[1];
+    
+    //Rebuild the constraint using the frames of the original
+    switch(constraint->getConstraintType())
+    {
+        case HINGE_CONSTRAINT_TYPE:
+        {
+            btHingeConstraint* src = (btHingeConstraint*)constraint;
+            btHingeConstraint* hinge = new btHingeConstraint(bodyA, bodyB, src->getAFrame(), src->getBFrame());
+            hinge->setLimit(src->getLowerLimit(), src->getUpperLimit(), src->getLimitSoftness(), src->getLimitBiasFactor(), src->getLimitRelaxationFactor());
+            hinge->enableAngularMotor(src->getEnableAngularMotor(), src->getMotorTargetVelocity(), src->getMaxMotorImpulse());
+            constraint = hinge;
+        }
+            break;
+            
+        case SLIDER_CONSTRAINT_TYPE:
+        {
+            btSliderConstraint* src = (btSliderConstraint*)constraint;
+            btSliderConstraint* slider = new btSliderConstraint(bodyA, bodyB, src->getFrameOffsetA(), src->getFrameOffsetB(), src->getUseLinearReferenceFrameA());
+            slider->setLowerLinLimit(src->getLowerLinLimit());
+            slider->setUpperLinLimit(src->getUpperLinLimit());
+            slider->setLowerAngLimit(src->getLowerAngLimit());
+            slider->setUpperAngLimit(src->getUpperAngLimit());
+            constraint = slider;
+        }
+            break;
+            
+        case POINT2POINT_CONSTRAINT_TYPE:
+        {
+            btPoint2PointConstraint* src = (btPoint2PointConstraint*)constraint;
+            constraint = new btPoint2PointConstraint(bodyA, bodyB, src->getPivotInA(), src->getPivotInB());
+        }
+            break;
+            
+        case FIXED_CONSTRAINT_TYPE:
+        {
+            btFixedConstraint* src = (btFixedConstraint*)constraint;
+            constraint = new btFixedConstraint(bodyA, bodyB, src->getFrameOffsetA(), src->getFrameOffsetB());
+        }
+            break;
+            
+        default:
+            cError("Joint '%s' cannot be cloned (unsupported constraint type)!", name.c_str());
+            return false;
+    }
+    return true;
+}
+
 void Joint::ApplyDamping()
 {
     //Not applicable.
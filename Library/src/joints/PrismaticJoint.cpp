@@ -26,6 +26,7 @@
 #include "joints/PrismaticJoint.h"
 
 #include "entities/SolidEntity.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -147,4 +148,16 @@ std::vector<Renderable> PrismaticJoint::Render()
     return items;
 }
 
+Joint* PrismaticJoint::Clone(CloneContext& ctx)
+{
+    PrismaticJoint* copy = new PrismaticJoint(*this);
+    if(!copy->InitCopy(ctx))
+    {
+        delete copy;
+        return NULL;
+    }
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
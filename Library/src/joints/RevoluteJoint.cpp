@@ -26,6 +26,7 @@
 #include "joints/RevoluteJoint.h"
 
 #include "entities/SolidEntity.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -182,4 +183,16 @@ std::vector<Renderable> RevoluteJoint::Render()
     return items;
 }
     
+Joint* RevoluteJoint::Clone(CloneContext& ctx)
+{
+    RevoluteJoint* copy = new RevoluteJoint(*this);
+    if(!copy->InitCopy(ctx))
+    {
+        delete copy;
+        return NULL;
+    }
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
@@ -26,6 +26,7 @@
 #include "joints/SphericalJoint.h"
 
 #include "entities/SolidEntity.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -116,4 +117,16 @@ std::vector<Renderable> SphericalJoint::Render()
     return items;
 }
 
+Joint* SphericalJoint::Clone(CloneContext& ctx)
+{
+    SphericalJoint* copy = new SphericalJoint(*this);
+    if(!copy->InitCopy(ctx))
+    {
+        delete copy;
+        return NULL;
+    }
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
@@ -30,6 +30,7 @@
 #include "graphics/OpenGLPipeline.h"
 #include "entities/SolidEntity.h"
 #include "utils/ScientificFileUtil.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -262,4 +263,13 @@ std::vector<Renderable> Contact::Render()
     return items;
 }
 
+Contact* Contact::Clone(CloneContext& ctx)
+{
+    Contact* copy = new Contact(*this);
+    ctx.Remap(copy->A);
+    ctx.Remap(copy->B);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
@@ -28,6 +28,7 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "core/Console.h"
+#include "core/StateBuffer.h"
 #include "utils/ScientificFileUtil.h"
 #include "sensors/Sample.h"
 
@@ -108,6 +109,31 @@ void ScalarSensor::Reset()
     Sensor::Reset();
 }
 
+void ScalarSensor::SaveState(StateBuffer& state)
+{
+    SDL_LockMutex(updateMutex);
+    Sensor::SaveState(state);
+    for(size_t i = 0; i < channels.size(); ++i)
+        state.Write(channels[i].noise);
+    SDL_UnlockMutex(updateMutex);
+}
+
+void ScalarSensor::RestoreState(StateBuffer& state)
+{
+    SDL_LockMutex(updateMutex);
+    Sensor::RestoreState(state);
+    for(size_t i = 0; i < channels.size(); ++i)
+        state.Read(channels[i].noise);
+    
+    Scalar t = SimulationApp::getApp()->getSimulationManager()->getSimulationTime();
+    while(history.size() > 0 && history.back()->getTimestamp() > t)
+    {
+        delete history.back();
+        history.pop_back();
+    }
+    SDL_UnlockMutex(updateMutex);
+}
+
 void ScalarSensor::AddSampleToHistory(const Sample& s)
 {
     if(historyLen < 0 && history.size() > 0) //No history
@@ -298,4 +324,11 @@ void ScalarSensor::SaveMeasurementsToOctaveFile(const std::string& path, bool in
     SaveOctaveData(path, data);
 }
 
+void ScalarSensor::InitCopy(CloneContext& ctx)
+{
+    Sensor::InitCopy(ctx);
+    for(size_t i = 0; i < history.size(); ++i)
+        history[i] = new Sample(*history[i]);
+}
+
 }
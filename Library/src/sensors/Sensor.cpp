@@ -28,28 +28,28 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "core/Console.h"
+#include "core/StateBuffer.h"
+#include "core/CloneContext.h"
 #include "graphics/OpenGLPipeline.h"
 
 namespace sf
 {
 
-std::random_device Sensor::randomDevice;
-std::mt19937 Sensor::randomGenerator(randomDevice());
-
 Sensor::Sensor(std::string uniqueName, Scalar frequency)
 {
-    name = SimulationApp::getApp()->getSimulationManager()->getNameManager()->AddName(uniqueName);
+    sm = SimulationApp::getApp()->getSimulationManager();
+    name = sm->getNameManager()->AddName(uniqueName);
     setUpdateFrequency(frequency);
     eleapsedTime = Scalar(0);
     renderable = false;
     newDataAvailable = false;
     updateMutex = SDL_CreateMutex();
+    randomGenerator.seed(sm->DeriveRandomSeed(name));
 }
 
 Sensor::~Sensor()
 {
-    if(SimulationApp::getApp() != NULL)
-        SimulationApp::getApp()->getSimulationManager()->getNameManager()->RemoveName(name);
+    sm->getNameManager()->RemoveName(name);
     SDL_DestroyMutex(updateMutex);
 }
 
@@ -66,6 +66,7 @@ void Sensor::MarkDataOld()
 void Sensor::setUpdateFrequency(Scalar f)
 {
     freq = f;
+    sm->RescheduleSensors();
 }
 
 Scalar Sensor::getUpdateFrequency()
@@ -73,6 +74,13 @@ Scalar Sensor::getUpdateFrequency()
     return freq;
 }
 
+void Sensor::setRandomSeed(unsigned int seed)
+{
+    SDL_LockMutex(updateMutex);
+    randomGenerator.seed(seed);
+    SDL_UnlockMutex(updateMutex);
+}
+
 bool Sensor::isNewDataAvailable()
 {
     return newDataAvailable;
@@ -119,10 +127,46 @@ void Sensor::Update(Scalar dt)
     SDL_UnlockMutex(updateMutex);
 }
 
+void Sensor::TriggerUpdate(Scalar dt)
+{
+    SDL_LockMutex(updateMutex);
+    InternalUpdate(dt);
+    newDataAvailable = true;
+    SDL_UnlockMutex(updateMutex);
+}
+
+void Sensor::SaveState(StateBuffer& state)
+{
+    SDL_LockMutex(updateMutex);
+    state.Write(newDataAvailable);
+    state.Write(randomGenerator);
+    SDL_UnlockMutex(updateMutex);
+}
+
+void Sensor::RestoreState(StateBuffer& state)
+{
+    SDL_LockMutex(updateMutex);
+    state.Read(newDataAvailable);
+    state.Read(randomGenerator);
+    SDL_UnlockMutex(updateMutex);
+}
+
 std::vector<Renderable> Sensor::Render()
 {
     std::vector<Renderable> items(0);
     return items;
 }
     
+Sensor* Sensor::Clone(CloneContext& ctx)
+{
+    cError("Sensor '%s' cannot be cloned!", name.c_str());
+    return NULL;
+}
+
+void Sensor::InitCopy(CloneContext& ctx)
+{
+    sm = ctx.getSimulationManager();
+    updateMutex = SDL_CreateMutex();
+}
+
 }
@@ -27,6 +27,7 @@
 
 #include "entities/SolidEntity.h"
 #include "sensors/Sample.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -90,4 +91,12 @@ ScalarSensorType Accelerometer::getScalarSensorType()
     return ScalarSensorType::ACC;
 }
     
+Sensor* Accelerometer::Clone(CloneContext& ctx)
+{
+    Accelerometer* copy = new Accelerometer(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
@@ -26,6 +26,7 @@
 #include "sensors/scalar/Compass.h"
 
 #include "sensors/Sample.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -56,4 +57,12 @@ ScalarSensorType Compass::getScalarSensorType()
     return ScalarSensorType::COMPASS;
 }
 
+Sensor* Compass::Clone(CloneContext& ctx)
+{
+    Compass* copy = new Compass(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
@@ -27,6 +27,7 @@
 
 #include "actuators/DCMotor.h"
 #include "sensors/Sample.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -65,4 +66,18 @@ ScalarSensorType Current::getScalarSensorType()
     return ScalarSensorType::CURRENT;
 }
 
+Sensor* Current::Clone(CloneContext& ctx)
+{
+    Current* copy = new Current(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
+void Current::InitCopy(CloneContext& ctx)
+{
+    ScalarSensor::InitCopy(ctx);
+    ctx.Remap(motor);
+}
+
 }
@@ -31,6 +31,7 @@
 #include "entities/SolidEntity.h"
 #include "sensors/Sample.h"
 #include "graphics/OpenGLPipeline.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -68,7 +69,7 @@ void DVL::InternalUpdate(Scalar dt)
         to[i] = dvlTrans.getOrigin() - dir[i] * channels[3].rangeMax;
         
         btCollisionWorld::ClosestRayResultCallback closest(from[i], to[i]);
-        SimulationApp::getApp()->getSimulationManager()->getDynamicsWorld()->rayTest(from[i], to[i], closest);
+        SimulationApp::getApp()->getSimulationManager()->RayTest(from[i], to[i], closest);
         
         if(closest.hasHit())
         {
@@ -165,4 +166,12 @@ ScalarSensorType DVL::getScalarSensorType()
     return ScalarSensorType::DVL;
 }
 
+Sensor* DVL::Clone(CloneContext& ctx)
+{
+    DVL* copy = new DVL(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
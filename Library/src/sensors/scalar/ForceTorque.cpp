@@ -28,7 +28,9 @@
 #include "entities/SolidEntity.h"
 #include "entities/FeatherstoneEntity.h"
 #include "sensors/Sample.h"
+#include "core/StateBuffer.h"
 #include "joints/Joint.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -139,4 +141,30 @@ ScalarSensorType ForceTorque::getScalarSensorType()
     return ScalarSensorType::FT;
 }
 
+void ForceTorque::SaveState(StateBuffer& state)
+{
+    ScalarSensor::SaveState(state);
+    state.Write(lastFrame);
+}
+
+void ForceTorque::RestoreState(StateBuffer& state)
+{
+    ScalarSensor::RestoreState(state);
+    state.Read(lastFrame);
+}
+
+Sensor* ForceTorque::Clone(CloneContext& ctx)
+{
+    ForceTorque* copy = new ForceTorque(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
+void ForceTorque::InitCopy(CloneContext& ctx)
+{
+    JointSensor::InitCopy(ctx);
+    ctx.Remap(attach);
+}
+
 }
@@ -30,6 +30,8 @@
 #include "core/NED.h"
 #include "entities/forcefields/Ocean.h"
 #include "sensors/Sample.h"
+#include "core/StateBuffer.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -97,4 +99,24 @@ ScalarSensorType GPS::getScalarSensorType()
     return ScalarSensorType::GPS;
 }
 
+void GPS::SaveState(StateBuffer& state)
+{
+    ScalarSensor::SaveState(state);
+    state.Write(noise);
+}
+
+void GPS::RestoreState(StateBuffer& state)
+{
+    ScalarSensor::RestoreState(state);
+    state.Read(noise);
+}
+
+Sensor* GPS::Clone(CloneContext& ctx)
+{
+    GPS* copy = new GPS(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
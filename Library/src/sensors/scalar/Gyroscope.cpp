@@ -28,6 +28,8 @@
 #include "entities/SolidEntity.h"
 #include "sensors/scalar/ADC.h"
 #include "sensors/Sample.h"
+#include "core/StateBuffer.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -81,4 +83,24 @@ ScalarSensorType Gyroscope::getScalarSensorType()
     return ScalarSensorType::GYRO;
 }
 
+void Gyroscope::SaveState(StateBuffer& state)
+{
+    ScalarSensor::SaveState(state);
+    state.Write(accumulatedDrift);
+}
+
+void Gyroscope::RestoreState(StateBuffer& state)
+{
+    ScalarSensor::RestoreState(state);
+    state.Read(accumulatedDrift);
+}
+
+Sensor* Gyroscope::Clone(CloneContext& ctx)
+{
+    Gyroscope* copy = new Gyroscope(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
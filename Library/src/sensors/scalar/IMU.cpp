@@ -27,6 +27,7 @@
 
 #include "entities/SolidEntity.h"
 #include "sensors/Sample.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -85,4 +86,12 @@ ScalarSensorType IMU::getScalarSensorType()
 }
 
 
+Sensor* IMU::Clone(CloneContext& ctx)
+{
+    IMU* copy = new IMU(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
@@ -27,6 +27,7 @@
 
 #include "entities/FeatherstoneEntity.h"
 #include "joints/Joint.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -73,4 +74,11 @@ void JointSensor::AttachToJoint(Joint* joint)
         j = joint;
 }
 
+void JointSensor::InitCopy(CloneContext& ctx)
+{
+    ScalarSensor::InitCopy(ctx);
+    ctx.Remap(fe);
+    ctx.Remap(j);
+}
+
 }
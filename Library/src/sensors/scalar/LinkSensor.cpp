@@ -27,6 +27,7 @@
 
 #include "entities/SolidEntity.h"
 #include "entities/FeatherstoneEntity.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -83,4 +84,10 @@ std::vector<Renderable> LinkSensor::Render()
     return items;
 }
 
+void LinkSensor::InitCopy(CloneContext& ctx)
+{
+    ScalarSensor::InitCopy(ctx);
+    ctx.Remap(attach);
+}
+
 }
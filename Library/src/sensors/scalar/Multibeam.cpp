@@ -31,6 +31,7 @@
 #include "utils/UnitSystem.h"
 #include "sensors/Sample.h"
 #include "graphics/OpenGLPipeline.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -65,7 +66,7 @@ void Multibeam::InternalUpdate(Scalar dt)
         Vector3 to = mbTrans.getOrigin() + dir * channels[1].rangeMax;
     
         btCollisionWorld::ClosestRayResultCallback closest(from, to);
-        SimulationApp::getApp()->getSimulationManager()->getDynamicsWorld()->rayTest(from, to, closest);
+        SimulationApp::getApp()->getSimulationManager()->RayTest(from, to, closest);
         
         if(closest.hasHit())
         {
@@ -125,4 +126,12 @@ Scalar Multibeam::getAngleRange()
     return angRange;
 }
 
+Sensor* Multibeam::Clone(CloneContext& ctx)
+{
+    Multibeam* copy = new Multibeam(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
@@ -27,6 +27,7 @@
 
 #include "entities/SolidEntity.h"
 #include "sensors/Sample.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -78,4 +79,12 @@ ScalarSensorType Odometry::getScalarSensorType()
 }
 
 
+Sensor* Odometry::Clone(CloneContext& ctx)
+{
+    Odometry* copy = new Odometry(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
@@ -28,6 +28,7 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "sensors/Sample.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -66,4 +67,12 @@ ScalarSensorType Pressure::getScalarSensorType()
     return ScalarSensorType::PRESSURE;
 }
 
+Sensor* Pressure::Clone(CloneContext& ctx)
+{
+    Pressure* copy = new Pressure(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
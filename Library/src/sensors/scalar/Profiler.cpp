@@ -30,7 +30,9 @@
 #include "core/SimulationManager.h"
 #include "utils/UnitSystem.h"
 #include "sensors/Sample.h"
+#include "core/StateBuffer.h"
 #include "graphics/OpenGLContent.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -59,7 +61,7 @@ void Profiler::InternalUpdate(Scalar dt)
     Vector3 to = profTrans.getOrigin() + dir * channels[1].rangeMax;
     
     btCollisionWorld::ClosestRayResultCallback closest(from, to);
-    SimulationApp::getApp()->getSimulationManager()->getDynamicsWorld()->rayTest(from, to, closest);
+    SimulationApp::getApp()->getSimulationManager()->RayTest(from, to, closest);
         
     if(closest.hasHit())
     {
@@ -130,4 +132,30 @@ ScalarSensorType Profiler::getScalarSensorType()
     return ScalarSensorType::PROFILER;
 }
 
+void Profiler::SaveState(StateBuffer& state)
+{
+    ScalarSensor::SaveState(state);
+    state.Write(distance);
+    state.Write(clockwise);
+    state.Write((uint32_t)currentAngStep);
+}
+
+void Profiler::RestoreState(StateBuffer& state)
+{
+    ScalarSensor::RestoreState(state);
+    state.Read(distance);
+    state.Read(clockwise);
+    uint32_t step;
+    state.Read(step);
+    currentAngStep = step;
+}
+
+Sensor* Profiler::Clone(CloneContext& ctx)
+{
+    Profiler* copy = new Profiler(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
@@ -27,6 +27,7 @@
 
 #include "utils/UnitSystem.h"
 #include "sensors/Sample.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -101,4 +102,12 @@ ScalarSensorType RealRotaryEncoder::getScalarSensorType()
     return ScalarSensorType::ENCODER;
 }
 
+Sensor* RealRotaryEncoder::Clone(CloneContext& ctx)
+{
+    RealRotaryEncoder* copy = new RealRotaryEncoder(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
@@ -26,11 +26,13 @@
 #include "sensors/scalar/RotaryEncoder.h"
 
 #include "sensors/Sample.h"
+#include "core/StateBuffer.h"
 #include "joints/RevoluteJoint.h"
 #include "utils/UnitSystem.h"
 #include "entities/FeatherstoneEntity.h"
 #include "actuators/Motor.h"
 #include "actuators/Thruster.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -156,4 +158,33 @@ ScalarSensorType RotaryEncoder::getScalarSensorType()
     return ScalarSensorType::ENCODER;
 }
 
+void RotaryEncoder::SaveState(StateBuffer& state)
+{
+    ScalarSensor::SaveState(state);
+    state.Write(angle);
+    state.Write(lastAngle);
+}
+
+void RotaryEncoder::RestoreState(StateBuffer& state)
+{
+    ScalarSensor::RestoreState(state);
+    state.Read(angle);
+    state.Read(lastAngle);
+}
+
+Sensor* RotaryEncoder::Clone(CloneContext& ctx)
+{
+    RotaryEncoder* copy = new RotaryEncoder(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
+void RotaryEncoder::InitCopy(CloneContext& ctx)
+{
+    JointSensor::InitCopy(ctx);
+    ctx.Remap(motor);
+    ctx.Remap(thrust);
+}
+
 }
@@ -28,6 +28,7 @@
 #include "entities/FeatherstoneEntity.h"
 #include "joints/Joint.h"
 #include "sensors/Sample.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -69,4 +70,12 @@ ScalarSensorType Torque::getScalarSensorType()
     return ScalarSensorType::TORQUE;
 }
 
+Sensor* Torque::Clone(CloneContext& ctx)
+{
+    Torque* copy = new Torque(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
@@ -27,6 +27,7 @@
 
 #include "sensors/Sample.h"
 #include "graphics/OpenGLPipeline.h"
+#include "core/CloneContext.h"
 
 namespace sf
 {
@@ -59,4 +60,12 @@ ScalarSensorType Trajectory::getScalarSensorType()
     return ScalarSensorType::TRAJECTORY;
 }
 
+Sensor* Trajectory::Clone(CloneContext& ctx)
+{
+    Trajectory* copy = new Trajectory(*this);
+    copy->InitCopy(ctx);
+    ctx.AddCopy(this, copy);
+    return copy;
+}
+
 }
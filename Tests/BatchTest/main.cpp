@@ -0,0 +1,113 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  main.cpp
+//  BatchTest
+//
+//  Created by agent on 17/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#include <thread>
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+#include <core/BatchRunner.h>
+
+std::string ReadFile(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+//Checks that the overrides modify the description and that runs are reproducible
+bool CheckBatch(const std::string& dataPath, const std::string& outputPath, unsigned int numThreads)
+{
+    sf::ScenarioOverride o;
+    if(!sf::BatchRunner::ParseOverride("robot[name=Robot1]/world_transform@xyz=5.0 0.0 2.0", o))
+    {
+        printf("Check failed: override not parsed!\n");
+        return false;
+    }
+    
+    tinyxml2::XMLDocument doc;
+    if(doc.LoadFile((dataPath + "batch.scn").c_str()) != tinyxml2::XML_SUCCESS || !sf::BatchRunner::ApplyOverride(&doc, o))
+    {
+        printf("Check failed: override not applied!\n");
+        return false;
+    }
+    tinyxml2::XMLElement* robot = doc.FirstChildElement("scenario")->FirstChildElement("robot");
+    while(robot != nullptr && robot->Attribute("name", "Robot1") == nullptr)
+        robot = robot->NextSiblingElement("robot");
+    tinyxml2::XMLElement* transform = robot == nullptr ? nullptr : robot->FirstChildElement("world_transform");
+    const char* xyz = transform == nullptr ? nullptr : transform->Attribute("xyz");
+    if(xyz == nullptr || std::string(xyz) != o.value)
+    {
+        printf("Check failed: override did not change the description!\n");
+        return false;
+    }
+    
+    //Two identical runs and one run with a different override
+    sf::ScenarioOverride o2 = o;
+    o2.value = "5.0 0.0 3.0";
+    sf::BatchRunner runner(dataPath, 500.0);
+    if(!runner.LoadScenario(dataPath + "batch.scn"))
+        return false;
+    runner.AddRun(std::vector<sf::ScenarioOverride>(1, o));
+    runner.AddRun(std::vector<sf::ScenarioOverride>(1, o));
+    runner.AddRun(std::vector<sf::ScenarioOverride>(1, o2));
+    std::vector<sf::BatchRunResult> results = runner.Run(2.0, numThreads, outputPath);
+    if(results.size() != 3 || !results[0].success || !results[1].success || !results[2].success)
+    {
+        printf("Check failed: runs not completed!\n");
+        return false;
+    }
+    
+    std::string out0 = ReadFile(results[0].outputPath);
+    std::string out1 = ReadFile(results[1].outputPath);
+    std::string out2 = ReadFile(results[2].outputPath);
+    //Run ids are part of the header
+    if(out0.size() < 16 || out0.size() != out1.size() || out0.compare(16, std::string::npos, out1, 16, std::string::npos) != 0)
+    {
+        printf("Check failed: identical runs produced different output!\n");
+        return false;
+    }
+    if(out0.size() == out2.size() && out0.compare(16, std::string::npos, out2, 16, std::string::npos) == 0)
+    {
+        printf("Check failed: override did not change the output!\n");
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, const char * argv[])
+{
+    std::string dataPath(DATA_DIR_PATH);
+    std::string outputPath = argc > 1 ? std::string(argv[1]) : std::string(".");
+    unsigned int numThreads = argc > 2 ? (unsigned int)atoi(argv[2]) : std::thread::hardware_concurrency();
+    
+    if(!CheckBatch(dataPath, outputPath, numThreads))
+        return 1;
+    
+    sf::BatchRunner runner(dataPath, 500.0);
+    if(!runner.LoadScenario(dataPath + "batch.scn") || !runner.LoadRuns(dataPath + "batch_runs.txt"))
+        return 1;
+    runner.Run(10.0, numThreads, outputPath);
+    
+    return 0;
+}
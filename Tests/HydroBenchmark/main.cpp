@@ -0,0 +1,96 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  main.cpp
+//  HydroBenchmark
+//
+//  Created by agent on 17/10/2026.
+//  Copyright(c) 2026 agent. All rights reserved.
+//
+
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <entities/HydroMesh.h>
+#include <graphics/OpenGLContent.h>
+
+//Compares the scalar and vectorised clipping of a sphere against a wavy fluid surface
+int main(int argc, const char * argv[])
+{
+    unsigned int subdivisions = argc > 1 ? (unsigned int)atoi(argv[1]) : 5;
+    unsigned int poses = argc > 2 ? (unsigned int)atoi(argv[2]) : 100;
+    
+    sf::Mesh* sphere = sf::OpenGLContent::BuildSphere(1.f, subdivisions);
+    sf::HydroMesh mesh(sphere);
+    delete sphere;
+    size_t nf = mesh.getNumOfFaces();
+    
+    std::vector<sf::Scalar> area(nf), cx(nf), cy(nf), cz(nf), nx(nf), ny(nf), nz(nf);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<sf::Scalar> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<sf::Scalar> offset(-0.9, 0.9);
+    double tScalar = 0.0;
+    double tVectorised = 0.0;
+    sf::Scalar maxError = 0.0;
+    size_t mismatches = 0;
+    
+    for(unsigned int i=0; i<poses; ++i)
+    {
+        sf::Transform T(sf::Quaternion(angle(rng), angle(rng), angle(rng)), sf::Vector3(0, 0, offset(rng)));
+        mesh.TransformVertices(T);
+        for(size_t v=0; v<mesh.getNumOfVertices(); ++v)
+            mesh.depth[v] = mesh.pz[v] + sf::Scalar(0.05) * btSin(3 * mesh.px[v]) * btCos(2 * mesh.py[v]);
+        
+        auto t0 = std::chrono::steady_clock::now();
+        mesh.ClipFacesScalar();
+        auto t1 = std::chrono::steady_clock::now();
+        area = mesh.area;
+        cx = mesh.cx; cy = mesh.cy; cz = mesh.cz;
+        nx = mesh.nx; ny = mesh.ny; nz = mesh.nz;
+        
+        auto t2 = std::chrono::steady_clock::now();
+        mesh.ClipFacesVectorised();
+        auto t3 = std::chrono::steady_clock::now();
+        tScalar += std::chrono::duration<double>(t1 - t0).count();
+        tVectorised += std::chrono::duration<double>(t3 - t2).count();
+        
+        for(size_t f=0; f<nf; ++f)
+        {
+            if(area[f] != mesh.area[f])
+                ++mismatches;
+            if(area[f] == sf::Scalar(0) || mesh.area[f] == sf::Scalar(0))
+                continue;
+            sf::Scalar e = btFabs(area[f] - mesh.area[f]);
+            e = btMax(e, btFabs(cx[f] - mesh.cx[f]));
+            e = btMax(e, btFabs(cy[f] - mesh.cy[f]));
+            e = btMax(e, btFabs(cz[f] - mesh.cz[f]));
+            e = btMax(e, btFabs(nx[f] - mesh.nx[f]));
+            e = btMax(e, btFabs(ny[f] - mesh.ny[f]));
+            e = btMax(e, btFabs(nz[f] - mesh.nz[f]));
+            maxError = btMax(maxError, e);
+        }
+    }
+    
+    double n = (double)nf * poses;
+    printf("Faces: %lu, poses: %u, vectorised: %s\n", (unsigned long)nf, poses, sf::HydroMesh::isVectorised() ? "yes (AVX2)" : "no (scalar fallback)");
+    printf("Scalar:     %.2f ns/face\n", tScalar/n * 1e9);
+    printf("Vectorised: %.2f ns/face (speedup %.2fx)\n", tVectorised/n * 1e9, tScalar/tVectorised);
+    printf("Maximum difference: %g, faces with different classification: %lu\n", (double)maxError, (unsigned long)mismatches);
+    
+    return mismatches == 0 ? 0 : 1;
+}